@@ -2217,6 +2217,8 @@ JNIEXPORT jlong JNICALL Java_com_drbeef_rtcwquest_GLES3JNILib_onCreate( JNIEnv *
         }
 	}
 
+	//Keep the fixed pipeline programs gl4es builds between runs
+	setenv("LIBGL_PSA", "/sdcard/RTCWQuest/gl4es.psa", 0);
 	initialize_gl4es();
 
 	ovrAppThread * appThread = (ovrAppThread *) malloc( sizeof( ovrAppThread ) );
@@ -50,6 +50,7 @@ LOCAL_SRC_FILES := \
 	src/gl/pointsprite.c \
 	src/gl/preproc.c \
 	src/gl/program.c \
+	src/gl/psa.c \
 	src/gl/queries.c \
 	src/gl/raster.c \
 	src/gl/render.c \
@@ -57,6 +58,7 @@ LOCAL_SRC_FILES := \
 	src/gl/shaderconv.c \
 	src/gl/stack.c \
 	src/gl/stencil.c \
+	src/gl/streamvbo.c \
 	src/gl/string_utils.c \
 	src/gl/stubs.c \
 	src/gl/texenv.c \
@@ -80,6 +82,9 @@ LOCAL_CFLAGS += -DNO_GBM
 LOCAL_CFLAGS += -DDEFAULT_ES=2
 LOCAL_CFLAGS += -DNO_INIT_CONSTRUCTOR
 
+# NEON paths of the pixel conversions (armeabi-v7a)
+LOCAL_ARM_NEON := true
+
 
 LOCAL_LDLIBS := -ldl -llog -lEGL -lGLESv3
 
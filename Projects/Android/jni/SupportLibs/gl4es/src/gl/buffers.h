@@ -107,6 +107,7 @@ typedef struct {
     glbuffer_t      *buffer;    // reference buffer
     GLfloat         current[4];
     GLint           divisor;
+    GLboolean       streamed;   // pointer is an offset in the streaming VBO
 } vertexattrib_t;
 
 // VAO ****************
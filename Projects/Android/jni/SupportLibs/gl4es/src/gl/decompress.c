@@ -1,5 +1,14 @@
 #include <stdint.h>
 #include <stddef.h>
+#include <stdlib.h>
+#if !defined(AMIGAOS4) && !defined(__EMSCRIPTEN__)
+#include <pthread.h>
+#include <unistd.h>
+#define DXTC_THREADS
+#endif
+#include "gles.h"
+#include "const.h"
+#include "decompress.h"
 
 /*
 DXT1/DXT3/DXT5 texture decompression
@@ -315,6 +324,120 @@ void DecompressBlockDXT3(uint32_t x, uint32_t y, uint32_t width,
 		image + x + (y * width), width, alphaValues);
 }
 
+// Whole image DXTc decompression, used by glCompressedTexImage2D
+// when the hardware has no S3TC support
+
+typedef struct {
+    const uint8_t *src;     // first block of y0
+    GLvoid *pixels;
+    GLsizei width;
+    GLsizei y0, y1;         // rows to uncompress (multiple of 4)
+    GLenum format;
+    int blocksize;
+} dxtc_job_t;
+
+static void *uncompressDXTc_rows(void *arg) {
+    dxtc_job_t *job = (dxtc_job_t*)arg;
+    uintptr_t src = (uintptr_t) job->src;
+    for (int y=job->y0; y<job->y1; y+=4) {
+        for (int x=0; x<job->width; x+=4) {
+            switch(job->format) {
+                case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+                case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+                    DecompressBlockDXT1(x, y, job->width, (uint8_t*)src, job->pixels);
+                    break;
+                case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+                    DecompressBlockDXT3(x, y, job->width, (uint8_t*)src, job->pixels);
+                    break;
+                case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+                    DecompressBlockDXT5(x, y, job->width, (uint8_t*)src, job->pixels);
+                    break;
+            }
+            src+=job->blocksize;
+        }
+    }
+    return NULL;
+}
+
+#ifdef DXTC_THREADS
+#define DXTC_MAX_THREADS    4
+#define DXTC_MIN_PIXELS     (256*256)   // smaller images are not worth a thread
+int dxtc_forced_threads = 0;
+static int dxtc_threads() {
+    static int n = 0;
+    if(dxtc_forced_threads)
+        return (dxtc_forced_threads>DXTC_MAX_THREADS)?DXTC_MAX_THREADS:dxtc_forced_threads;
+    if(!n) {
+        long cpu = sysconf(_SC_NPROCESSORS_ONLN);
+        n = (cpu<1)?1:((cpu>DXTC_MAX_THREADS)?DXTC_MAX_THREADS:cpu);
+    }
+    return n;
+}
+#endif
+
+GLvoid *uncompressDXTc(GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid *data) {
+    // uncompress a DXTc image
+    // get pixel size of uncompressed image => fixed RGBA
+    int pixelsize = 4;
+/*	if (format==COMPRESSED_RGB_S3TC_DXT1_EXT)
+        pixelsize = 3;*/
+    // check with the size of the input data stream if the stream is in fact uncompressed
+    if (imageSize == width*height*pixelsize || data==NULL) {
+        // uncompressed stream
+        return (GLvoid*)data;
+    }
+    // alloc memory
+    GLvoid *pixels = malloc(((width+3)&~3)*((height+3)&~3)*pixelsize);
+    // uncompress loop
+    int blocksize;
+    switch (format) {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            blocksize = 8;
+            break;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            blocksize = 16;
+            break;
+    }
+    dxtc_job_t job = {(const uint8_t*)data, pixels, width, 0, height, format, blocksize};
+#ifdef DXTC_THREADS
+    // large images are split in bands of block rows, one per core. Blocks are written with a
+    // stride of width, so bands only are independent if width is a multiple of 4
+    int nthreads = dxtc_threads();
+    if(nthreads>1 && !(width&3) && width*height>=DXTC_MIN_PIXELS) {
+        dxtc_job_t jobs[DXTC_MAX_THREADS];
+        pthread_t threads[DXTC_MAX_THREADS];
+        const int band = (((height+3)/4 + nthreads-1)/nthreads)*4;
+        const int blockline = (width/4)*blocksize;
+        int started = 0;
+        for (int i=0; i<nthreads; i++) {
+            jobs[i] = job;
+            jobs[i].y0 = i*band;
+            jobs[i].y1 = (i+1)*band;
+            if(jobs[i].y1>height) jobs[i].y1 = height;
+            jobs[i].src += (jobs[i].y0/4)*blockline;
+        }
+        // the calling thread does the last band, the others are spawned (or done here if spawning fails)
+        for (int i=0; i<nthreads-1; i++)
+            if(jobs[i].y0<jobs[i].y1) {
+                if(pthread_create(&threads[i], NULL, uncompressDXTc_rows, &jobs[i]))
+                    uncompressDXTc_rows(&jobs[i]);
+                else
+                    started |= 1<<i;
+            }
+        if(jobs[nthreads-1].y0<jobs[nthreads-1].y1)
+            uncompressDXTc_rows(&jobs[nthreads-1]);
+        for (int i=0; i<nthreads-1; i++)
+            if(started&(1<<i))
+                pthread_join(threads[i], NULL);
+        return pixels;
+    }
+#endif
+    uncompressDXTc_rows(&job);
+    return pixels;
+}
+
 // Texture DXT1 / DXT5 compression
 // Using STB "on file" library
 // go there https://github.com/nothings/stb
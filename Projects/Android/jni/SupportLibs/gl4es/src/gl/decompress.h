@@ -1,6 +1,9 @@
 #ifndef _GL4ES_DECOMPRESS_H_
 #define _GL4ES_DECOMPRESS_H_
 
+#include <stdint.h>
+#include "gles.h"
+
 void DecompressBlockDXT1(uint32_t x, uint32_t y, uint32_t width,
 	const uint8_t* blockStorage,
 	uint32_t* image);
@@ -12,4 +15,9 @@ void DecompressBlockDXT3(uint32_t x, uint32_t y, uint32_t width,
 void DecompressBlockDXT5(uint32_t x, uint32_t y, uint32_t width,
 	const uint8_t* blockStorage, uint32_t* image);
 
+// uncompress a whole DXT1/3/5 image to RGBA, large images are split between threads
+GLvoid *uncompressDXTc(GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid *data);
+// number of threads used by uncompressDXTc, 0 = one per core
+extern int dxtc_forced_threads;
+
 #endif // _GL4ES_DECOMPRESS_H_
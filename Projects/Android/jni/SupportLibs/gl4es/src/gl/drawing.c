@@ -388,6 +388,24 @@ if(count>500000) return;
 #define MIN_BATCH   (10*globals4es.batch)
 #define MAX_BATCH   (10*10*globals4es.batch)
 
+// MERGE Mode: small indexed triangles are kept in the pending list, so the following compatible draws
+// are appended to it (see islistscompatible_renderlist) and everything is drawn at once on the first state change
+static void merge_draws(GLenum mode, GLsizei count, GLenum type, bool intercept) {
+    if(!globals4es.mergedraw || (glstate->list.active && !glstate->list.pending))
+        return;
+    if(intercept || type!=GL_UNSIGNED_SHORT || rendermode_dimensions(mode)!=3 || count>globals4es.mergedraw) {
+        // cannot be merged, draw what is pending first
+        if(glstate->list.pending)
+            flush();
+        return;
+    }
+    if(!glstate->list.pending) {
+        glstate->list.pending = 1;
+        glstate->list.active = alloc_renderlist();
+    }
+    glstate->list.merged_in++;
+}
+
 void gl4es_glDrawRangeElements(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices) {
     //printf("glDrawRangeElements(%s, %i, %i, %i, %s, @%p), inlist=%i, pending=%d\n", PrintEnum(mode), start, end, count, PrintEnum(type), indices, (glstate->list.active)?1:0, glstate->list.pending);
     count = adjust_vertices(mode, count);
@@ -401,8 +419,10 @@ void gl4es_glDrawRangeElements(GLenum mode, GLuint start, GLuint end, GLsizei co
         return;
     }
 
-    bool compiling = (glstate->list.active);
     bool intercept = should_intercept_render(mode);
+    //MERGE Mode
+    merge_draws(mode, count, type, intercept);
+    bool compiling = (glstate->list.active);
 
     //BATCH Mode
     if(!compiling) {
@@ -504,8 +524,10 @@ void gl4es_glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid
         return;
     }
 
-    bool compiling = (glstate->list.active);
     bool intercept = should_intercept_render(mode);
+    //MERGE Mode
+    merge_draws(mode, count, type, intercept);
+    bool compiling = (glstate->list.active);
 
     //BATCH Mode
     if(!compiling) {
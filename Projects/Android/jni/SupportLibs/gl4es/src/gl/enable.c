@@ -133,7 +133,7 @@ static void proxy_glEnable(GLenum cap, bool enable, void (*next)(GLenum)) {
         proxy_GOFPE(GL_LIGHT7, light[7], fpe_changelight(7, enable));
         proxy_GOFPE(GL_LIGHTING, lighting, glstate->fpe_state->lighting=enable);
         proxy_GOFPE(GL_NORMALIZE, normalize, glstate->fpe_state->normalize=enable);
-        proxy_GOFPE(GL_RESCALE_NORMAL, normal_rescale, glstate->fpe_state->rescaling=enable);
+        proxy_GOFPE(GL_RESCALE_NORMAL, normal_rescale, glstate->fpe_state->rescaling=enable; FPE_DIRTY(FPE_SYNC_MATRIX));
         proxy_GOFPE(GL_COLOR_MATERIAL, color_material, glstate->fpe_state->color_material=enable);
 
         // point sprite
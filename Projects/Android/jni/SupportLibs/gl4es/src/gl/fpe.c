@@ -11,6 +11,7 @@
 #include "matrix.h"
 #include "matvec.h"
 #include "program.h"
+#include "psa.h"
 #include "shaderconv.h"
 
 //#define DEBUG
@@ -21,6 +22,8 @@
 #define DBG(a)
 #endif
 
+unsigned int fpe_stamp = 0;
+
 KHASH_MAP_IMPL_INT(fpecachelist, fpe_cache_t *);
 
 
@@ -244,70 +247,96 @@ uniform_t* findUniform(khash_t(uniformlist) *uniforms, const char* name)
 }
 
 // ********* Shader stuffs handling *********
-void fpe_program(int ispoint) {
-    glstate->fpe_state->point = ispoint;
-    fpe_state_t state;
-    fpe_ReleventState(&state, glstate->fpe_state, 1);
-    if(glstate->fpe==NULL || memcmp(&glstate->fpe->state, &state, sizeof(fpe_state_t))) {
-        // get cached fpe (or new one)
-        glstate->fpe = fpe_GetCache(glstate->fpe_cache, &state, 1);
-    }   
-    if(glstate->fpe->glprogram==NULL) {
+static void fpe_buildProgram(fpe_fpe_t *fpe, fpe_state_t *state) {
+    // state is the full state the shaders are generated from, fpe->state the (relevant) cache key
+    fpe->prog = gl4es_glCreateProgram();
+    if(!fpe_GetProgramPSA(fpe->prog, &fpe->state)) {
         LOAD_GLES2(glGetShaderInfoLog);
         LOAD_GLES2(glGetProgramInfoLog);
         GLint status;
-        glstate->fpe->vert = gl4es_glCreateShader(GL_VERTEX_SHADER);
-        gl4es_glShaderSource(glstate->fpe->vert, 1, fpe_VertexShader(glstate->fpe_state), NULL);
-        gl4es_glCompileShader(glstate->fpe->vert);
-        gl4es_glGetShaderiv(glstate->fpe->vert, GL_COMPILE_STATUS, &status);
+        fpe->vert = gl4es_glCreateShader(GL_VERTEX_SHADER);
+        gl4es_glShaderSource(fpe->vert, 1, fpe_VertexShader(state), NULL);
+        gl4es_glCompileShader(fpe->vert);
+        gl4es_glGetShaderiv(fpe->vert, GL_COMPILE_STATUS, &status);
         if(status!=GL_TRUE) {
             char buff[1000];
-            gles_glGetShaderInfoLog(glstate->fpe->vert, 1000, NULL, buff);
+            gles_glGetShaderInfoLog(fpe->vert, 1000, NULL, buff);
             if(globals4es.logshader)
-                printf("LIBGL: FPE Vertex shader compile failed: source is\n%s\n\nError is: %s\n", fpe_VertexShader(glstate->fpe_state)[0], buff);
+                printf("LIBGL: FPE Vertex shader compile failed: source is\n%s\n\nError is: %s\n", fpe_VertexShader(state)[0], buff);
             else
                 printf("LIBGL: FPE Vertex shader compile failed: %s\n", buff);
         }
-        glstate->fpe->frag = gl4es_glCreateShader(GL_FRAGMENT_SHADER);
-        gl4es_glShaderSource(glstate->fpe->frag, 1, fpe_FragmentShader(glstate->fpe_state), NULL);
-        gl4es_glCompileShader(glstate->fpe->frag);
-        gl4es_glGetShaderiv(glstate->fpe->frag, GL_COMPILE_STATUS, &status);
+        fpe->frag = gl4es_glCreateShader(GL_FRAGMENT_SHADER);
+        gl4es_glShaderSource(fpe->frag, 1, fpe_FragmentShader(state), NULL);
+        gl4es_glCompileShader(fpe->frag);
+        gl4es_glGetShaderiv(fpe->frag, GL_COMPILE_STATUS, &status);
         if(status!=GL_TRUE) {
             char buff[1000];
-            gles_glGetShaderInfoLog(glstate->fpe->frag, 1000, NULL, buff);
+            gles_glGetShaderInfoLog(fpe->frag, 1000, NULL, buff);
             if(globals4es.logshader)
-                printf("LIBGL: FPE Fragment shader compile failed: source is\n%s\n\nError is: %s\n", fpe_FragmentShader(glstate->fpe_state)[0], buff);
+                printf("LIBGL: FPE Fragment shader compile failed: source is\n%s\n\nError is: %s\n", fpe_FragmentShader(state)[0], buff);
             else
                 printf("LIBGL: FPE Fragment shader compile failed: %s\n", buff);
         }
-        glstate->fpe->prog = gl4es_glCreateProgram();
-        gl4es_glAttachShader(glstate->fpe->prog, glstate->fpe->vert);
-        gl4es_glAttachShader(glstate->fpe->prog, glstate->fpe->frag);
-        gl4es_glLinkProgram(glstate->fpe->prog);
-        gl4es_glGetProgramiv(glstate->fpe->prog, GL_LINK_STATUS, &status);
+        gl4es_glAttachShader(fpe->prog, fpe->vert);
+        gl4es_glAttachShader(fpe->prog, fpe->frag);
+        gl4es_glLinkProgram(fpe->prog);
+        gl4es_glGetProgramiv(fpe->prog, GL_LINK_STATUS, &status);
         if(status!=GL_TRUE) {
             char buff[1000];
-            gles_glGetProgramInfoLog(glstate->fpe->prog, 1000, NULL, buff);
+            gles_glGetProgramInfoLog(fpe->prog, 1000, NULL, buff);
             if(globals4es.logshader) {
-                printf("LIBGL: FPE Program link failed: source of vertex shader is\n%s\n\n", fpe_VertexShader(glstate->fpe_state)[0]);
-                printf("source of fragment shader is \n%s\n\nError is: %s\n", fpe_FragmentShader(glstate->fpe_state)[0], buff);
+                printf("LIBGL: FPE Program link failed: source of vertex shader is\n%s\n\n", fpe_VertexShader(state)[0]);
+                printf("source of fragment shader is \n%s\n\nError is: %s\n", fpe_FragmentShader(state)[0], buff);
             } else
                 printf("LIBGL: FPE Program link failed: %s\n", buff);
-        }
-        // now find the program
-        khint_t k_program;
-        {
-            int ret;
-            khash_t(programlist) *programs = glstate->glsl->programs;
-            k_program = kh_get(programlist, programs, glstate->fpe->prog);
-            if (k_program != kh_end(programs))
-                glstate->fpe->glprogram = kh_value(programs, k_program);
-        }
-        // all done
-        DBG(printf("creating FPE shader : %d(%p)\n", glstate->fpe->prog, glstate->fpe->glprogram);)
+        } else
+            fpe_AddProgramPSA(fpe->prog, &fpe->state);
+    }
+    // now find the program
+    khint_t k_program;
+    {
+        int ret;
+        khash_t(programlist) *programs = glstate->glsl->programs;
+        k_program = kh_get(programlist, programs, fpe->prog);
+        if (k_program != kh_end(programs))
+            fpe->glprogram = kh_value(programs, k_program);
+    }
+    // all done
+    DBG(printf("creating FPE shader : %d(%p)\n", fpe->prog, fpe->glprogram);)
+}
+
+void fpe_program(int ispoint) {
+    glstate->fpe_state->point = ispoint;
+    fpe_state_t state;
+    fpe_ReleventState(&state, glstate->fpe_state, 1);
+    if(glstate->fpe==NULL || memcmp(&glstate->fpe->state, &state, sizeof(fpe_state_t))) {
+        // get cached fpe (or new one)
+        glstate->fpe = fpe_GetCache(glstate->fpe_cache, &state, 1);
+    }   
+    if(glstate->fpe->glprogram==NULL)
+        fpe_buildProgram(glstate->fpe, glstate->fpe_state);
+}
+
+void fpe_Warmup() {
+    // create ahead of time all the programs of the archive, so they are not built while drawing
+    int n = fpe_SizePSA();
+    for (int i=0; i<n; i++) {
+        fpe_state_t state;
+        memcpy(&state, fpe_StatePSA(i), sizeof(fpe_state_t));
+        fpe_fpe_t *fpe = fpe_GetCache(glstate->fpe_cache, &state, 1);
+        if(fpe->glprogram==NULL)
+            fpe_buildProgram(fpe, &state);
     }
 }
 
+__attribute__((visibility("default"))) void gl4es_warmup_fpe() {
+    // to be called by the application once the context is current (after loading its data for example)
+    if(hardext.esversion<2 || !glstate || !glstate->fpe_cache)
+        return;
+    fpe_Warmup();
+}
+
 program_t* fpe_CustomShader(program_t* glprogram, fpe_state_t* state)
 {
     // state is not empty and glprogram already has some cache (it may be empty, but kh'thingy is initialized)
@@ -387,7 +416,10 @@ program_t* fpe_CustomShader(program_t* glprogram, fpe_state_t* state)
 }
 
 void fpe_SyncUniforms(uniformcache_t *cache, program_t* glprogram) {
-    //TODO: Optimize this...
+    // nothing changed on the father since last sync?
+    if(glprogram->fpe_father==cache->stamp)
+        return;
+    glprogram->fpe_father = cache->stamp;
     khash_t(uniformlist) *uniforms = glprogram->uniform;
     uniform_t *m;
     khint_t k;
@@ -541,6 +573,8 @@ void fpe_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
     void* scratch = NULL;
     realize_glenv(mode==GL_POINTS, first, count, 0, NULL, &scratch);
     LOAD_GLES(glDrawArrays);
+    if(glstate->streamvbo.base!=-1)
+        first -= glstate->streamvbo.base;
     gles_glDrawArrays(mode, first, count);
     if(scratch) free(scratch);
 }
@@ -550,6 +584,10 @@ void fpe_glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *i
     void* scratch = NULL;
     realize_glenv(mode==GL_POINTS, 0, count, type, indices, &scratch);
     LOAD_GLES(glDrawElements);
+    if(glstate->streamvbo.base!=-1)
+        indices = streamvbo_Indices(count, type, indices);
+    else if(globals4es.streamvbo)
+        streamvbo_BindElements(0);
     gles_glDrawElements(mode, count, type, indices);
     if(scratch) free(scratch);
 }
@@ -576,6 +614,7 @@ void fpe_glMaterialf(GLenum face, GLenum pname, const GLfloat param) {
 
 void fpe_glFogfv(GLenum pname, const GLfloat* params) {
     noerrorShim();
+    FPE_DIRTY(FPE_SYNC_FOG);
     if(pname==GL_FOG_MODE) {
         int p = *params;
         switch(p) {
@@ -603,6 +642,7 @@ void fpe_glPointSize(GLfloat size) {
 
 void fpe_glAlphaFunc(GLenum func, GLclampf ref) {
     noerrorShim();
+    FPE_DIRTY(FPE_SYNC_ALPHAREF);
     int f = FPE_ALWAYS;
     switch(func) {
         case GL_NEVER: f=FPE_NEVER; break;
@@ -635,6 +675,14 @@ int fpe_gettexture(int TMU) {
     return target;
 }
 
+// check if a group of builtin uniforms is outdated on glprogram (it's considered up to date after that)
+static inline int fpe_NeedSync(program_t *glprogram, int group) {
+    if(glprogram->fpe_sync[group]==glstate->fpe_sync[group])
+        return 0;
+    glprogram->fpe_sync[group] = glstate->fpe_sync[group];
+    return 1;
+}
+
 void realize_glenv(int ispoint, int first, int count, GLenum type, const void* indices, void** scratch) {
     // the handling of GL_BGRA size of GL_DOUBLE using 1 scratch in not ideal, and a waste when dealing with Buffers
     // TODO: have the scratch buffer part of the VBO, and tag it dirty when buffer is changed (or always dirty for VBO 0)
@@ -858,62 +906,65 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
     // setup fixed pipeline builtin matrix uniform if needed
     if(glprogram->has_builtin_matrix)
     {
-        if(glprogram->builtin_matrix[MAT_MVP]!=-1 || glprogram->builtin_matrix[MAT_MVP_I]!=-1
-            || glprogram->builtin_matrix[MAT_MVP_T]!=-1 || glprogram->builtin_matrix[MAT_MVP_IT]!=-1)
-        {
-            GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP], 1, GL_FALSE, getMVPMat());
-            GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP_T], 1, GL_TRUE, getMVPMat());
-            if(glprogram->builtin_matrix[MAT_MVP_I]!=-1 || glprogram->builtin_matrix[MAT_MVP_IT]!=-1) {
-                GLfloat invmat[16];
-                matrix_inverse(getMVPMat(), invmat);
-                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP_I], 1, GL_FALSE, invmat);
-                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP_IT], 1, GL_TRUE, invmat);
-            }
-        }
-        if(glprogram->builtin_matrix[MAT_MV]!=-1 || glprogram->builtin_matrix[MAT_MV_I]!=-1
-            || glprogram->builtin_matrix[MAT_MV_T]!=-1 || glprogram->builtin_matrix[MAT_MV_IT]!=-1)
-        {
-            GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV], 1, GL_FALSE, getMVMat());
-            GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV_T], 1, GL_TRUE, getMVMat());
-            if(glprogram->builtin_matrix[MAT_MV_I]!=-1 || glprogram->builtin_matrix[MAT_MV_IT]!=-1) {
-                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV_I], 1, GL_FALSE, getInvMVMat());
-                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV_IT], 1, GL_TRUE, getInvMVMat());
-            }
-        }
-        if(glprogram->builtin_matrix[MAT_P]!=-1 || glprogram->builtin_matrix[MAT_P_I]!=-1
-            || glprogram->builtin_matrix[MAT_P_T]!=-1 || glprogram->builtin_matrix[MAT_P_IT]!=-1)
-        {
-            GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P], 1, GL_FALSE, getPMat());
-            GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P_T], 1, GL_TRUE, getPMat());
-            if(glprogram->builtin_matrix[MAT_P_I]!=-1 || glprogram->builtin_matrix[MAT_P_IT]!=-1) {
-                GLfloat invmat[16];
-                matrix_inverse(getPMat(), invmat);
-                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P_I], 1, GL_FALSE, invmat);
-                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P_IT], 1, GL_TRUE, invmat);
+        if(fpe_NeedSync(glprogram, FPE_SYNC_MATRIX)) {
+            if(glprogram->builtin_matrix[MAT_MVP]!=-1 || glprogram->builtin_matrix[MAT_MVP_I]!=-1
+                || glprogram->builtin_matrix[MAT_MVP_T]!=-1 || glprogram->builtin_matrix[MAT_MVP_IT]!=-1)
+            {
+                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP], 1, GL_FALSE, getMVPMat());
+                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP_T], 1, GL_TRUE, getMVPMat());
+                if(glprogram->builtin_matrix[MAT_MVP_I]!=-1 || glprogram->builtin_matrix[MAT_MVP_IT]!=-1) {
+                    GLfloat invmat[16];
+                    matrix_inverse(getMVPMat(), invmat);
+                    GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP_I], 1, GL_FALSE, invmat);
+                    GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP_IT], 1, GL_TRUE, invmat);
+                }
             }
-        }
-        //Normal matrix (mat3 version of transpose(inverse(gl_ModelViewMatrix)))
-        if(glprogram->builtin_matrix[MAT_N]!=-1 || glprogram->builtin_normalrescale!=-1)
-        {
-            if(glprogram->builtin_normalrescale!=-1 && !glstate->fpe_state->rescaling)
+            if(glprogram->builtin_matrix[MAT_MV]!=-1 || glprogram->builtin_matrix[MAT_MV_I]!=-1
+                || glprogram->builtin_matrix[MAT_MV_T]!=-1 || glprogram->builtin_matrix[MAT_MV_IT]!=-1)
             {
-                float tmp = 1.0f;
-                GoUniformfv(glprogram, glprogram->builtin_normalrescale, 1, 1, &tmp);
+                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV], 1, GL_FALSE, getMVMat());
+                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV_T], 1, GL_TRUE, getMVMat());
+                if(glprogram->builtin_matrix[MAT_MV_I]!=-1 || glprogram->builtin_matrix[MAT_MV_IT]!=-1) {
+                    GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV_I], 1, GL_FALSE, getInvMVMat());
+                    GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV_IT], 1, GL_TRUE, getInvMVMat());
+                }
             }
-            if(glprogram->builtin_matrix[MAT_N]!=-1)
+            if(glprogram->builtin_matrix[MAT_P]!=-1 || glprogram->builtin_matrix[MAT_P_I]!=-1
+                || glprogram->builtin_matrix[MAT_P_T]!=-1 || glprogram->builtin_matrix[MAT_P_IT]!=-1)
             {
-                GoUniformMatrix3fv(glprogram, glprogram->builtin_matrix[MAT_N], 1, GL_FALSE, getNormalMat());
+                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P], 1, GL_FALSE, getPMat());
+                GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P_T], 1, GL_TRUE, getPMat());
+                if(glprogram->builtin_matrix[MAT_P_I]!=-1 || glprogram->builtin_matrix[MAT_P_IT]!=-1) {
+                    GLfloat invmat[16];
+                    matrix_inverse(getPMat(), invmat);
+                    GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P_I], 1, GL_FALSE, invmat);
+                    GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P_IT], 1, GL_TRUE, invmat);
+                }
             }
-            if((glprogram->builtin_normalrescale!=-1 && glstate->fpe_state->rescaling))
+            //Normal matrix (mat3 version of transpose(inverse(gl_ModelViewMatrix)))
+            if(glprogram->builtin_matrix[MAT_N]!=-1 || glprogram->builtin_normalrescale!=-1)
             {
-                if(glprogram->builtin_normalrescale!=-1) {
-                    const float *invmat = getInvMVMat();
-                    float tmp = 1.0f/sqrtf(invmat[3*4+1]*invmat[3*4+1]+invmat[3*4+2]*invmat[3*4+2]+invmat[3*4+3]*invmat[3*4+3]);
+                if(glprogram->builtin_normalrescale!=-1 && !glstate->fpe_state->rescaling)
+                {
+                    float tmp = 1.0f;
                     GoUniformfv(glprogram, glprogram->builtin_normalrescale, 1, 1, &tmp);
                 }
+                if(glprogram->builtin_matrix[MAT_N]!=-1)
+                {
+                    GoUniformMatrix3fv(glprogram, glprogram->builtin_matrix[MAT_N], 1, GL_FALSE, getNormalMat());
+                }
+                if((glprogram->builtin_normalrescale!=-1 && glstate->fpe_state->rescaling))
+                {
+                    if(glprogram->builtin_normalrescale!=-1) {
+                        const float *invmat = getInvMVMat();
+                        float tmp = 1.0f/sqrtf(invmat[3*4+1]*invmat[3*4+1]+invmat[3*4+2]*invmat[3*4+2]+invmat[3*4+3]*invmat[3*4+3]);
+                        GoUniformfv(glprogram, glprogram->builtin_normalrescale, 1, 1, &tmp);
+                    }
+                }
             }
         }
         //Texture matrices
+        if(fpe_NeedSync(glprogram, FPE_SYNC_TEXMAT))
         for (int i=0; i<MAX_TEX; i++) {
             if(glprogram->builtin_matrix[MAT_T0+i*4]!=-1 || glprogram->builtin_matrix[MAT_T0_I+i*4]!=-1
                 || glprogram->builtin_matrix[MAT_T0_T+i*4]!=-1 || glprogram->builtin_matrix[MAT_T0_IT+i*4]!=-1)
@@ -1019,7 +1070,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         GoUniformiv(glprogram, glprogram->builtin_instanceID, 1, 1, &glstate->instanceID);
     }
     // fog parameters
-    if(glprogram->builtin_fog.has)
+    if(glprogram->builtin_fog.has && fpe_NeedSync(glprogram, FPE_SYNC_FOG))
     {
         GoUniformfv(glprogram, glprogram->builtin_fog.color, 4, 1, glstate->fog.color);
         GoUniformfv(glprogram, glprogram->builtin_fog.density, 1, 1, &glstate->fog.density);
@@ -1049,7 +1100,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         GoUniformfv(glprogram, glprogram->builtin_pointsprite.distanceQuadraticAttenuation, 1, 1, glstate->pointsprite.distance+2);
     }
     // texenv
-    if(glprogram->has_builtin_texenv)
+    if(glprogram->has_builtin_texenv && fpe_NeedSync(glprogram, FPE_SYNC_TEXENV))
     {
         for (int i=0; i<hardext.maxtex; i++) {
             GoUniformfv(glprogram, glprogram->builtin_texenvcolor[i], 4, 1, glstate->texenv[i].env.color);
@@ -1073,12 +1124,12 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         }
     }
     // fpe
-    if(glprogram->fpe_alpharef!=-1)
+    if(glprogram->fpe_alpharef!=-1 && fpe_NeedSync(glprogram, FPE_SYNC_ALPHAREF))
     {
         float alpharef = floorf(glstate->alpharef*255.f);
         GoUniformfv(glprogram, glprogram->fpe_alpharef, 1, 1, &alpharef);
     }
-    if(glprogram->has_builtin_texsampler)
+    if(glprogram->has_builtin_texsampler && fpe_NeedSync(glprogram, FPE_SYNC_SAMPLER))
     {
         for (int i=0; i<hardext.maxtex; i++)
             GoUniformiv(glprogram, glprogram->builtin_texsampler[i], 1, 1, &i); // very basic stuff here, but sampler needs to be a uniform...
@@ -1094,6 +1145,16 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
     }
     
 
+    // can the arrays be streamed in the VBO ring? (all or none, and not if some conversion is needed)
+    int stream = globals4es.streamvbo && count>0 && (type==0 || type==GL_UNSIGNED_SHORT || type==GL_UNSIGNED_INT);
+    for(int i=0; i<hardext.maxvattrib && stream; i++)
+        if(glprogram->va_size[i]) {
+            vertexattrib_t *w = (glprogram->has_builtin_attrib)?(&wanted[i]):(&glstate->glesva.wanted[i]);
+            if(w->vaarray && !w->divisor && (w->size==GL_BGRA || w->type==GL_DOUBLE))
+                stream = 0;
+        }
+    int streamed[MAX_VATTRIB];
+    int nstreamed = 0;
     // set VertexAttrib if needed
     for(int i=0; i<hardext.maxvattrib; i++) 
     if(glprogram->va_size[i])   // only check used VA...
@@ -1117,9 +1178,18 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         if(v->vaarray) {
             // array case
             void * ptr = (void*)((uintptr_t)w->pointer + ((w->buffer)?(uintptr_t)w->buffer->data:0));
-            if(dirty || v->size!=w->size || v->type!=w->type || v->normalized!=w->normalized 
+            if(stream) {
+                // pointer will be set once the array is in the VBO ring
+                v->size = w->size;
+                v->type = w->type;
+                v->normalized = w->normalized;
+                v->stride = w->stride;
+                v->pointer = ptr;
+                v->buffer = w->buffer;
+                streamed[nstreamed++] = i;
+            } else if(dirty || v->size!=w->size || v->type!=w->type || v->normalized!=w->normalized 
                 || v->stride!=w->stride || v->buffer!=w->buffer
-                || v->pointer!=ptr) {
+                || v->pointer!=ptr || v->streamed) {
                 if((w->size==GL_BGRA || w->type==GL_DOUBLE) && !*scratch) { 
                     // need to adjust, so first need the min/max (a shame as I already must have that somewhere)
                     int imin, imax;
@@ -1156,7 +1226,9 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
                     v->buffer = w->buffer; // buffer is unused here
                 }
                 LOAD_GLES2(glVertexAttribPointer);
+                if(globals4es.streamvbo) streamvbo_BindArray(0);
                 gles_glVertexAttribPointer(i, v->size, v->type, v->normalized, v->stride, v->pointer);
+                v->streamed = 0;
                 DBG(printf("glVertexAttribPointer(%d, %d, %s, %d, %d, %p)\n", i, v->size, PrintEnum(v->type), v->normalized, v->stride, (GLvoid*)((uintptr_t)v->pointer+((v->buffer)?(uintptr_t)v->buffer->data:0)));)
             }
         } else {
@@ -1207,6 +1279,30 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
             gles_glDisableVertexAttribArray(i);
         }
     }
+    // now stream the arrays
+    glstate->streamvbo.base = -1;
+    if(nstreamed) {
+        int imin, imax;
+        if(type==0) {
+            imin = first; imax = first+count;
+        } else {
+            if(type==GL_UNSIGNED_INT)
+                getminmax_indices_ui(indices, &imax, &imin, count);
+            else
+                getminmax_indices_us(indices, &imax, &imin, count);
+            ++imax;
+        }
+        if(!streamvbo_Vertices(nstreamed, streamed, imin, imax)) {
+            // nothing to stream after all, use the arrays directly
+            LOAD_GLES2(glVertexAttribPointer);
+            streamvbo_BindArray(0);
+            for (int k=0; k<nstreamed; k++) {
+                vertexattrib_t *v = &glstate->glesva.vertexattrib[streamed[k]];
+                gles_glVertexAttribPointer(streamed[k], v->size, v->type, v->normalized, v->stride, v->pointer);
+                v->streamed = 0;
+            }
+        }
+    }
 }
 
 void realize_blitenv(int alpha) {
@@ -1234,14 +1330,16 @@ void realize_blitenv(int alpha) {
             // array case
             if(v->size!=2 || v->type!=GL_FLOAT || v->normalized!=0 
                 || v->stride!=0 || v->pointer!=((i==0)?glstate->blit->vert:glstate->blit->tex) 
-                || v->buffer!=0) {
+                || v->buffer!=0 || v->streamed) {
                 v->size = 2;
                 v->type = GL_FLOAT;
                 v->normalized = 0;
                 v->stride = 0;
                 v->pointer = ((i==0)?glstate->blit->vert:glstate->blit->tex);
                 v->buffer = 0;
+                v->streamed = 0;
                 LOAD_GLES2(glVertexAttribPointer);
+                if(globals4es.streamvbo) streamvbo_BindArray(0);
                 gles_glVertexAttribPointer(i, v->size, v->type, v->normalized, v->stride, v->pointer);
             }
         }
@@ -1251,6 +1349,9 @@ void realize_blitenv(int alpha) {
 // ********* Builtin GL Uniform, VertexAttrib and co *********
 
 void builtin_Init(program_t *glprogram) {
+    // uniforms are all to be set
+    memset(glprogram->fpe_sync, 0, sizeof(glprogram->fpe_sync));
+    glprogram->fpe_father = 0;
     // initialise emulated builtin matrix uniform to -1
     for (int i=0; i<MAT_MAX; i++)
         glprogram->builtin_matrix[i] = -1;
@@ -197,6 +197,10 @@ void builtin_Init(program_t *glprogram);
 int builtin_CheckUniform(program_t *glprogram, char* name, GLint id, int size);
 int builtin_CheckVertexAttrib(program_t *glprogram, char* name, GLint id);
 
+void fpe_Warmup();   // build all the programs of the archive (see psa.h)
+
+#define FPE_DIRTY(group) glstate->fpe_sync[group] = FPE_STAMP()
+
 void realize_glenv(int ispoint, int first, int count, GLenum type, const void* indices, void** scratch);
 void realize_blitenv(int alpha);
 
@@ -852,12 +852,21 @@ void flush() {
         glstate->list.active = NULL;
         glstate->list.pending = 0;
         mylist = end_renderlist(mylist);
+        for (renderlist_t *l = mylist; l; l = l->next)
+            if (l->len) glstate->list.merged_out++;
         draw_renderlist(mylist);
         free_renderlist(mylist);
     }
     glstate->list.active = NULL;
 }
 
+__attribute__((visibility("default"))) void gl4es_merge_stats(unsigned int *in, unsigned int *out) {
+    // draws that went in the pending list, and the draws actually issued for them, since the last call
+    if(in) *in = glstate->list.merged_in;
+    if(out) *out = glstate->list.merged_out;
+    glstate->list.merged_in = glstate->list.merged_out = 0;
+}
+
 #ifndef NOX11
 extern void BlitEmulatedPixmap();
 #endif
@@ -1007,6 +1016,7 @@ void gl4es_scratch_vertex(int alloc) {
         glGenBuffers(1, &glstate->scratch_vertex);
     }
     gles_glBindBuffer(GL_ARRAY_BUFFER, glstate->scratch_vertex);
+    glstate->streamvbo.vbo_bound = glstate->scratch_vertex;
     if(glstate->scratch_vertex_size < alloc) {
         gles_glBufferData(GL_ARRAY_BUFFER, alloc, NULL, GL_DYNAMIC_DRAW);
         glstate->scratch_vertex_size = alloc;
@@ -1016,6 +1026,7 @@ void gl4es_scratch_vertex(int alloc) {
 void gl4es_use_scratch_vertex(int use) {
     LOAD_GLES(glBindBuffer);
     gles_glBindBuffer(GL_ARRAY_BUFFER, use?glstate->scratch_vertex:0);
+    glstate->streamvbo.vbo_bound = use?glstate->scratch_vertex:0;
 }
 
 void gl4es_scratch_indices(int alloc) {
@@ -1026,6 +1037,7 @@ void gl4es_scratch_indices(int alloc) {
         glGenBuffers(1, &glstate->scratch_indices);
     }
     gles_glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glstate->scratch_indices);
+    glstate->streamvbo.ibo_bound = glstate->scratch_indices;
     if(glstate->scratch_indices_size < alloc) {
         gles_glBufferData(GL_ELEMENT_ARRAY_BUFFER, alloc, NULL, GL_DYNAMIC_DRAW);
         glstate->scratch_indices_size = alloc;
@@ -1035,6 +1047,7 @@ void gl4es_scratch_indices(int alloc) {
 void gl4es_use_scratch_indices(int use) {
     LOAD_GLES(glBindBuffer);
     gles_glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, use?glstate->scratch_indices:0);
+    glstate->streamvbo.ibo_bound = use?glstate->scratch_indices:0;
 }
 
 #if defined(AMIGAOS4) || (defined(NOX11) && defined(NOEGL))
@@ -175,6 +175,8 @@ void* NewGLState(void* shared_glstate, int es2only) {
     // fpe
     if(hardext.esversion>1) {
         glstate->fpe_state = (fpe_state_t*)calloc(1, sizeof(fpe_state_t));
+        for (int i=0; i<FPE_SYNC_MAX; i++)
+            FPE_DIRTY(i);
         glstate->glsl->es2 = es2only;
         fpe_Init(glstate);
     }
@@ -318,6 +320,8 @@ void* NewGLState(void* shared_glstate, int es2only) {
     // fpe
     if(hardext.esversion>1) {
         glstate->fpe_state = (fpe_state_t*)calloc(1, sizeof(fpe_state_t));
+        for (int i=0; i<FPE_SYNC_MAX; i++)
+            FPE_DIRTY(i);
         glstate->glsl->es2 = es2only;
         if(!shared_glstate)
             fpe_Init(glstate);
@@ -484,6 +488,8 @@ void DeleteGLState(void* oldstate) {
     // scratch buffer
     if(state->scratch)
         free(state->scratch);
+    if(state->streamvbo.indices)
+        free(state->streamvbo.indices);
     // merger buffers
     if(state->merger_master)
         free(state->merger_master);
@@ -8,6 +8,7 @@
 #include "queries.h"
 #include "stack.h"
 #include "stencil.h"
+#include "streamvbo.h"
 
 typedef struct {
     int                 dummy[16];  // dummy zone, test for memory overwriting...
@@ -82,6 +83,7 @@ typedef struct {
     fpe_fpe_t           *fpe;
     fpestatus_t         fpe_client;
     fpe_cache_t         *fpe_cache;
+    unsigned int        fpe_sync[FPE_SYNC_MAX]; // stamp of the last change of each group of builtin uniforms
     gleshard_s_t        *gleshard;          //shared
     gleshard_ns_t       glesva;
     glesblit_t          *blit;
@@ -106,6 +108,8 @@ typedef struct {
     GLsizei             scratch_vertex_size;
     GLuint              scratch_indices;
     GLsizei             scratch_indices_size;
+    // streaming VBO
+    streamvbo_t         streamvbo;
     // Implementation read
     GLenum              readf; // implementation Read Format
     GLenum              readt; // implementation Read Type
@@ -12,6 +12,7 @@
 #include "debug.h"
 #include "loader.h"
 #include "logs.h"
+#include "psa.h"
 #ifdef __EMSCRIPTEN__
 #define NO_INIT_CONSTRUCTOR
 #endif
@@ -422,6 +423,12 @@ void initialize_gl4es() {
             SHUT(LOGD("LIBGL: Trying to batch subsequent glDrawXXXX of size < %d vertices\n", tmp*10));
         }
     }
+    globals4es.mergedraw = 0;
+    char *env_mergedraw = getenv("LIBGL_MERGEDRAW");
+    if(env_mergedraw && sscanf(env_mergedraw, "%d", &tmp)==1 && tmp>0) {
+        globals4es.mergedraw = tmp;
+        SHUT(LOGD("LIBGL: Merging subsequent compatible glDrawElements of less than %d indices\n", tmp));
+    }
 
     globals4es.usevbo = 0;
     char *env_usevbo = getenv("LIBGL_USEVBO");
@@ -434,6 +441,15 @@ void initialize_gl4es() {
     if(globals4es.usevbo) {
         SHUT(LOGD("LIBGL: VBO used (in a few cases)\n"));
     }
+    // stream client arrays in a ring of VBO (GLES2 backend only, not mixed with LIBGL_USEVBO)
+    globals4es.streamvbo = (hardext.esversion>1 && !globals4es.usevbo)?1:0;
+    char *env_streamvbo = getenv("LIBGL_STREAMVBO");
+    if(env_streamvbo && strcmp(env_streamvbo,"0") == 0) {
+        globals4es.streamvbo = 0;
+    }
+    if(globals4es.streamvbo) {
+        SHUT(LOGD("LIBGL: Client arrays streamed in VBO\n"));
+    }
 
     globals4es.fbomakecurrent = 0;
     if((hardext.vendor & VEND_ARM) || (globals4es.usefb))
@@ -520,6 +536,22 @@ void initialize_gl4es() {
     }
     env(LIBGL_NOCLEAN, globals4es.noclean, "Don't clean Context when destroy");
 
+    // FPE program archive
+    if(hardext.esversion>1) {
+        char *env_nopsa = getenv("LIBGL_NOPSA");
+        char *env_psa = getenv("LIBGL_PSA");
+        char *env_home = getenv("HOME");
+        if(env_nopsa && !strcmp(env_nopsa, "1")) {
+            SHUT(LOGD("LIBGL: FPE program archive disabled\n"));
+        } else if(env_psa && env_psa[0]) {
+            fpe_InitPSA(env_psa);
+        } else if(env_home) {
+            char name[1024];
+            snprintf(name, sizeof(name), "%s/.gl4es.psa", env_home);
+            fpe_InitPSA(name);
+        }
+    }
+
 
     globals4es.glxrecycle = 1;
 #ifndef NOEGL
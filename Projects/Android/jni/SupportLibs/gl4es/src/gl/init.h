@@ -46,9 +46,11 @@ typedef struct _globals4es {
  int force16bits;
  int nohighp;
  int batch;
+ int mergedraw;
  int es;
  int gl;
  int usevbo;
+ int streamvbo;
  int comments;
  int forcenpot;
  int fbomakecurrent;    // hack to bind/unbind FBO when doing glXMakeCurrent
@@ -87,6 +87,7 @@ DBG(printf("init_matrix(%p)\n", glstate);)
 }
 
 void set_fpe_textureidentity() {
+	FPE_DIRTY(FPE_SYNC_TEXMAT);
 	if(glstate->texture_matrix[glstate->texture.active]->identity)	// inverted in fpe flags
 		glstate->fpe_state->textmat &= ~(1<<glstate->texture.active);
 	else
@@ -172,10 +173,12 @@ DBG(printf("glPopMatrix(), list=%p\n", glstate->list.active);)
 		case GL_PROJECTION:
 			P(projection_matrix);
 			glstate->mvp_matrix_dirty = 1;
+			FPE_DIRTY(FPE_SYNC_MATRIX);
 			break;
 		case GL_MODELVIEW:
 			P(modelview_matrix);
 			glstate->mvp_matrix_dirty = 1;
+			FPE_DIRTY(FPE_SYNC_MATRIX);
 			glstate->inv_mv_matrix_dirty = 1;
 			glstate->normal_matrix_dirty = 1;
 			break;
@@ -209,9 +212,10 @@ DBG(printf("glLoadMatrix(%f, %f, %f, %f, %f, %f, %f...), list=%p\n", m[0], m[1],
 	const int id = update_current_identity(0);
 	if(glstate->matrix_mode==GL_MODELVIEW)
 		glstate->normal_matrix_dirty = glstate->inv_mv_matrix_dirty = 1;
-	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION)
+	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION) {
 		glstate->mvp_matrix_dirty = 1;
-	else if(glstate->fpe_state)
+		FPE_DIRTY(FPE_SYNC_MATRIX);
+	} else if(glstate->fpe_state)
 		set_fpe_textureidentity();
     if(send_to_hardware()) {
 		LOAD_GLES(glLoadMatrixf);
@@ -242,9 +246,10 @@ DBG(printf("glMultMatrix(%f, %f, %f, %f, %f, %f, %f...), list=%p\n", m[0], m[1],
 	const int id = update_current_identity(0);
 	if(glstate->matrix_mode==GL_MODELVIEW)
 		glstate->normal_matrix_dirty = glstate->inv_mv_matrix_dirty = 1;
-	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION)
+	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION) {
 		glstate->mvp_matrix_dirty = 1;
-	else if(glstate->fpe_state)
+		FPE_DIRTY(FPE_SYNC_MATRIX);
+	} else if(glstate->fpe_state)
 		set_fpe_textureidentity();
 	DBG(printf(" => (%f, %f, %f, %f, %f, %f, %f...)\n", current_mat[0], current_mat[1], current_mat[2], current_mat[3], current_mat[4], current_mat[5], current_mat[6]);)
 	if(send_to_hardware()) {
@@ -270,9 +275,10 @@ DBG(printf("glLoadIdentity(), list=%p\n", glstate->list.active);)
 	update_current_identity(1);
 	if(glstate->matrix_mode==GL_MODELVIEW)
 		glstate->normal_matrix_dirty = glstate->inv_mv_matrix_dirty = 1;
-	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION)
+	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION) {
 		glstate->mvp_matrix_dirty = 1;
-	else if(glstate->fpe_state)
+		FPE_DIRTY(FPE_SYNC_MATRIX);
+	} else if(glstate->fpe_state)
 		set_fpe_textureidentity();
 	if(send_to_hardware()) {
 		LOAD_GLES(glLoadIdentity);
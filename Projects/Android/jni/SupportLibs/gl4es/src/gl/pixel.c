@@ -751,6 +751,207 @@ bool quarter_pixel(const GLvoid *src[16],
     #undef write_each
 }
 
+// Row kernels for the fast conversion paths of pixel_convert.
+// On NEON, 8 or 16 pixels are done at once, the remaining pixels of the row go thru the scalar loop
+// (that also is the only path elsewhere). Both give the exact same result.
+// ir / ib are the byte index of red and blue in the source pixel.
+#if defined(__ARM_NEON__) && !defined(__BIG_ENDIAN__)
+#define PIXEL_NEON
+static inline uint8x8_t neon_luminance(uint8x8_t r, uint8x8_t g, uint8x8_t b) {
+    uint16x8_t l = vmull_u8(r, vdup_n_u8(77));
+    l = vmlal_u8(l, g, vdup_n_u8(151));
+    l = vmlal_u8(l, b, vdup_n_u8(28));
+    return vshrn_n_u16(l, 8);
+}
+#endif
+
+static void row_swap_rb(const GLubyte *s, GLubyte *d, int n) {
+#ifdef PIXEL_NEON
+    for (; n>=16; n-=16, s+=64, d+=64) {
+        uint8x16x4_t p = vld4q_u8(s);
+        uint8x16_t tmp = p.val[0];
+        p.val[0] = p.val[2];
+        p.val[2] = tmp;
+        vst4q_u8(d, p);
+    }
+#endif
+    for (; n>0; --n, s+=4, d+=4) {
+        const GLuint tmp = *(const GLuint*)s;
+        #ifdef __BIG_ENDIAN__
+        *(GLuint*)d = (tmp&0x00ff00ff) | ((tmp&0x0000ff00)<<16) | ((tmp&0xff000000)>>16);
+        #else
+        *(GLuint*)d = (tmp&0xff00ff00) | ((tmp&0x00ff0000)>>16) | ((tmp&0x000000ff)<<16);
+        #endif
+    }
+}
+
+static void row_luminance_alpha(const GLubyte *s, GLubyte *d, int n, int ir, int ib) {
+#ifdef PIXEL_NEON
+    for (; n>=8; n-=8, s+=32, d+=16) {
+        uint8x8x4_t p = vld4_u8(s);
+        uint8x8x2_t o;
+        o.val[0] = neon_luminance(ir?p.val[2]:p.val[0], p.val[1], ib?p.val[2]:p.val[0]);
+        o.val[1] = p.val[3];
+        vst2_u8(d, o);
+    }
+#endif
+    for (; n>0; --n, s+=4, d+=2) {
+        #ifdef __BIG_ENDIAN__
+        *(GLushort*)d = ((((int)s[3-ir])*77 + ((int)s[2])*151 + ((int)s[3-ib])*28)&0xff00)>>8 | (s[0]<<8);
+        #else
+        *(GLushort*)d = ((((int)s[ir])*77 + ((int)s[1])*151 + ((int)s[ib])*28)&0xff00)>>8 | (s[3]<<8);
+        #endif
+    }
+}
+
+static void row_luminance(const GLubyte *s, GLubyte *d, int n, int step, int ir, int ib) {
+#ifdef PIXEL_NEON
+    if(step==4) {
+        for (; n>=8; n-=8, s+=32, d+=8) {
+            uint8x8x4_t p = vld4_u8(s);
+            vst1_u8(d, neon_luminance(ir?p.val[2]:p.val[0], p.val[1], ib?p.val[2]:p.val[0]));
+        }
+    } else {
+        for (; n>=8; n-=8, s+=24, d+=8) {
+            uint8x8x3_t p = vld3_u8(s);
+            vst1_u8(d, neon_luminance(ir?p.val[2]:p.val[0], p.val[1], ib?p.val[2]:p.val[0]));
+        }
+    }
+#endif
+    for (; n>0; --n, s+=step, d++) {
+        #ifdef __BIG_ENDIAN__
+        *d = (((int)s[3-ir])*77 + ((int)s[2])*151 + ((int)s[3-ib])*28)>>8;
+        #else
+        *d = (((int)s[ir])*77 + ((int)s[1])*151 + ((int)s[ib])*28)>>8;
+        #endif
+    }
+}
+
+static void row_rgb(const GLubyte *s, GLubyte *d, int n, int step, int ir, int ib) {
+#ifdef PIXEL_NEON
+    if(step==4) {
+        for (; n>=8; n-=8, s+=32, d+=24) {
+            uint8x8x4_t p = vld4_u8(s);
+            uint8x8x3_t o;
+            o.val[0] = ir?p.val[2]:p.val[0];
+            o.val[1] = p.val[1];
+            o.val[2] = ib?p.val[2]:p.val[0];
+            vst3_u8(d, o);
+        }
+    } else {
+        for (; n>=8; n-=8, s+=24, d+=24) {
+            uint8x8x3_t p = vld3_u8(s);
+            uint8x8x3_t o;
+            o.val[0] = ir?p.val[2]:p.val[0];
+            o.val[1] = p.val[1];
+            o.val[2] = ib?p.val[2]:p.val[0];
+            vst3_u8(d, o);
+        }
+    }
+#endif
+    for (; n>0; --n, s+=step, d+=3) {
+        d[0] = s[ir];
+        d[1] = s[1];
+        d[2] = s[ib];
+    }
+}
+
+static void row_rgb_rgba(const GLubyte *s, GLubyte *d, int n, int ir, int ib) {
+#ifdef PIXEL_NEON
+    for (; n>=8; n-=8, s+=24, d+=32) {
+        uint8x8x3_t p = vld3_u8(s);
+        uint8x8x4_t o;
+        o.val[0] = ir?p.val[2]:p.val[0];
+        o.val[1] = p.val[1];
+        o.val[2] = ib?p.val[2]:p.val[0];
+        o.val[3] = vdup_n_u8(255);
+        vst4_u8(d, o);
+    }
+#endif
+    for (; n>0; --n, s+=3, d+=4) {
+        d[0] = s[ir];
+        d[1] = s[1];
+        d[2] = s[ib];
+        d[3] = 255;
+    }
+}
+
+// L or LA (step 1 or 2) to RGBA
+static void row_luminance_rgba(const GLubyte *s, GLubyte *d, int n, int step) {
+#ifdef PIXEL_NEON
+    for (; n>=8; n-=8, s+=8*step, d+=32) {
+        uint8x8x4_t o;
+        if(step==2) {
+            uint8x8x2_t p = vld2_u8(s);
+            o.val[0] = p.val[0];
+            o.val[3] = p.val[1];
+        } else {
+            o.val[0] = vld1_u8(s);
+            o.val[3] = vdup_n_u8(255);
+        }
+        o.val[1] = o.val[2] = o.val[0];
+        vst4_u8(d, o);
+    }
+#endif
+    for (; n>0; --n, s+=step, d+=4) {
+        d[0] = d[1] = d[2] = s[0];
+        d[3] = (step==2)?s[1]:255;
+    }
+}
+
+// the packed 16bits formats are built with shift-right-and-insert: each channel is widened to
+// the top of a 16bits lane, then shifted in below the channels already in place
+static void row_565(const GLubyte *s, GLubyte *d, int n, int step, int ir, int ib) {
+#ifdef PIXEL_NEON
+    for (; n>=8; n-=8, s+=8*step, d+=16) {
+        uint8x8_t r, g, b;
+        if(step==4) {
+            uint8x8x4_t p = vld4_u8(s);
+            r = ir?p.val[2]:p.val[0]; g = p.val[1]; b = ib?p.val[2]:p.val[0];
+        } else {
+            uint8x8x3_t p = vld3_u8(s);
+            r = ir?p.val[2]:p.val[0]; g = p.val[1]; b = ib?p.val[2]:p.val[0];
+        }
+        uint16x8_t o = vshll_n_u8(r, 8);
+        o = vsriq_n_u16(o, vshll_n_u8(g, 8), 5);
+        o = vsriq_n_u16(o, vshll_n_u8(b, 8), 11);
+        vst1q_u16((uint16_t*)d, o);
+    }
+#endif
+    for (; n>0; --n, s+=step, d+=2)
+        *(GLushort*)d = ((GLushort)(s[ib]&0xf8)>>(3)) | ((GLushort)(s[1]&0xfc)<<(5-2)) | ((GLushort)(s[ir]&0xf8)<<(11-3));
+}
+
+static void row_5551(const GLubyte *s, GLubyte *d, int n, int ir, int ib) {
+#ifdef PIXEL_NEON
+    for (; n>=8; n-=8, s+=32, d+=16) {
+        uint8x8x4_t p = vld4_u8(s);
+        uint16x8_t o = vshll_n_u8(ir?p.val[2]:p.val[0], 8);
+        o = vsriq_n_u16(o, vshll_n_u8(p.val[1], 8), 5);
+        o = vsriq_n_u16(o, vshll_n_u8(ib?p.val[2]:p.val[0], 8), 10);
+        o = vsriq_n_u16(o, vshll_n_u8(p.val[3], 8), 15);
+        vst1q_u16((uint16_t*)d, o);
+    }
+#endif
+    for (; n>0; --n, s+=4, d+=2)
+        *(GLushort*)d = ((GLushort)(s[ib]&0xf8)>>(3-1)) | ((GLushort)(s[1]&0xf8)<<(5-2)) | ((GLushort)(s[ir]&0xf8)<<(10-2)) | ((GLushort)(s[3])>>7);
+}
+
+static void row_4444(const GLubyte *s, GLubyte *d, int n, int ir, int ib) {
+#ifdef PIXEL_NEON
+    for (; n>=8; n-=8, s+=32, d+=16) {
+        uint8x8x4_t p = vld4_u8(s);
+        uint16x8_t o = vshll_n_u8(ir?p.val[2]:p.val[0], 8);
+        o = vsriq_n_u16(o, vshll_n_u8(p.val[1], 8), 4);
+        o = vsriq_n_u16(o, vshll_n_u8(ib?p.val[2]:p.val[0], 8), 8);
+        o = vsriq_n_u16(o, vshll_n_u8(p.val[3], 8), 12);
+        vst1q_u16((uint16_t*)d, o);
+    }
+#endif
+    for (; n>0; --n, s+=4, d+=2)
+        *(GLushort*)d = ((GLushort)(s[3]&0xf0)>>(4)) | ((GLushort)(s[ib]&0xf0)) | ((GLushort)(s[1]&0xf0)<<(4)) | ((GLushort)(s[ir]&0xf0)<<(8));
+}
+
 bool pixel_convert(const GLvoid *src, GLvoid **dst,
                    GLuint width, GLuint height,
                    GLenum src_format, GLenum src_type,
@@ -795,27 +996,64 @@ bool pixel_convert(const GLvoid *src, GLvoid **dst,
     uintptr_t src_pos = widthalign((uintptr_t)src, align);
     uintptr_t dst_pos = widthalign((uintptr_t)*dst, align);
     // fast optimized loop for common conversion cases first...
-    // TODO: Rewrite that with some Macro, it's obviously doable to simplify the reading (and writting) of all this
-    // simple BGRA <-> RGBA / UNSIGNED_BYTE 
-    if ((((src_format == GL_BGRA) && (dst_format == GL_RGBA)) || ((src_format == GL_RGBA) && (dst_format == GL_BGRA))) 
-        && (dst_type == GL_UNSIGNED_BYTE) && ((src_type == GL_UNSIGNED_BYTE))) {
-        GLuint tmp;
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				tmp = *(const GLuint*)src_pos;
-                #ifdef __BIG_ENDIAN__
-                *(GLuint*)dst_pos = (tmp&0x00ff00ff) | ((tmp&0x0000ff00)<<16) | ((tmp&0xff000000)>>16);
-                #else
-				*(GLuint*)dst_pos = (tmp&0xff00ff00) | ((tmp&0x00ff0000)>>16) | ((tmp&0x000000ff)<<16);
-                #endif
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
+    // each case runs a row kernel on every line of the image
+    #define convert_rows(kernel, ...)                                               \
+        for (int i = 0; i < height; i++) {                                          \
+            kernel((const GLubyte*)src_pos, (GLubyte*)dst_pos, width, __VA_ARGS__); \
+            src_pos += width*src_stride + src_widthadj;                             \
+            dst_pos += width*dst_stride + dst_width;                                \
+        }                                                                           \
+        return true
+    const int src_rgba = ((src_format == GL_RGBA) || (src_format == GL_RGB));
+    const int src_bgra = ((src_format == GL_BGRA) || (src_format == GL_BGR));
+    const int ir = src_bgra?2:0;
+    const int ib = src_bgra?0:2;
+    if ((src_type == GL_UNSIGNED_BYTE) && (dst_type == GL_UNSIGNED_BYTE)) {
+        // simple BGRA <-> RGBA
+        if (((src_format == GL_BGRA) && (dst_format == GL_RGBA)) || ((src_format == GL_RGBA) && (dst_format == GL_BGRA))) {
+            for (int i = 0; i < height; i++) {
+                row_swap_rb((const GLubyte*)src_pos, (GLubyte*)dst_pos, width);
+                src_pos += width*src_stride + src_widthadj;
+                dst_pos += width*dst_stride + dst_width;
+            }
+            return true;
+        }
+        // RGBA / BGRA -> LA
+        if (((src_format == GL_RGBA) || (src_format == GL_BGRA)) && (dst_format == GL_LUMINANCE_ALPHA)) {
+            convert_rows(row_luminance_alpha, ir, ib);
+        }
+        // RGB(A) / BGR(A) -> L
+        if ((src_rgba || src_bgra) && (dst_format == GL_LUMINANCE)) {
+            convert_rows(row_luminance, src_stride, ir, ib);
+        }
+        // BGR(A) -> RGB and RGBA -> RGB
+        if (((src_format != GL_RGB) && (src_rgba || src_bgra)) && (dst_format == GL_RGB)) {
+            convert_rows(row_rgb, src_stride, ir, ib);
+        }
+        // RGB / BGR -> RGBA
+        if (((src_format == GL_RGB) || (src_format == GL_BGR)) && (dst_format == GL_RGBA)) {
+            convert_rows(row_rgb_rgba, ir, ib);
+        }
+        // L / LA -> RGBA
+        if (((src_format == GL_LUMINANCE) || (src_format == GL_LUMINANCE_ALPHA)) && (dst_format == GL_RGBA)) {
+            convert_rows(row_luminance_rgba, src_stride);
+        }
+    }
+    if ((src_type == GL_UNSIGNED_BYTE) && (src_rgba || src_bgra)) {
+        // RGB(A) / BGR(A) -> RGB565
+        if ((dst_format == GL_RGB) && (dst_type == GL_UNSIGNED_SHORT_5_6_5)) {
+            convert_rows(row_565, src_stride, ir, ib);
+        }
+        // RGBA / BGRA -> RGBA5551
+        if ((src_stride == 4) && (dst_format == GL_RGBA) && (dst_type == GL_UNSIGNED_SHORT_5_5_5_1)) {
+            convert_rows(row_5551, ir, ib);
+        }
+        // RGBA / BGRA -> RGBA4444
+        if ((src_stride == 4) && (dst_format == GL_RGBA) && (dst_type == GL_UNSIGNED_SHORT_4_4_4_4)) {
+            convert_rows(row_4444, ir, ib);
         }
-        return true;
     }
+    #undef convert_rows
     // BGRA1555 -> RGBA5551
     if ((src_format == GL_BGRA) && (dst_format == GL_RGBA) && (dst_type == GL_UNSIGNED_SHORT_5_5_5_1) && (src_type == GL_UNSIGNED_SHORT_1_5_5_5_REV)) {
       GLushort tmp;
@@ -832,210 +1070,6 @@ bool pixel_convert(const GLvoid *src, GLvoid **dst,
       }
       return true;
     }
-    // RGBA -> LA
-    if ((src_format == GL_RGBA) && (dst_format == GL_LUMINANCE_ALPHA) && (dst_type == GL_UNSIGNED_BYTE) && ((src_type == GL_UNSIGNED_BYTE))) {
-        GLuint tmp;
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				//tmp = *(const GLuint*)src_pos;
-                unsigned char* byte_src = (unsigned char*)src_pos;
-                #ifdef __BIG_ENDIAN__
-                *(GLushort*)dst_pos = ((((int)byte_src[3])*77 + ((int)byte_src[2])*151 + ((int)byte_src[1])*28)&0xff00)>>8 | (byte_src[0]<<8);
-                #else
-                *(GLushort*)dst_pos = ((((int)byte_src[0])*77 + ((int)byte_src[1])*151 + ((int)byte_src[2])*28)&0xff00)>>8 | (byte_src[3]<<8);
-                #endif
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // BGRA -> LA
-    if ((src_format == GL_BGRA) && (dst_format == GL_LUMINANCE_ALPHA) && (dst_type == GL_UNSIGNED_BYTE) && ((src_type == GL_UNSIGNED_BYTE))) {
-        GLuint tmp;
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				//tmp = *(const GLuint*)src_pos;
-                unsigned char* byte_src = (unsigned char*)src_pos;
-                #ifdef __BIG_ENDIAN__
-                *(GLushort*)dst_pos = ((((int)byte_src[1])*77 + ((int)byte_src[2])*151 + ((int)byte_src[3])*28)&0xff00)>>8 | (byte_src[0]<<8);
-                #else
-                *(GLushort*)dst_pos = ((((int)byte_src[2])*77 + ((int)byte_src[1])*151 + ((int)byte_src[0])*28)&0xff00)>>8 | (byte_src[3]<<8);
-                #endif
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // RGB(A) -> L
-    if (((src_format == GL_RGBA)||(src_format == GL_RGB)) && (dst_format == GL_LUMINANCE) && (dst_type == GL_UNSIGNED_BYTE) && ((src_type == GL_UNSIGNED_BYTE))) {
-        GLuint tmp;
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				//tmp = *(const GLuint*)src_pos;
-                unsigned char* byte_src = (unsigned char*)src_pos;
-                #ifdef __BIG_ENDIAN__
-                *(unsigned char*)dst_pos = (((int)byte_src[3])*77 + ((int)byte_src[2])*151 + ((int)byte_src[1])*28)>>8;
-                #else
-                *(unsigned char*)dst_pos = (((int)byte_src[0])*77 + ((int)byte_src[1])*151 + ((int)byte_src[2])*28)>>8;
-                #endif
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // BGR(A) -> L
-    if (((src_format == GL_BGRA)||(src_format == GL_BGR)) && (dst_format == GL_LUMINANCE) && (dst_type == GL_UNSIGNED_BYTE) && ((src_type == GL_UNSIGNED_BYTE))) {
-        GLuint tmp;
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				//tmp = *(const GLuint*)src_pos;
-                unsigned char* byte_src = (unsigned char*)src_pos;
-                #ifdef __BIG_ENDIAN__
-                *(unsigned char*)dst_pos = (((int)byte_src[1])*77 + ((int)byte_src[2])*151 + ((int)byte_src[3])*28)>>8;
-                #else
-                *(unsigned char*)dst_pos = (((int)byte_src[2])*77 + ((int)byte_src[1])*151 + ((int)byte_src[0])*28)>>8;
-                #endif
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // BGR(A) -> RGB
-    if (((src_format == GL_BGR)||(src_format == GL_BGRA)) && (dst_format == GL_RGB) && (dst_type == GL_UNSIGNED_BYTE) && ((src_type == GL_UNSIGNED_BYTE))) {
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				((char*)dst_pos)[0] = ((char*)src_pos)[2];
-				((char*)dst_pos)[1] = ((char*)src_pos)[1];
-				((char*)dst_pos)[2] = ((char*)src_pos)[0];
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // BGR -> RGBA
-    if (((src_format == GL_BGR)) && (dst_format == GL_RGBA) && (dst_type == GL_UNSIGNED_BYTE) && ((src_type == GL_UNSIGNED_BYTE))) {
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				((char*)dst_pos)[0] = ((char*)src_pos)[2];
-				((char*)dst_pos)[1] = ((char*)src_pos)[1];
-				((char*)dst_pos)[2] = ((char*)src_pos)[0];
-                ((char*)dst_pos)[3] = 255;
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // RGBA -> RGB
-    if ((src_format == GL_RGBA) && (dst_format == GL_RGB) && (dst_type == GL_UNSIGNED_BYTE) && ((src_type == GL_UNSIGNED_BYTE))) {
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				((char*)dst_pos)[0] = ((char*)src_pos)[0];
-				((char*)dst_pos)[1] = ((char*)src_pos)[1];
-				((char*)dst_pos)[2] = ((char*)src_pos)[2];
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // RGB(A) -> RGB565
-    if (((src_format == GL_RGB)||(src_format == GL_RGBA)) && (dst_format == GL_RGB) && (dst_type == GL_UNSIGNED_SHORT_5_6_5) && ((src_type == GL_UNSIGNED_BYTE))) {
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				*(GLushort*)dst_pos = ((GLushort)(((char*)src_pos)[2]&0xf8)>>(3)) | ((GLushort)(((char*)src_pos)[1]&0xfc)<<(5-2)) | ((GLushort)(((char*)src_pos)[0]&0xf8)<<(11-3));
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // BGR(A) -> RGB565
-    if (((src_format == GL_BGR) || (src_format == GL_BGRA)) && (dst_format == GL_RGB) && (dst_type == GL_UNSIGNED_SHORT_5_6_5) && ((src_type == GL_UNSIGNED_BYTE))) {
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				*(GLushort*)dst_pos = ((GLushort)(((char*)src_pos)[0]&0xf8)>>(3)) | ((GLushort)(((char*)src_pos)[1]&0xfc)<<(5-2)) | ((GLushort)(((char*)src_pos)[2]&0xf8)<<(11-3));
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // RGBA -> RGBA5551
-    if ((src_format == GL_RGBA) && (dst_format == GL_RGBA) && (dst_type == GL_UNSIGNED_SHORT_5_5_5_1) && ((src_type == GL_UNSIGNED_BYTE))) {
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				*(GLushort*)dst_pos = ((GLushort)(((char*)src_pos)[2]&0xf8)>>(3-1)) | ((GLushort)(((char*)src_pos)[1]&0xf8)<<(5-2)) | ((GLushort)(((char*)src_pos)[0]&0xf8)<<(10-2)) | ((GLushort)(((char*)src_pos)[3])>>15);
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // BGRA -> RGBA5551
-    if ((src_format == GL_BGRA) && (dst_format == GL_RGBA) && (dst_type == GL_UNSIGNED_SHORT_5_5_5_1) && ((src_type == GL_UNSIGNED_BYTE))) {
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				*(GLushort*)dst_pos = ((GLushort)(((char*)src_pos)[0]&0xf8)>>(3-1)) | ((GLushort)(((char*)src_pos)[1]&0xf8)<<(5-2)) | ((GLushort)(((char*)src_pos)[2]&0xf8)<<(10-2)) | ((GLushort)(((char*)src_pos)[3])>>15);
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // RGBA -> RGBA4444
-    if ((src_format == GL_RGBA) && (dst_format == GL_RGBA) && (dst_type == GL_UNSIGNED_SHORT_4_4_4_4) && ((src_type == GL_UNSIGNED_BYTE))) {
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				*(GLushort*)dst_pos = ((GLushort)(((char*)src_pos)[3]&0xf0))>>(4) | ((GLushort)(((char*)src_pos)[2]&0xf0)) | ((GLushort)(((char*)src_pos)[1]&0xf0))<<(4) | ((GLushort)(((char*)src_pos)[0]&0xf0))<<(8);
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
-    // BGRA -> RGBA4444
-    if ((src_format == GL_BGRA) && (dst_format == GL_RGBA) && (dst_type == GL_UNSIGNED_SHORT_4_4_4_4) && ((src_type == GL_UNSIGNED_BYTE))) {
-        for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				*(GLushort*)dst_pos = ((GLushort)(((char*)src_pos)[3]&0xf0)>>(4)) | ((GLushort)(((char*)src_pos)[0]&0xf0)) | ((GLushort)(((char*)src_pos)[1]&0xf0)<<(4)) | ((GLushort)(((char*)src_pos)[2]&0xf0)<<(8));
-				src_pos += src_stride;
-				dst_pos += dst_stride;
-			}
-			dst_pos += dst_width;
-            src_pos += src_widthadj;
-        }
-        return true;
-    }
     // BGRA4444 -> RGBA 
     if ((src_format == GL_BGRA) && (dst_format == GL_RGBA) && (dst_type == GL_UNSIGNED_BYTE) && (src_type == GL_UNSIGNED_SHORT_4_4_4_4_REV)) {
         for (int i = 0; i < height; i++) {
@@ -79,10 +79,24 @@ typedef struct {
 
 KHASH_MAP_DECLARE_INT(uniformlist, uniform_t *);
 
+// Groups of builtin uniforms, that are only updated when the GL State they come from has changed.
+// Each change of a group takes a new stamp (see FPE_DIRTY), and each program remember the stamps it was updated with
+#define FPE_SYNC_MATRIX     0   // modelview, projection and derived matrices
+#define FPE_SYNC_TEXMAT     1   // texture matrices
+#define FPE_SYNC_FOG        2
+#define FPE_SYNC_ALPHAREF   3
+#define FPE_SYNC_TEXENV     4   // texenv color and scales
+#define FPE_SYNC_SAMPLER    5   // samplers never change
+#define FPE_SYNC_MAX        6
+
+extern unsigned int fpe_stamp;  // last stamp given, unique among all contexts
+#define FPE_STAMP() (++fpe_stamp)
+
 typedef struct {
     void*           cache;  // buffer of the uniform size
     int             cap;    // capacity of the cache
     int             size;   // next available free space in the cache
+    unsigned int    stamp;  // stamp of the last change of a value
 } uniformcache_t;
 
 typedef struct {
@@ -215,6 +229,8 @@ typedef struct {
     int                             has_builtin_texadjust;
     texunit_t                       texunits[MAX_TEX];
     void*                           fpe_cache;  // that will be an fpe_cache_t*
+    unsigned int                    fpe_sync[FPE_SYNC_MAX]; // stamps of the GL State used for the last update of the builtin uniforms
+    unsigned int                    fpe_father; // stamp of the father uniforms last synchronized (for custom FPE programs)
 } program_t;
 
 KHASH_MAP_DECLARE_INT(programlist, program_t *);
@@ -238,6 +254,10 @@ void gl4es_glLinkProgram(GLuint program);
 void gl4es_glUseProgram(GLuint program);
 void gl4es_glValidateProgram(GLuint program);
 
+// used by the FPE program archive (psa.c)
+int gl4es_useProgramBinary(GLuint program, int length, GLenum format, void* binary);
+int gl4es_getProgramBinary(GLuint program, int *length, GLenum *format, void** binary);
+
 
 #define CHECK_PROGRAM(type, program) \
     if(!program) { \
@@ -0,0 +1,214 @@
+#include "psa.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../glx/hardext.h"
+#include "debug.h"
+#include "init.h"
+#include "logs.h"
+#include "program.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+#define SHUT(a) if(!globals4es.nobanner) a
+
+#define PSA_MAGIC   "GL4ESPSA"
+#define PSA_VERSION 1
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t statesize;
+    uint32_t signature;     // hash of the hardware capabilities, generated shaders depend on them
+} psa_header_t;
+
+typedef struct {
+    fpe_state_t state;
+    GLenum      format;
+    int         size;       // 0 if there is no binary, just the key
+    void*       prog;
+} psa_entry_t;
+
+typedef struct {
+    char*        name;
+    int          size;
+    int          cap;
+    psa_entry_t* entries;
+    int          rewrite;   // file has to be written from scratch instead of appended
+    int          readonly;  // file cannot be written
+} psa_t;
+
+static psa_t *psa = NULL;
+
+static uint32_t psa_Signature() {
+    // FNV-1a of the hardware capabilities
+    uint32_t h = 2166136261u;
+    const unsigned char* p = (const unsigned char*)&hardext;
+    for (int i=0; i<sizeof(hardext); i++)
+        h = (h^p[i])*16777619u;
+    return h;
+}
+
+static psa_entry_t* psa_Find(fpe_state_t* state) {
+    // linear search is enough, it's only done when the FPE cache misses
+    for (int i=0; i<psa->size; i++)
+        if(!memcmp(&psa->entries[i].state, state, sizeof(fpe_state_t)))
+            return &psa->entries[i];
+    return NULL;
+}
+
+static psa_entry_t* psa_Add(fpe_state_t* state) {
+    psa_entry_t* e = psa_Find(state);
+    if(e) {
+        // replaced entry, the file will need to be compacted
+        free(e->prog);
+        psa->rewrite = 1;
+    } else {
+        if(psa->size==psa->cap) {
+            psa->cap += 64;
+            psa->entries = (psa_entry_t*)realloc(psa->entries, psa->cap*sizeof(psa_entry_t));
+        }
+        e = &psa->entries[psa->size++];
+        memcpy(&e->state, state, sizeof(fpe_state_t));
+    }
+    e->format = 0;
+    e->size = 0;
+    e->prog = NULL;
+    return e;
+}
+
+static void psa_Read() {
+    FILE *f = fopen(psa->name, "rb");
+    if(!f) {
+        psa->rewrite = 1;
+        return;
+    }
+    psa_header_t head;
+    if(fread(&head, sizeof(head), 1, f)!=1 || memcmp(head.magic, PSA_MAGIC, sizeof(head.magic))
+     || head.version!=PSA_VERSION || head.statesize!=sizeof(fpe_state_t) || head.signature!=psa_Signature()) {
+        SHUT(LOGD("LIBGL: Program archive %s is outdated, it will be rebuilt\n", psa->name));
+        fclose(f);
+        psa->rewrite = 1;
+        return;
+    }
+    fpe_state_t state;
+    uint32_t hdr[2];    // format, size
+    while(fread(&state, sizeof(state), 1, f)==1 && fread(hdr, sizeof(hdr), 1, f)==1) {
+        void* prog = NULL;
+        if(hdr[1]) {
+            prog = malloc(hdr[1]);
+            if(fread(prog, hdr[1], 1, f)!=1) {
+                // truncated entry (process killed while writing?), drop it
+                free(prog);
+                psa->rewrite = 1;
+                break;
+            }
+        }
+        psa_entry_t* e = psa_Add(&state);
+        e->format = hdr[0];
+        e->size = hdr[1];
+        e->prog = prog;
+    }
+    fclose(f);
+    SHUT(LOGD("LIBGL: %d FPE programs loaded from archive %s\n", psa->size, psa->name));
+}
+
+static int psa_WriteEntry(FILE* f, psa_entry_t* e) {
+    uint32_t hdr[2] = {e->format, e->size};
+    if(fwrite(&e->state, sizeof(e->state), 1, f)!=1 || fwrite(hdr, sizeof(hdr), 1, f)!=1)
+        return 0;
+    if(e->size && fwrite(e->prog, e->size, 1, f)!=1)
+        return 0;
+    return 1;
+}
+
+static void psa_Write(psa_entry_t* e) {
+    if(psa->readonly)
+        return;
+    // new programs are just appended, so nothing is lost if the process is killed
+    FILE *f = fopen(psa->name, psa->rewrite?"wb":"ab");
+    if(!f) {
+        SHUT(LOGD("LIBGL: Cannot write program archive %s\n", psa->name));
+        psa->readonly = 1;
+        return;
+    }
+    int ok = 1;
+    if(psa->rewrite) {
+        psa_header_t head;
+        memset(&head, 0, sizeof(head));
+        memcpy(head.magic, PSA_MAGIC, sizeof(head.magic));
+        head.version = PSA_VERSION;
+        head.statesize = sizeof(fpe_state_t);
+        head.signature = psa_Signature();
+        ok = (fwrite(&head, sizeof(head), 1, f)==1);
+        for (int i=0; i<psa->size && ok; i++)
+            ok = psa_WriteEntry(f, &psa->entries[i]);
+    } else
+        ok = psa_WriteEntry(f, e);
+    fclose(f);
+    psa->rewrite = !ok;
+    DBG(printf("LIBGL: program archive written (%d entries, ok=%d)\n", psa->size, ok);)
+}
+
+void fpe_InitPSA(const char* name) {
+    if(psa)
+        fpe_FreePSA();
+    psa = (psa_t*)malloc(sizeof(psa_t));
+    memset(psa, 0, sizeof(psa_t));
+    psa->name = strdup(name);
+    psa_Read();
+}
+
+void fpe_FreePSA() {
+    if(!psa)
+        return;
+    for (int i=0; i<psa->size; i++)
+        free(psa->entries[i].prog);
+    free(psa->entries);
+    free(psa->name);
+    free(psa);
+    psa = NULL;
+}
+
+int fpe_GetProgramPSA(GLuint prog, fpe_state_t* state) {
+    if(!psa)
+        return 0;
+    psa_entry_t* e = psa_Find(state);
+    if(!e || !e->size)
+        return 0;
+    return gl4es_useProgramBinary(prog, e->size, e->format, e->prog);
+}
+
+void fpe_AddProgramPSA(GLuint prog, fpe_state_t* state) {
+    if(!psa)
+        return;
+    int size = 0;
+    GLenum format = 0;
+    void* binary = NULL;
+    // without binary support, only the key is kept
+    gl4es_getProgramBinary(prog, &size, &format, &binary);
+    psa_entry_t* e = psa_Find(state);
+    if(e && !e->size && !size)
+        return; // already known
+    e = psa_Add(state);
+    e->format = format;
+    e->size = size;
+    e->prog = binary;
+    psa_Write(e);
+}
+
+int fpe_SizePSA() {
+    return psa?psa->size:0;
+}
+
+fpe_state_t* fpe_StatePSA(int i) {
+    if(!psa || i<0 || i>=psa->size)
+        return NULL;
+    return &psa->entries[i].state;
+}
@@ -0,0 +1,26 @@
+#ifndef _GL4ES_PSA_H_
+#define _GL4ES_PSA_H_
+
+/*
+  This is the PSA : Precompiled Shader Archive
+
+  It keeps on disk the FPE programs created by previous runs, so they don't have to
+  be compiled again when the same fixed pipeline state is first drawn.
+  Each entry is the (relevant) fpe_state_t used as key of the FPE cache, and the program
+  binary when GL_OES_get_program_binary is available. Without the extension, only the
+  key is stored: FPE shaders are generated from the state, so the key is enough to
+  compile them again ahead of time (see fpe_Warmup).
+*/
+
+#include "fpe.h"
+
+void fpe_InitPSA(const char* name);
+void fpe_FreePSA();
+
+int fpe_GetProgramPSA(GLuint prog, fpe_state_t* state);     // 1 if prog has been loaded from the archive
+void fpe_AddProgramPSA(GLuint prog, fpe_state_t* state);    // add a freshly linked program to the archive
+
+int fpe_SizePSA();
+fpe_state_t* fpe_StatePSA(int i);
+
+#endif // _GL4ES_PSA_H_
@@ -115,6 +115,9 @@ typedef struct {
 
     GLuint count;
     GLuint cap;
+
+    GLuint merged_in;   // statistics of draws merged in the pending list, since last gl4es_merge_stats
+    GLuint merged_out;
 } displaylist_state_t;
 
 typedef struct {
@@ -0,0 +1,149 @@
+#include "streamvbo.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "../glx/hardext.h"
+#include "debug.h"
+#include "enum_info.h"
+#include "gl4es.h"
+#include "glstate.h"
+#include "init.h"
+#include "loader.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+#define STREAMVBO_VERTEX    (1024*1024)     // initial size of the vertex ring
+#define STREAMVBO_INDICES   (256*1024)      // initial size of the indices ring
+#define STREAMVBO_ALIGN(a)  (((a)+15)&~15)
+
+void streamvbo_BindArray(GLuint buffer) {
+    streamvbo_t *s = &glstate->streamvbo;
+    if(s->vbo_bound == buffer)
+        return;
+    LOAD_GLES(glBindBuffer);
+    gles_glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    s->vbo_bound = buffer;
+}
+
+void streamvbo_BindElements(GLuint buffer) {
+    streamvbo_t *s = &glstate->streamvbo;
+    if(s->ibo_bound == buffer)
+        return;
+    LOAD_GLES(glBindBuffer);
+    gles_glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+    s->ibo_bound = buffer;
+}
+
+// make room for size bytes in a ring buffer (already bound), orphaning it if needed
+static void streamvbo_Reserve(GLenum target, GLsizei *ring_size, GLsizei *ring_offs, GLsizei initial, GLsizei size) {
+    if(*ring_offs + size <= *ring_size)
+        return;
+    LOAD_GLES(glBufferData);
+    if(!*ring_size)
+        *ring_size = initial;
+    while(*ring_size < size)
+        *ring_size *= 2;
+    // orphan: the driver keeps the old storage alive for the pending draws
+    gles_glBufferData(target, *ring_size, NULL, GL_STREAM_DRAW);
+    *ring_offs = 0;
+    glstate->streamvbo.orphans++;
+}
+
+int streamvbo_Vertices(int n, const int *va, GLint imin, GLint imax) {
+    streamvbo_t *s = &glstate->streamvbo;
+    uintptr_t src[MAX_VATTRIB];
+    GLsizei len[MAX_VATTRIB];
+    GLsizei dst[MAX_VATTRIB];
+    int from[MAX_VATTRIB];
+    GLsizei total = 0;
+    if(imax<=imin)
+        return 0;
+    // get the range of each array, interleaved arrays are uploaded only once
+    for (int k=0; k<n; k++) {
+        vertexattrib_t *v = &glstate->glesva.vertexattrib[va[k]];
+        int esize = gl_sizeof(v->type)*v->size;
+        int stride = v->stride?v->stride:esize;
+        src[k] = (uintptr_t)v->pointer + imin*stride;
+        len[k] = (imax-imin-1)*stride + esize;
+        from[k] = -1;
+        for (int j=0; j<k && from[k]==-1; j++)
+            if(from[j]==-1 && src[k]>=src[j] && src[k]+len[k]<=src[j]+len[j])
+                from[k] = j;
+        if(from[k]==-1)
+            total += STREAMVBO_ALIGN(len[k]);
+    }
+    LOAD_GLES(glGenBuffers);
+    LOAD_GLES(glBufferSubData);
+    LOAD_GLES2(glVertexAttribPointer);
+    if(!s->vbo)
+        gles_glGenBuffers(1, &s->vbo);
+    streamvbo_BindArray(s->vbo);
+    streamvbo_Reserve(GL_ARRAY_BUFFER, &s->vbo_size, &s->vbo_offs, STREAMVBO_VERTEX, total);
+    for (int k=0; k<n; k++) {
+        vertexattrib_t *v = &glstate->glesva.vertexattrib[va[k]];
+        if(from[k]==-1) {
+            dst[k] = s->vbo_offs;
+            gles_glBufferSubData(GL_ARRAY_BUFFER, dst[k], len[k], (const GLvoid*)src[k]);
+            s->vbo_offs += STREAMVBO_ALIGN(len[k]);
+        } else
+            dst[k] = dst[from[k]] + (src[k]-src[from[k]]);
+        gles_glVertexAttribPointer(va[k], v->size, v->type, v->normalized, v->stride, (const GLvoid*)(uintptr_t)dst[k]);
+        v->streamed = 1;
+        DBG(printf("streamed VA[%d] %d bytes at %d\n", va[k], len[k], dst[k]);)
+    }
+    s->bytes += total;
+    s->draws++;
+    s->base = imin;
+    return 1;
+}
+
+const GLvoid* streamvbo_Indices(GLsizei count, GLenum type, const GLvoid* indices) {
+    streamvbo_t *s = &glstate->streamvbo;
+    int isize = (type==GL_UNSIGNED_INT)?4:2;
+    GLsizei size = count*isize;
+    // rebase the indices on the first streamed vertex
+    if(s->base) {
+        if(s->indices_cap < size) {
+            free(s->indices);
+            s->indices_cap = size;
+            s->indices = malloc(s->indices_cap);
+        }
+        if(type==GL_UNSIGNED_INT) {
+            const GLuint *in = (const GLuint*)indices;
+            GLuint *out = (GLuint*)s->indices;
+            for (int i=0; i<count; i++)
+                out[i] = in[i] - s->base;
+        } else {
+            const GLushort *in = (const GLushort*)indices;
+            GLushort *out = (GLushort*)s->indices;
+            for (int i=0; i<count; i++)
+                out[i] = in[i] - s->base;
+        }
+        indices = s->indices;
+    }
+    LOAD_GLES(glGenBuffers);
+    LOAD_GLES(glBufferSubData);
+    if(!s->ibo)
+        gles_glGenBuffers(1, &s->ibo);
+    streamvbo_BindElements(s->ibo);
+    streamvbo_Reserve(GL_ELEMENT_ARRAY_BUFFER, &s->ibo_size, &s->ibo_offs, STREAMVBO_INDICES, STREAMVBO_ALIGN(size));
+    GLsizei offs = s->ibo_offs;
+    gles_glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offs, size, indices);
+    s->ibo_offs += STREAMVBO_ALIGN(size);
+    s->bytes += size;
+    return (const GLvoid*)(uintptr_t)offs;
+}
+
+__attribute__((visibility("default"))) void gl4es_stream_stats(unsigned int *bytes, unsigned int *draws, unsigned int *orphans) {
+    // statistics since the last call (so per frame if called once a frame)
+    streamvbo_t *s = &glstate->streamvbo;
+    if(bytes) *bytes = s->bytes;
+    if(draws) *draws = s->draws;
+    if(orphans) *orphans = s->orphans;
+    s->bytes = s->draws = s->orphans = 0;
+}
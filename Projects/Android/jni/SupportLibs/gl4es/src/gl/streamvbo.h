@@ -0,0 +1,36 @@
+#ifndef _GL4ES_STREAMVBO_H_
+#define _GL4ES_STREAMVBO_H_
+
+/*
+  Streaming VBO
+
+  On GLES2 backend, client arrays (and gl4es buffers, that live in client memory) are
+  appended to a ring of real buffer objects right before each draw, so the driver only
+  sees buffer-object draws instead of copying client memory itself.
+  The ring is orphaned (glBufferData with NULL) when full.
+  All the arrays of a draw are streamed, or none: when streamed, vertices from the lowest
+  index used are uploaded, and draws are rebased on it.
+*/
+
+#include "gles.h"
+
+typedef struct {
+    GLuint       vbo, ibo;              // the ring buffers
+    GLsizei      vbo_size, ibo_size;
+    GLsizei      vbo_offs, ibo_offs;    // write position
+    GLuint       vbo_bound, ibo_bound;  // current gles binding
+    GLint        base;                  // first vertex of the draw, -1 if draw is not streamed
+    void*        indices;               // scratch for rebased indices
+    int          indices_cap;
+    unsigned int bytes;                 // statistics since last gl4es_stream_stats
+    unsigned int draws;
+    unsigned int orphans;
+} streamvbo_t;
+
+void streamvbo_BindArray(GLuint buffer);
+void streamvbo_BindElements(GLuint buffer);
+
+int streamvbo_Vertices(int n, const int *va, GLint imin, GLint imax);      // upload vertexattrib va[0..n-1] in vertex range [imin, imax[
+const GLvoid* streamvbo_Indices(GLsizei count, GLenum type, const GLvoid* indices);
+
+#endif // _GL4ES_STREAMVBO_H_
@@ -570,6 +570,7 @@ void gl4es_glTexEnvf(GLenum target, GLenum pname, GLfloat param) {
                     if (glstate->list.pending) flush();
                     t->rgb_scale = param;
                     if(glstate->fpe_state) {
+                        FPE_DIRTY(FPE_SYNC_TEXENV);
                         if(param==1.0f)
                             glstate->fpe_state->texrgbscale &= ~(1<<tmu);
                         else
@@ -586,6 +587,7 @@ void gl4es_glTexEnvf(GLenum target, GLenum pname, GLfloat param) {
                     if (glstate->list.pending) flush();
                     t->alpha_scale = param;
                     if(glstate->fpe_state) {
+                        FPE_DIRTY(FPE_SYNC_TEXENV);
                         if(param==1.0f)
                             glstate->fpe_state->texalphascale &= ~(1<<tmu);
                         else
@@ -633,6 +635,8 @@ void gl4es_glTexEnvfv(GLenum target, GLenum pname, const GLfloat *param) {
         }
         if (glstate->list.pending) flush();
         memcpy(t->color, param, 4*sizeof(GLfloat));
+        if(glstate->fpe_state)
+            FPE_DIRTY(FPE_SYNC_TEXENV);
         errorGL();
         if(hardext.esversion==1) {
             LOAD_GLES2(glTexEnvfv);
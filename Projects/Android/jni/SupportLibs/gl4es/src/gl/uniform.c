@@ -192,6 +192,7 @@ void GoUniformfv(program_t *glprogram, GLint location, int size, int count, cons
     }
     // update uniform
     memcpy(glprogram->cache.cache + m->cache_offs, value, rsize);
+    glprogram->cache.stamp = FPE_STAMP();
     LOAD_GLES2(glUniform1fv);
     LOAD_GLES2(glUniform2fv);
     LOAD_GLES2(glUniform3fv);
@@ -239,6 +240,7 @@ void GoUniformiv(program_t *glprogram, GLint location, int size, int count, cons
     DBG(printf("Uniform updated, cache=%p(%d/%d), offset=%p, size=%d\n", glprogram->cache.cache, glprogram->cache.size, glprogram->cache.cap, m->cache_offs, rsize);)
     // update uniform
     memcpy(glprogram->cache.cache + m->cache_offs, value, rsize);
+    glprogram->cache.stamp = FPE_STAMP();
     LOAD_GLES2(glUniform1iv);
     LOAD_GLES2(glUniform2iv);
     LOAD_GLES2(glUniform3iv);
@@ -561,6 +563,7 @@ void GoUniformMatrix2fv(program_t *glprogram, GLint location, GLsizei count, GLb
     }
     // update uniform
     memcpy(glprogram->cache.cache + m->cache_offs, v, rsize);
+    glprogram->cache.stamp = FPE_STAMP();
     LOAD_GLES2(glUniformMatrix2fv);
     if (gles_glUniformMatrix2fv) {
         gles_glUniformMatrix2fv(m->id, count, GL_FALSE, v);
@@ -627,6 +630,7 @@ void GoUniformMatrix3fv(program_t *glprogram, GLint location, GLsizei count, GLb
     }
     // update uniform
     memcpy(glprogram->cache.cache + m->cache_offs, v, rsize);
+    glprogram->cache.stamp = FPE_STAMP();
     LOAD_GLES2(glUniformMatrix3fv);
     if (gles_glUniformMatrix3fv) {
         gles_glUniformMatrix3fv(m->id, count, GL_FALSE, v);
@@ -689,6 +693,7 @@ void GoUniformMatrix4fv(program_t *glprogram, GLint location, GLsizei count, GLb
     }
     // update uniform
     memcpy(glprogram->cache.cache + m->cache_offs, v, rsize);
+    glprogram->cache.stamp = FPE_STAMP();
     LOAD_GLES2(glUniformMatrix4fv);
     if (gles_glUniformMatrix4fv) {
         gles_glUniformMatrix4fv(m->id, count, GL_FALSE, v);
@@ -27,6 +27,14 @@ endif (TOLERANCE)
 # Use the built library
 set(ENV{LD_LIBRARY_PATH} ${LIBRARY_FOLDER}:$ENV{LD_LIBRARY_PATH})
 
+# Extra environment variable for the test (NAME=VALUE)
+if (TEST_ENV)
+	string(REPLACE "=" ";" TEST_ENV_LIST ${TEST_ENV})
+	list(GET TEST_ENV_LIST 0 TEST_ENV_NAME)
+	list(GET TEST_ENV_LIST 1 TEST_ENV_VALUE)
+	set(ENV{${TEST_ENV_NAME}} ${TEST_ENV_VALUE})
+endif (TEST_ENV)
+
 macro(run_test GLES)
 	if (GLES${GLES}_ENABLED)
 		argument_required(TOLERANCE_GLES${GLES} "All tests require a pixel tolerance for GLES ${GLES}.")
@@ -0,0 +1,12 @@
+#!/bin/sh
+#
+# Runs the given test command, or tells ctest the test is skipped
+# (return code 77) when apitrace is not installed.
+
+if ! command -v apitrace >/dev/null 2>&1
+then
+	echo "apitrace not found, test skipped"
+	exit 77
+fi
+
+exec "$@"
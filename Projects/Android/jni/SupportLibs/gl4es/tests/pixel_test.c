@@ -0,0 +1,181 @@
+// Checks the fast conversion paths of pixel_convert and the threaded DXTc decompression
+// against plain per pixel / per block code, byte for byte.
+// Built with pixel.c and decompress.c only, no GLES library is needed.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/gl/gl4es.h"
+#include "../src/gl/pixel.h"
+#include "../src/gl/decompress.h"
+
+// pixel.c only needs those for paths that are not tested here
+glstate_t *glstate = NULL;
+const char* PrintEnum(GLenum what) {
+    static char buff[16];
+    sprintf(buff, "0x%04x", what);
+    return buff;
+}
+
+static int failures = 0;
+
+static GLubyte random_byte() {
+    return (GLubyte)(rand()>>7);
+}
+
+// expected result of one pixel, from the unsigned byte components of the source
+static void expected_pixel(const GLubyte *s, GLenum src_format, GLenum dst_format, GLenum dst_type, GLubyte *d) {
+    GLubyte r, g, b, a, l;
+    switch(src_format) {
+        case GL_RGBA: r=s[0]; g=s[1]; b=s[2]; a=s[3]; break;
+        case GL_BGRA: r=s[2]; g=s[1]; b=s[0]; a=s[3]; break;
+        case GL_RGB:  r=s[0]; g=s[1]; b=s[2]; a=255; break;
+        case GL_BGR:  r=s[2]; g=s[1]; b=s[0]; a=255; break;
+        case GL_LUMINANCE: r=g=b=s[0]; a=255; break;
+        default: r=g=b=s[0]; a=s[1]; break;    // GL_LUMINANCE_ALPHA
+    }
+    l = (r*77 + g*151 + b*28)>>8;
+    switch(dst_type) {
+        case GL_UNSIGNED_SHORT_5_6_5:
+            *(GLushort*)d = ((r>>3)<<11) | ((g>>2)<<5) | (b>>3);
+            return;
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+            *(GLushort*)d = ((r>>3)<<11) | ((g>>3)<<6) | ((b>>3)<<1) | (a>>7);
+            return;
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+            *(GLushort*)d = ((r>>4)<<12) | ((g>>4)<<8) | ((b>>4)<<4) | (a>>4);
+            return;
+    }
+    switch(dst_format) {
+        case GL_RGBA: d[0]=r; d[1]=g; d[2]=b; d[3]=a; break;
+        case GL_BGRA: d[0]=b; d[1]=g; d[2]=r; d[3]=a; break;
+        case GL_RGB:  d[0]=r; d[1]=g; d[2]=b; break;
+        case GL_LUMINANCE: d[0]=l; break;
+        case GL_LUMINANCE_ALPHA: d[0]=l; d[1]=a; break;
+    }
+}
+
+static int format_size(GLenum format, GLenum type) {
+    if(type!=GL_UNSIGNED_BYTE)
+        return 2;
+    switch(format) {
+        case GL_RGBA: case GL_BGRA: return 4;
+        case GL_RGB: case GL_BGR: return 3;
+        case GL_LUMINANCE_ALPHA: return 2;
+        default: return 1;
+    }
+}
+
+static void test_convert(GLenum src_format, GLenum dst_format, GLenum dst_type, int width, int height, int align) {
+    const int ssize = format_size(src_format, GL_UNSIGNED_BYTE);
+    const int dsize = format_size(dst_format, dst_type);
+    const int spitch = widthalign(width*ssize, align);
+    const int dpitch = widthalign(width*dsize, align);
+    GLubyte *src = malloc(spitch*height);
+    GLubyte *ref = malloc(dpitch*height);
+    GLubyte *dst = NULL;
+    for (int i=0; i<spitch*height; i++)
+        src[i] = random_byte();
+    memset(ref, 0, dpitch*height);
+    for (int y=0; y<height; y++)
+        for (int x=0; x<width; x++)
+            expected_pixel(src+y*spitch+x*ssize, src_format, dst_format, dst_type, ref+y*dpitch+x*dsize);
+
+    if(!pixel_convert(src, (GLvoid**)&dst, width, height, src_format, GL_UNSIGNED_BYTE, dst_format, dst_type, 0, align)) {
+        printf("%s -> %s/%s failed\n", PrintEnum(src_format), PrintEnum(dst_format), PrintEnum(dst_type));
+        failures++;
+    } else {
+        for (int y=0; y<height; y++)
+            if(memcmp(dst+y*dpitch, ref+y*dpitch, width*dsize)) {
+                printf("%s -> %s/%s differs, %dx%d align %d, row %d\n", PrintEnum(src_format), PrintEnum(dst_format), PrintEnum(dst_type), width, height, align, y);
+                failures++;
+                break;
+            }
+    }
+    free(dst);
+    free(ref);
+    free(src);
+}
+
+static void test_dxtc(GLenum format, int width, int height) {
+    const int blocksize = (format==GL_COMPRESSED_RGB_S3TC_DXT1_EXT || format==GL_COMPRESSED_RGBA_S3TC_DXT1_EXT)?8:16;
+    const int size = ((width+3)/4)*((height+3)/4)*blocksize;
+    GLubyte *data = malloc(size);
+    uint32_t *ref = calloc(((width+3)&~3)*((height+3)&~3), 4);
+    for (int i=0; i<size; i++)
+        data[i] = random_byte();
+    const GLubyte *block = data;
+    for (int y=0; y<height; y+=4)
+        for (int x=0; x<width; x+=4, block+=blocksize)
+            switch(format) {
+                case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT: DecompressBlockDXT3(x, y, width, block, ref); break;
+                case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: DecompressBlockDXT5(x, y, width, block, ref); break;
+                default: DecompressBlockDXT1(x, y, width, block, ref); break;
+            }
+
+    uint32_t *pixels = (uint32_t*)uncompressDXTc(width, height, format, size, data);
+    if(memcmp(pixels, ref, width*height*4)) {
+        printf("%s %dx%d differs with %d thread(s)\n", PrintEnum(format), width, height, dxtc_forced_threads);
+        failures++;
+    }
+    free(pixels);
+    free(ref);
+    free(data);
+}
+
+int main(int argc, char **argv) {
+    static const struct {
+        GLenum src_format, dst_format, dst_type;
+    } paths[] = {
+        {GL_BGRA, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_BGRA, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_LUMINANCE, GL_UNSIGNED_BYTE},
+        {GL_RGB,  GL_LUMINANCE, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_LUMINANCE, GL_UNSIGNED_BYTE},
+        {GL_BGR,  GL_LUMINANCE, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_RGB, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_RGB, GL_UNSIGNED_BYTE},
+        {GL_BGR,  GL_RGB, GL_UNSIGNED_BYTE},
+        {GL_RGB,  GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGR,  GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_LUMINANCE, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_LUMINANCE_ALPHA, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_RGB, GL_UNSIGNED_SHORT_5_6_5},
+        {GL_RGB,  GL_RGB, GL_UNSIGNED_SHORT_5_6_5},
+        {GL_BGRA, GL_RGB, GL_UNSIGNED_SHORT_5_6_5},
+        {GL_BGR,  GL_RGB, GL_UNSIGNED_SHORT_5_6_5},
+        {GL_RGBA, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1},
+        {GL_BGRA, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1},
+        {GL_RGBA, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4},
+        {GL_BGRA, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4},
+    };
+    // widths around the 8 and 16 pixels of the vector loops, so the scalar tail is used too
+    static const int widths[] = {1, 3, 7, 8, 9, 15, 16, 17, 31, 33, 64, 257};
+    static const int aligns[] = {1, 4, 8};
+
+    srand(1234);
+    for (int p=0; p<sizeof(paths)/sizeof(paths[0]); p++)
+        for (int w=0; w<sizeof(widths)/sizeof(widths[0]); w++)
+            for (int a=0; a<sizeof(aligns)/sizeof(aligns[0]); a++)
+                test_convert(paths[p].src_format, paths[p].dst_format, paths[p].dst_type, widths[w], 5, aligns[a]);
+
+    // 512x512 and 516x260 are split between threads (the last band of 516x260 is shorter),
+    // 258x256 is not (width not a multiple of 4) and 64x64 is too small
+    static const GLenum formats[] = {GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT};
+    static const int sizes[][2] = {{512, 512}, {516, 260}, {258, 256}, {64, 64}};
+    for (int t=1; t<=4; t++) {
+        dxtc_forced_threads = t;
+        for (int f=0; f<sizeof(formats)/sizeof(formats[0]); f++)
+            for (int s=0; s<sizeof(sizes)/sizeof(sizes[0]); s++)
+                test_dxtc(formats[f], sizes[s][0], sizes[s][1]);
+    }
+    if(failures) {
+        printf("%d failure(s)\n", failures);
+        return 1;
+    }
+    printf("Success.\n");
+    return 0;
+}
@@ -71,6 +71,7 @@ JPEGLIB_FILES = \
   src/jpeg-6/jccoefct.c  \
   src/jpeg-6/jccolor.c  \
   src/jpeg-6/jfdctflt.c  \
+  src/jpeg-6/jfdctint.c  \
   src/jpeg-6/jcdctmgr.c  \
   src/jpeg-6/jcphuff.c  \
   src/jpeg-6/jcmainct.c  \
@@ -96,6 +97,8 @@ JPEGLIB_FILES = \
   src/jpeg-6/jdtrans.c  \
   src/jpeg-6/jerror.c   \
   src/jpeg-6/jidctflt.c  \
+  src/jpeg-6/jidctint.c  \
+  src/jpeg-6/jidctred.c  \
   src/jpeg-6/jmemmgr.c  \
   src/jpeg-6/jmemnobs.c    \
   src/jpeg-6/jutils.c  \
@@ -118,6 +121,7 @@ RENDERER_FILES = \
   src/renderer/tr_mesh.c     \
   src/renderer/tr_model.c     \
   src/renderer/tr_noise.c     \
+  src/renderer/tr_occlusion.c     \
   src/renderer/tr_scene.c     \
   src/renderer/tr_shade.c     \
   src/renderer/tr_shade_calc.c    \
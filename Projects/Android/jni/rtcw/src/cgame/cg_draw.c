@@ -157,9 +157,6 @@ void CG_Text_PaintChar( float x, float y, float width, float height, float scale
 }
 
 void CG_Text_Paint( float x, float y, int font, float scale, vec4_t color, const char *text, float adjust, int limit, int style ) {
-	int len, count;
-	vec4_t newColor;
-	glyphInfo_t *glyph;
 	float useScale;
 	fontInfo_t *fnt = &cgDC.Assets.textFont;
 
@@ -182,58 +179,16 @@ void CG_Text_Paint( float x, float y, int font, float scale, vec4_t color, const
 	color[3] *= cg_hudAlpha.value;  // (SA) adjust for cg_hudalpha
 
 	if ( text ) {
-		const char *s = text;
-		trap_R_SetColor( color );
-		memcpy( &newColor[0], &color[0], sizeof( vec4_t ) );
-		len = strlen( text );
-		if ( limit > 0 && len > limit ) {
-			len = limit;
-		}
-		count = 0;
-		while ( s && *s && count < len ) {
-			glyph = &fnt->glyphs[(int)*s];
-			//int yadj = Assets.textFont.glyphs[text[i]].bottom + Assets.textFont.glyphs[text[i]].top;
-			//float yadj = scale * (Assets.textFont.glyphs[text[i]].imageHeight - Assets.textFont.glyphs[text[i]].height);
-			if ( Q_IsColorString( s ) ) {
-				memcpy( newColor, g_color_table[ColorIndex( *( s + 1 ) )], sizeof( newColor ) );
-				newColor[3] = color[3];
-				trap_R_SetColor( newColor );
-				s += 2;
-				continue;
-			} else {
-				float yadj = useScale * glyph->top;
-				if ( style == ITEM_TEXTSTYLE_SHADOWED || style == ITEM_TEXTSTYLE_SHADOWEDMORE ) {
-					int ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
-					colorBlack[3] = newColor[3];
-					trap_R_SetColor( colorBlack );
-					CG_Text_PaintChar( x + ofs, y - yadj + ofs,
-									   glyph->imageWidth,
-									   glyph->imageHeight,
-									   useScale,
-									   glyph->s,
-									   glyph->t,
-									   glyph->s2,
-									   glyph->t2,
-									   glyph->glyph );
-					colorBlack[3] = 1.0;
-					trap_R_SetColor( newColor );
-				}
-				CG_Text_PaintChar( x, y - yadj,
-								   glyph->imageWidth,
-								   glyph->imageHeight,
-								   useScale,
-								   glyph->s,
-								   glyph->t,
-								   glyph->s2,
-								   glyph->t2,
-								   glyph->glyph );
-				// CG_DrawPic(x, y - yadj, scale * cgDC.Assets.textFont.glyphs[text[i]].imageWidth, scale * cgDC.Assets.textFont.glyphs[text[i]].imageHeight, cgDC.Assets.textFont.glyphs[text[i]].glyph);
-				x += ( glyph->xSkip * useScale ) + adjust;
-				s++;
-				count++;
-			}
+		float xscale = 1, yscale = 1, ofs = 0;
+
+		// the whole string goes to the renderer at once, glyph units are mapped
+		// to screen pixels the same way CG_AdjustFrom640 maps the virtual screen
+		CG_AdjustFrom640( &x, &y, &xscale, &yscale );
+		if ( style == ITEM_TEXTSTYLE_SHADOWED || style == ITEM_TEXTSTYLE_SHADOWEDMORE ) {
+			ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
 		}
-		trap_R_SetColor( NULL );
+		trap_R_DrawText( x, y, useScale * xscale, useScale * yscale, adjust * xscale,
+						 ofs * xscale, ofs * yscale, color, text, limit, fnt );
 	}
 }
 
@@ -3767,6 +3722,7 @@ void CG_DrawActive( int stereoView ) {
 
 	// offset vieworg appropriately if we're doing stereo separation
 	VectorCopy( cg.refdef.vieworg, baseOrg );
+	VectorCopy( cg.refdef.vieworg, cg.refdef.headorg );    // both eyes test coronas from here
 
 	int vr_cinematic_stereo = trap_Cvar_VariableIntegerValue( "vr_cinematic_stereo");
 	if ( !cgVR->scopeengaged &&
@@ -3779,6 +3735,8 @@ void CG_DrawActive( int stereoView ) {
 	if (!cg.cameraMode) {
         cg.refdef.vieworg[2] -= 64;
         cg.refdef.vieworg[2] += (cgVR->hmdposition[1] + cg_heightAdjust.value) * cg_worldScale.value;
+        cg.refdef.headorg[2] -= 64;
+        cg.refdef.headorg[2] += (cgVR->hmdposition[1] + cg_heightAdjust.value) * cg_worldScale.value;
     }
 
 	cg.refdef.glfog.registered = 0; // make sure it doesn't use fog from another scene
@@ -1634,7 +1634,7 @@ void CG_Spotlight( centity_t *cent, float *color, vec3_t realstart, vec3_t light
 		// first use dot to determine if it's facing the camera
 		dot = DotProduct( lightDir, dirtolight );
 
-		// it's facing the camera, find out how closely and trace to see if the source can be seen
+		// it's facing the camera, find out how closely
 
 		deg = RAD2DEG( M_PI - acos( dot ) );
 		if ( deg <= FLAREANGLE ) { // start flare a bit before the camera gets inside the cylinder
@@ -1642,9 +1642,9 @@ void CG_Spotlight( centity_t *cent, float *color, vec3_t realstart, vec3_t light
 			flarescale = 1 - ( deg / FLAREANGLE );
 		}
 
-		if ( lightInEyes ) {   // the dot check succeeded, now do a trace
-//			CG_Trace( &tr, start, NULL, NULL, camloc, -1, MASK_ALL &~(CONTENTS_MONSTERCLIP|CONTENTS_AREAPORTAL|CONTENTS_CLUSTERPORTAL));
-			CG_Trace( &tr, start, NULL, NULL, camloc, -1, MASK_SOLID );
+		if ( lightInEyes ) {   // the dot check succeeded, now trace against doors and movers
+			// the renderer checks the source against the world and fades it out if it's hidden
+			CG_TraceEntities( &tr, start, NULL, NULL, camloc, -1, MASK_SOLID );
 			if ( tr.fraction != 1 ) {
 				lightInEyes = qfalse;
 			}
@@ -1636,7 +1636,8 @@ static void CG_Corona( centity_t *cent ) {
 
 
 	if ( !behind && !toofar ) {
-		CG_Trace( &tr, cg.refdef.vieworg, NULL, NULL, cent->lerpOrigin, -1, MASK_SOLID | CONTENTS_BODY ); // added blockage by players.  not sure how this is going to be since this is their bb, not their model (too much blockage)
+		// the renderer checks it against the world and clears the flag if it's hidden
+		CG_TraceEntities( &tr, cg.refdef.vieworg, NULL, NULL, cent->lerpOrigin, -1, MASK_SOLID | CONTENTS_BODY ); // added blockage by players.  not sure how this is going to be since this is their bb, not their model (too much blockage)
 
 		if ( tr.fraction == 1 ) {
 			flags = 1;
@@ -185,6 +185,27 @@ void    CG_Trace( trace_t *result, const vec3_t start, const vec3_t mins, const
 	*result = t;
 }
 
+/*
+================
+CG_TraceEntities
+
+Only clips against the solid entities, for callers that
+leave the world to the renderer
+================
+*/
+void    CG_TraceEntities( trace_t *result, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end,
+						  int skipNumber, int mask ) {
+	trace_t t;
+
+	memset( &t, 0, sizeof( t ) );
+	t.fraction = 1.0;
+	VectorCopy( end, t.endpos );
+	t.entityNum = ENTITYNUM_NONE;
+	CG_ClipMoveToEntities( start, mins, maxs, end, skipNumber, mask, qfalse, &t );
+
+	*result = t;
+}
+
 /*
 ================
 CG_TraceCapsule
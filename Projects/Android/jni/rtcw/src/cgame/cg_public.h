@@ -221,7 +221,8 @@ typedef enum {
 
 	CG_HAPTIC,
 	CG_HAPTICENABLE,
-	CG_HAPTICTRIGGER
+	CG_HAPTICTRIGGER,
+	CG_R_DRAWTEXT
 } cgameImport_t;
 
 
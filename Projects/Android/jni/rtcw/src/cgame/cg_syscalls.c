@@ -361,6 +361,11 @@ void    trap_R_DrawStretchPicGradient(  float x, float y, float w, float h,
 	syscall( CG_R_DRAWSTRETCHPIC_GRADIENT, PASSFLOAT( x ), PASSFLOAT( y ), PASSFLOAT( w ), PASSFLOAT( h ), PASSFLOAT( s1 ), PASSFLOAT( t1 ), PASSFLOAT( s2 ), PASSFLOAT( t2 ), hShader, gradientColor, gradientType  );
 }
 
+void    trap_R_DrawText( float x, float y, float xscale, float yscale, float adjust, float shadowX, float shadowY,
+						 const float *rgba, const char *text, int limit, const fontInfo_t *font ) {
+	syscall( CG_R_DRAWTEXT, PASSFLOAT( x ), PASSFLOAT( y ), PASSFLOAT( xscale ), PASSFLOAT( yscale ), PASSFLOAT( adjust ), PASSFLOAT( shadowX ), PASSFLOAT( shadowY ), rgba, text, limit, font );
+}
+
 void    trap_R_ModelBounds( clipHandle_t model, vec3_t mins, vec3_t maxs ) {
 	syscall( CG_R_MODELBOUNDS, model, mins, maxs );
 }
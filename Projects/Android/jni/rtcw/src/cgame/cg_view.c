@@ -1428,6 +1428,7 @@ void CG_DrawSkyBoxPortal( void ) {
 	cg.refdef.time = cg.time;
 
     VectorCopy(cg.refdefViewAngles, cg.refdef.viewangles);
+	VectorCopy( cg.refdef.vieworg, cg.refdef.headorg );
 
 	// draw the skybox
 	trap_R_RenderScene( &cg.refdef );
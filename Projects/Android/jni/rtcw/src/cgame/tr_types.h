@@ -227,6 +227,7 @@ typedef struct {
 	vec3_t viewaxis[3];             // transformation matrix
 	int stereoView;
 	float worldscale;
+	vec3_t headorg;                 // between the eyes, the same for both views of a stereo pair
 
 	int time;           // time in milliseconds for shader effects and other time dependent rendering issues
 	int rdflags;                    // RDF_NOWORLDMODEL, etc
@@ -47,6 +47,15 @@ If you have questions concerning this license or the applicable additional terms
 #include "client.h"
 //#include "snd_local.h"
 
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+#endif
+
+#ifdef __linux__
+#include <pthread.h>
+#define CIN_THREAD
+#endif
+
 #define MAXSIZE             8
 #define MINSIZE             4
 
@@ -154,6 +163,55 @@ static cinematics_t cin;
 static cin_cache cinTable[MAX_VIDEO_HANDLES];
 static int currentHandle = -1;
 static int CL_handle = -1;
+static int decodeHandle = -1;           // handle of the chunk being decoded, set by RoQDecodeChunk
+
+/*
+RoQ decode-ahead
+
+The stream is still parsed on the main thread, so sound, quad info and timing are handled as before,
+but codebook and VQ chunks are copied to a job ring and decoded in order by a worker thread.
+The main thread parses cinAhead frames before the one that is due, so the due frame normally is
+decoded already when it gets drawn. Finished frames are copied out of cin.linbuf (the decoder
+needs it for motion compensation) into a small frame ring.
+Without the worker, cinAhead is 0 and chunks are decoded inline right away.
+*/
+#define CIN_AHEAD           2
+#define CIN_JOBS            8                   // power of 2
+#define CIN_FRAMES          ( CIN_AHEAD + 2 )   // pending frames, the one shown and the one before
+#define CIN_FRAME_SIZE      ( DEFAULT_CIN_WIDTH * DEFAULT_CIN_HEIGHT * 4 )
+
+typedef struct {
+	int id;                 // ROQ_CODEBOOK or ROQ_QUAD_VQ
+	int handle;
+	long flags, f0, f1;
+	long numQuads;          // value when parsed, selects the decode buffer
+	int frame;              // frame ring slot of a VQ frame
+	int frameSize;
+	byte                *data;
+} cinJob_t;
+
+typedef struct {
+	int handle;
+	long numQuads;          // frame number, due when tfps is past it
+	int frame;
+	int job;
+} cinPending_t;
+
+static int cinAhead;
+static int cinJobsQueued, cinJobsDone;
+static cinJob_t cinJobs[CIN_JOBS];
+static byte cinJobData[CIN_JOBS][65536];
+static int cinNumFrames;
+static byte cinFrames[CIN_FRAMES][CIN_FRAME_SIZE];
+static cinPending_t cinPending[CIN_FRAMES];
+static int cinNumPending;
+
+#ifdef CIN_THREAD
+static qboolean cinThreadStarted;
+static pthread_t cinThread;
+static pthread_mutex_t cinLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cinCond = PTHREAD_COND_INITIALIZER;
+#endif
 
 void CIN_CloseAllVideos( void ) {
 	int i;
@@ -344,7 +402,14 @@ long RllDecodeStereoToMono( unsigned char *from,short *to,unsigned int size,char
 ******************************************************************************/
 
 static void move8_32( byte *src, byte *dst, int spl ) {
-#ifdef ARM
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	int i;
+	for ( i = 0; i < 8; i++ ) {
+		vst1q_u8( dst, vld1q_u8( src ) );
+		vst1q_u8( dst + 16, vld1q_u8( src + 16 ) );
+		dst += spl; src += spl;
+	}
+#elif defined( ARM )
 	int i;
 	for (i=0; i<8; i++) {
 		memcpy(dst, src, 32);
@@ -385,7 +450,13 @@ static void move8_32( byte *src, byte *dst, int spl ) {
 ******************************************************************************/
 
 static void move4_32( byte *src, byte *dst, int spl  ) {
-#ifdef ARM
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	int i;
+	for ( i = 0; i < 4; i++ ) {
+		vst1q_u8( dst, vld1q_u8( src ) );
+		dst += spl; src += spl;
+	}
+#elif defined( ARM )
 	int i;
 	for (i=0; i<4; i++) {
 		memcpy(dst, src, 16);
@@ -418,7 +489,14 @@ static void move4_32( byte *src, byte *dst, int spl  ) {
 ******************************************************************************/
 
 static void blit8_32( byte *src, byte *dst, int spl  ) {
-#ifdef ARM
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	int i;
+	for ( i = 0; i < 8; i++ ) {
+		vst1q_u8( dst, vld1q_u8( src ) );
+		vst1q_u8( dst + 16, vld1q_u8( src + 16 ) );
+		dst += spl; src += 32;
+	}
+#elif defined( ARM )
 	int i;
 	for (i=0; i<8; i++) {
 		memcpy(dst, src, 32);
@@ -459,7 +537,13 @@ static void blit8_32( byte *src, byte *dst, int spl  ) {
 ******************************************************************************/
 #define movs double
 static void blit4_32( byte *src, byte *dst, int spl  ) {
-#ifdef ARM
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	int i;
+	for ( i = 0; i < 4; i++ ) {
+		vst1q_u8( dst, vld1q_u8( src ) );
+		dst += spl; src += 16;
+	}
+#elif defined( ARM )
 	int i;
 	for (i=0; i<4; i++) {
 		memcpy(dst, src, 16);
@@ -528,7 +612,7 @@ static void blitVQQuad32fs( byte **status, unsigned char *data ) {
 	celdata = 0;
 	index   = 0;
 
-	spl = cinTable[currentHandle].samplesPerLine;
+	spl = cinTable[decodeHandle].samplesPerLine;
 
 	do {
 		if ( !newd ) {
@@ -767,6 +851,50 @@ static unsigned int yuv_to_rgb24( long y, long u, long v ) {
 }
 #endif
 
+/******************************************************************************
+*
+* Function:		yuv_cell_rgb24
+*
+* Description:	converts 4 luma samples sharing the same chroma, as found in
+*				a codebook cell
+*
+******************************************************************************/
+#if ( defined( __ARM_NEON ) || defined( __ARM_NEON__ ) ) && !defined( __MACOS__ )
+
+static void yuv_cell_rgb24( unsigned int *out, long y0, long y1, long y2, long y3, long u, long v ) {
+	const int32_t ys[4] = { y0, y1, y2, y3 };
+	const int32x4_t zero = vdupq_n_s32( 0 ), full = vdupq_n_s32( 255 );
+	int32x4_t yy, r, g, b;
+	uint32x4_t pix;
+
+	// ROQ_YY_tab[y]
+	yy = vld1q_s32( ys );
+	yy = vorrq_s32( vshlq_n_s32( yy, 6 ), vshrq_n_s32( yy, 2 ) );
+
+	r = vshrq_n_s32( vaddq_s32( yy, vdupq_n_s32( ROQ_VR_tab[v] ) ), 6 );
+	g = vshrq_n_s32( vaddq_s32( yy, vdupq_n_s32( ROQ_UG_tab[u] + ROQ_VG_tab[v] ) ), 6 );
+	b = vshrq_n_s32( vaddq_s32( yy, vdupq_n_s32( ROQ_UB_tab[u] ) ), 6 );
+	r = vminq_s32( vmaxq_s32( r, zero ), full );
+	g = vminq_s32( vmaxq_s32( g, zero ), full );
+	b = vminq_s32( vmaxq_s32( b, zero ), full );
+
+	pix = vorrq_u32( vreinterpretq_u32_s32( r ), vshlq_n_u32( vreinterpretq_u32_s32( g ), 8 ) );
+	pix = vorrq_u32( pix, vshlq_n_u32( vreinterpretq_u32_s32( b ), 16 ) );
+	pix = vorrq_u32( pix, vdupq_n_u32( 0xff000000 ) );
+	vst1q_u32( out, pix );
+}
+
+#else
+
+static void yuv_cell_rgb24( unsigned int *out, long y0, long y1, long y2, long y3, long u, long v ) {
+	out[0] = yuv_to_rgb24( y0, u, v );
+	out[1] = yuv_to_rgb24( y1, u, v );
+	out[2] = yuv_to_rgb24( y2, u, v );
+	out[3] = yuv_to_rgb24( y3, u, v );
+}
+
+#endif
+
 /******************************************************************************
 *
 * Function:
@@ -796,12 +924,12 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 
 	bptr = (unsigned short *)vq2;
 
-	if ( !cinTable[currentHandle].half ) {
-		if ( !cinTable[currentHandle].smootheddouble ) {
+	if ( !cinTable[decodeHandle].half ) {
+		if ( !cinTable[decodeHandle].smootheddouble ) {
 //
 // normal height
 //
-			if ( cinTable[currentHandle].samplesPerPixel == 2 ) {
+			if ( cinTable[decodeHandle].samplesPerPixel == 2 ) {
 				for ( i = 0; i < two; i++ ) {
 					y0 = (long)*input++;
 					y1 = (long)*input++;
@@ -824,7 +952,7 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 					for ( j = 0; j < 2; j++ )
 						VQ2TO4( aptr,bptr,cptr,dptr );
 				}
-			} else if ( cinTable[currentHandle].samplesPerPixel == 4 ) {
+			} else if ( cinTable[decodeHandle].samplesPerPixel == 4 ) {
 				ibptr = (unsigned int *)bptr;
 				for ( i = 0; i < two; i++ ) {
 					y0 = (long)*input++;
@@ -833,10 +961,8 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 					y3 = (long)*input++;
 					cr = (long)*input++;
 					cb = (long)*input++;
-					*ibptr++ = yuv_to_rgb24( y0, cr, cb );
-					*ibptr++ = yuv_to_rgb24( y1, cr, cb );
-					*ibptr++ = yuv_to_rgb24( y2, cr, cb );
-					*ibptr++ = yuv_to_rgb24( y3, cr, cb );
+					yuv_cell_rgb24( ibptr, y0, y1, y2, y3, cr, cb );
+					ibptr += 4;
 				}
 
 				icptr = (unsigned int *)vq4;
@@ -848,13 +974,13 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 					for ( j = 0; j < 2; j++ )
 						VQ2TO4( iaptr, ibptr, icptr, idptr );
 				}
-			} else if ( cinTable[currentHandle].samplesPerPixel == 1 ) {
+			} else if ( cinTable[decodeHandle].samplesPerPixel == 1 ) {
 				bbptr = (byte *)bptr;
 				for ( i = 0; i < two; i++ ) {
-					*bbptr++ = cinTable[currentHandle].gray[*input++];
-					*bbptr++ = cinTable[currentHandle].gray[*input++];
-					*bbptr++ = cinTable[currentHandle].gray[*input++];
-					*bbptr++ = cinTable[currentHandle].gray[*input]; input += 3;
+					*bbptr++ = cinTable[decodeHandle].gray[*input++];
+					*bbptr++ = cinTable[decodeHandle].gray[*input++];
+					*bbptr++ = cinTable[decodeHandle].gray[*input++];
+					*bbptr++ = cinTable[decodeHandle].gray[*input]; input += 3;
 				}
 
 				bcptr = (byte *)vq4;
@@ -871,7 +997,7 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 //
 // double height, smoothed
 //
-			if ( cinTable[currentHandle].samplesPerPixel == 2 ) {
+			if ( cinTable[decodeHandle].samplesPerPixel == 2 ) {
 				for ( i = 0; i < two; i++ ) {
 					y0 = (long)*input++;
 					y1 = (long)*input++;
@@ -900,7 +1026,7 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 						VQ2TO4( aptr,bptr,cptr,dptr );
 					}
 				}
-			} else if ( cinTable[currentHandle].samplesPerPixel == 4 ) {
+			} else if ( cinTable[decodeHandle].samplesPerPixel == 4 ) {
 				ibptr = (unsigned int *)bptr;
 				for ( i = 0; i < two; i++ ) {
 					y0 = (long)*input++;
@@ -909,14 +1035,9 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 					y3 = (long)*input++;
 					cr = (long)*input++;
 					cb = (long)*input++;
-					*ibptr++ = yuv_to_rgb24( y0, cr, cb );
-					*ibptr++ = yuv_to_rgb24( y1, cr, cb );
-					*ibptr++ = yuv_to_rgb24( ( ( y0 * 3 ) + y2 ) / 4, cr, cb );
-					*ibptr++ = yuv_to_rgb24( ( ( y1 * 3 ) + y3 ) / 4, cr, cb );
-					*ibptr++ = yuv_to_rgb24( ( y0 + ( y2 * 3 ) ) / 4, cr, cb );
-					*ibptr++ = yuv_to_rgb24( ( y1 + ( y3 * 3 ) ) / 4, cr, cb );
-					*ibptr++ = yuv_to_rgb24( y2, cr, cb );
-					*ibptr++ = yuv_to_rgb24( y3, cr, cb );
+					yuv_cell_rgb24( ibptr, y0, y1, ( ( y0 * 3 ) + y2 ) / 4, ( ( y1 * 3 ) + y3 ) / 4, cr, cb );
+					yuv_cell_rgb24( ibptr + 4, ( y0 + ( y2 * 3 ) ) / 4, ( y1 + ( y3 * 3 ) ) / 4, y2, y3, cr, cb );
+					ibptr += 8;
 				}
 
 				icptr = (unsigned int *)vq4;
@@ -930,21 +1051,21 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 						VQ2TO4( iaptr, ibptr, icptr, idptr );
 					}
 				}
-			} else if ( cinTable[currentHandle].samplesPerPixel == 1 ) {
+			} else if ( cinTable[decodeHandle].samplesPerPixel == 1 ) {
 				bbptr = (byte *)bptr;
 				for ( i = 0; i < two; i++ ) {
 					y0 = (long)*input++;
 					y1 = (long)*input++;
 					y2 = (long)*input++;
 					y3 = (long)*input; input += 3;
-					*bbptr++ = cinTable[currentHandle].gray[y0];
-					*bbptr++ = cinTable[currentHandle].gray[y1];
-					*bbptr++ = cinTable[currentHandle].gray[( ( y0 * 3 ) + y2 ) / 4];
-					*bbptr++ = cinTable[currentHandle].gray[( ( y1 * 3 ) + y3 ) / 4];
-					*bbptr++ = cinTable[currentHandle].gray[( y0 + ( y2 * 3 ) ) / 4];
-					*bbptr++ = cinTable[currentHandle].gray[( y1 + ( y3 * 3 ) ) / 4];
-					*bbptr++ = cinTable[currentHandle].gray[y2];
-					*bbptr++ = cinTable[currentHandle].gray[y3];
+					*bbptr++ = cinTable[decodeHandle].gray[y0];
+					*bbptr++ = cinTable[decodeHandle].gray[y1];
+					*bbptr++ = cinTable[decodeHandle].gray[( ( y0 * 3 ) + y2 ) / 4];
+					*bbptr++ = cinTable[decodeHandle].gray[( ( y1 * 3 ) + y3 ) / 4];
+					*bbptr++ = cinTable[decodeHandle].gray[( y0 + ( y2 * 3 ) ) / 4];
+					*bbptr++ = cinTable[decodeHandle].gray[( y1 + ( y3 * 3 ) ) / 4];
+					*bbptr++ = cinTable[decodeHandle].gray[y2];
+					*bbptr++ = cinTable[decodeHandle].gray[y3];
 				}
 
 				bcptr = (byte *)vq4;
@@ -964,7 +1085,7 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 //
 // 1/4 screen
 //
-		if ( cinTable[currentHandle].samplesPerPixel == 2 ) {
+		if ( cinTable[decodeHandle].samplesPerPixel == 2 ) {
 			for ( i = 0; i < two; i++ ) {
 				y0 = (long)*input; input += 2;
 				y2 = (long)*input; input += 2;
@@ -984,12 +1105,12 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 					VQ2TO2( aptr,bptr,cptr,dptr );
 				}
 			}
-		} else if ( cinTable[currentHandle].samplesPerPixel == 1 ) {
+		} else if ( cinTable[decodeHandle].samplesPerPixel == 1 ) {
 			bbptr = (byte *)bptr;
 
 			for ( i = 0; i < two; i++ ) {
-				*bbptr++ = cinTable[currentHandle].gray[*input]; input += 2;
-				*bbptr++ = cinTable[currentHandle].gray[*input]; input += 4;
+				*bbptr++ = cinTable[decodeHandle].gray[*input]; input += 2;
+				*bbptr++ = cinTable[decodeHandle].gray[*input]; input += 4;
 			}
 
 			bcptr = (byte *)vq4;
@@ -1002,7 +1123,7 @@ static void decodeCodeBook( byte *input, unsigned short roq_flags ) {
 					VQ2TO2( baptr,bbptr,bcptr,bdptr );
 				}
 			}
-		} else if ( cinTable[currentHandle].samplesPerPixel == 4 ) {
+		} else if ( cinTable[decodeHandle].samplesPerPixel == 4 ) {
 			ibptr = (unsigned int *) bptr;
 			for ( i = 0; i < two; i++ ) {
 				y0 = (long)*input; input += 2;
@@ -1181,8 +1302,8 @@ static void readQuadInfo( byte *qData ) {
 static void RoQPrepMcomp( long xoff, long yoff ) {
 	signed long i, j, x, y, temp, temp2;
 
-	i = cinTable[currentHandle].samplesPerLine; j = cinTable[currentHandle].samplesPerPixel;
-	if ( cinTable[currentHandle].xsize == ( cinTable[currentHandle].ysize * 4 ) && !cinTable[currentHandle].half ) {
+	i = cinTable[decodeHandle].samplesPerLine; j = cinTable[decodeHandle].samplesPerPixel;
+	if ( cinTable[decodeHandle].xsize == ( cinTable[decodeHandle].ysize * 4 ) && !cinTable[decodeHandle].half ) {
 		j = j + j; i = i + i;
 	}
 
@@ -1190,11 +1311,239 @@ static void RoQPrepMcomp( long xoff, long yoff ) {
 		temp2 = ( y + yoff - 8 ) * i;
 		for ( x = 0; x < 16; x++ ) {
 			temp = ( x + xoff - 8 ) * j;
-			cin.mcomp[( x * 16 ) + y] = cinTable[currentHandle].normalBuffer0 - ( temp2 + temp );
+			cin.mcomp[( x * 16 ) + y] = cinTable[decodeHandle].normalBuffer0 - ( temp2 + temp );
 		}
 	}
 }
 
+/******************************************************************************
+*
+* Function:		RoQDecodeChunk
+*
+* Description:	decodes a codebook or VQ chunk, returns the decoded frame
+*				for VQ chunks
+*
+******************************************************************************/
+
+static byte *RoQDecodeChunk( cinJob_t *job ) {
+	byte *buf;
+
+	decodeHandle = job->handle;
+	if ( job->id == ROQ_CODEBOOK ) {
+		decodeCodeBook( job->data, (unsigned short)job->flags );
+		return NULL;
+	}
+
+	if ( ( job->numQuads & 1 ) ) {
+		cinTable[decodeHandle].normalBuffer0 = cinTable[decodeHandle].t[1];
+		RoQPrepMcomp( job->f0, job->f1 );
+		cinTable[decodeHandle].VQ1( (byte *)cin.qStatus[1], job->data );
+		buf = cin.linbuf + cinTable[decodeHandle].screenDelta;
+	} else {
+		cinTable[decodeHandle].normalBuffer0 = cinTable[decodeHandle].t[0];
+		RoQPrepMcomp( job->f0, job->f1 );
+		cinTable[decodeHandle].VQ0( (byte *)cin.qStatus[0], job->data );
+		buf = cin.linbuf;
+	}
+	if ( job->numQuads == 0 ) {          // first frame
+		Com_Memcpy( cin.linbuf + cinTable[decodeHandle].screenDelta, cin.linbuf, cinTable[decodeHandle].samplesPerLine * cinTable[decodeHandle].ysize );
+	}
+	return buf;
+}
+
+#ifdef CIN_THREAD
+/******************************************************************************
+*
+* Function:		CIN_DecodeThread
+*
+* Description:	decodes the queued chunks in order, VQ frames are copied to
+*				their slot of the frame ring
+*
+******************************************************************************/
+
+static void *CIN_DecodeThread( void *unused ) {
+	cinJob_t *job;
+	byte *buf;
+
+	pthread_mutex_lock( &cinLock );
+	while ( 1 ) {
+		while ( cinJobsDone == cinJobsQueued ) {
+			pthread_cond_wait( &cinCond, &cinLock );
+		}
+		job = &cinJobs[cinJobsDone & ( CIN_JOBS - 1 )];
+		pthread_mutex_unlock( &cinLock );
+
+		buf = RoQDecodeChunk( job );
+		if ( buf ) {
+			Com_Memcpy( cinFrames[job->frame], buf, job->frameSize );
+		}
+
+		pthread_mutex_lock( &cinLock );
+		cinJobsDone++;
+		pthread_cond_broadcast( &cinCond );
+	}
+	return NULL;
+}
+#endif
+
+/******************************************************************************
+*
+* Function:		CIN_WaitJobs
+*
+* Description:	waits until the worker has decoded the first count jobs
+*
+******************************************************************************/
+
+static void CIN_WaitJobs( int count ) {
+#ifdef CIN_THREAD
+	pthread_mutex_lock( &cinLock );
+	while ( cinJobsDone - count < 0 ) {
+		pthread_cond_wait( &cinCond, &cinLock );
+	}
+	pthread_mutex_unlock( &cinLock );
+#endif
+}
+
+/******************************************************************************
+*
+* Function:		CIN_PresentFrames
+*
+* Description:	shows the last decoded-ahead frame that is due (all of them
+*				if flush), the ones before it are skipped. Frames also are
+*				shown early when the ring is full (sound catching up)
+*
+******************************************************************************/
+
+static void CIN_PresentFrames( qboolean flush ) {
+	cinPending_t *p;
+	int i;
+
+	for ( i = 0; i < cinNumPending; i++ ) {
+		if ( !flush && cinPending[i].numQuads >= cinTable[cinPending[i].handle].tfps ) {
+			break;
+		}
+	}
+	if ( cinNumPending - i > CIN_FRAMES - 2 ) {
+		i = cinNumPending - ( CIN_FRAMES - 2 );
+	}
+	if ( !i ) {
+		return;
+	}
+
+	p = &cinPending[i - 1];
+	CIN_WaitJobs( p->job + 1 );
+	cinTable[p->handle].buf = cinFrames[p->frame];
+	cinTable[p->handle].dirty = qtrue;
+
+	cinNumPending -= i;
+	memmove( cinPending, cinPending + i, cinNumPending * sizeof( cinPending[0] ) );
+}
+
+/******************************************************************************
+*
+* Function:		CIN_FinishDecode
+*
+* Description:	waits for the worker to be idle and shows its last frame,
+*				decoder state can be changed after that
+*
+******************************************************************************/
+
+static void CIN_FinishDecode( void ) {
+	CIN_WaitJobs( cinJobsQueued );
+	CIN_PresentFrames( qtrue );
+}
+
+/******************************************************************************
+*
+* Function:		CIN_QueueChunk
+*
+* Description:	hands a codebook or VQ chunk of the current handle to the
+*				decoder
+*
+******************************************************************************/
+
+static void CIN_QueueChunk( byte *data ) {
+	cinJob_t *job, inl;
+
+	if ( cinAhead ) {
+		// wait for a free slot in the job ring
+		CIN_WaitJobs( cinJobsQueued - CIN_JOBS + 1 );
+		job = &cinJobs[cinJobsQueued & ( CIN_JOBS - 1 )];
+	} else {
+		job = &inl;
+	}
+	job->id = cinTable[currentHandle].roq_id;
+	job->handle = currentHandle;
+	job->flags = cinTable[currentHandle].roq_flags;
+	job->f0 = cinTable[currentHandle].roqF0;
+	job->f1 = cinTable[currentHandle].roqF1;
+	job->numQuads = cinTable[currentHandle].numQuads;
+
+	if ( !cinAhead ) {
+		job->data = data;
+		job->frame = 0;
+		job->frameSize = 0;
+		data = RoQDecodeChunk( job );
+		if ( data ) {
+			cinTable[currentHandle].buf = data;
+			cinTable[currentHandle].dirty = qtrue;
+		}
+		return;
+	}
+
+	if ( job->id == ROQ_QUAD_VQ ) {
+		// show what is due, that also makes room in the frame ring
+		CIN_PresentFrames( qfalse );
+		job->frame = cinNumFrames++ % CIN_FRAMES;
+		job->frameSize = cinTable[currentHandle].samplesPerLine * cinTable[currentHandle].ysize;
+		if ( job->frameSize > CIN_FRAME_SIZE ) {
+			job->frameSize = CIN_FRAME_SIZE;
+		}
+		cinPending[cinNumPending].handle = currentHandle;
+		cinPending[cinNumPending].numQuads = job->numQuads;
+		cinPending[cinNumPending].frame = job->frame;
+		cinPending[cinNumPending].job = cinJobsQueued;
+		cinNumPending++;
+	}
+
+	job->data = cinJobData[cinJobsQueued & ( CIN_JOBS - 1 )];
+	Com_Memcpy( job->data, data, cinTable[currentHandle].RoQFrameSize );
+
+#ifdef CIN_THREAD
+	pthread_mutex_lock( &cinLock );
+	cinJobsQueued++;
+	pthread_cond_broadcast( &cinCond );
+	pthread_mutex_unlock( &cinLock );
+#endif
+}
+
+/******************************************************************************
+*
+* Function:		CIN_StartDecodeAhead
+*
+* Description:	sets up the decode-ahead for a new cinematic
+*
+******************************************************************************/
+
+static void CIN_StartDecodeAhead( void ) {
+	CIN_FinishDecode();
+	cinAhead = 0;
+#ifdef CIN_THREAD
+	if ( !cl_cinThread->integer ) {
+		return;
+	}
+	if ( !cinThreadStarted ) {
+		if ( pthread_create( &cinThread, NULL, CIN_DecodeThread, NULL ) ) {
+			Com_Printf( "WARNING: cannot start the cinematic decode thread\n" );
+			Cvar_Set( "cl_cinThread", "0" );
+			return;
+		}
+		cinThreadStarted = qtrue;
+	}
+	cinAhead = CIN_AHEAD;
+#endif
+}
+
 /******************************************************************************
 *
 * Function:
@@ -1244,6 +1593,7 @@ static void RoQReset() {
 		return;
 	}
 
+	CIN_FinishDecode();
 	Sys_EndStreamedFile( cinTable[currentHandle].iFile );
 
 	// DHM - Properly close file so we don't run out of handles
@@ -1297,25 +1647,11 @@ redump:
 	switch ( cinTable[currentHandle].roq_id )
 	{
 	case    ROQ_QUAD_VQ:
-		if ( ( cinTable[currentHandle].numQuads & 1 ) ) {
-			cinTable[currentHandle].normalBuffer0 = cinTable[currentHandle].t[1];
-			RoQPrepMcomp( cinTable[currentHandle].roqF0, cinTable[currentHandle].roqF1 );
-			cinTable[currentHandle].VQ1( (byte *)cin.qStatus[1], framedata );
-			cinTable[currentHandle].buf =   cin.linbuf + cinTable[currentHandle].screenDelta;
-		} else {
-			cinTable[currentHandle].normalBuffer0 = cinTable[currentHandle].t[0];
-			RoQPrepMcomp( cinTable[currentHandle].roqF0, cinTable[currentHandle].roqF1 );
-			cinTable[currentHandle].VQ0( (byte *)cin.qStatus[0], framedata );
-			cinTable[currentHandle].buf =   cin.linbuf;
-		}
-		if ( cinTable[currentHandle].numQuads == 0 ) {          // first frame
-			Com_Memcpy( cin.linbuf + cinTable[currentHandle].screenDelta, cin.linbuf, cinTable[currentHandle].samplesPerLine * cinTable[currentHandle].ysize );
-		}
+		CIN_QueueChunk( framedata );
 		cinTable[currentHandle].numQuads++;
-		cinTable[currentHandle].dirty = qtrue;
 		break;
 	case    ROQ_CODEBOOK:
-		decodeCodeBook( framedata, (unsigned short)cinTable[currentHandle].roq_flags );
+		CIN_QueueChunk( framedata );
 		break;
 	case    ZA_SOUND_MONO:
 		if ( !cinTable[currentHandle].silent ) {
@@ -1339,6 +1675,7 @@ redump:
 		break;
 	case    ROQ_QUAD_INFO:
 		if ( cinTable[currentHandle].numQuads == -1 ) {
+			CIN_FinishDecode();
 			readQuadInfo( framedata );
 			setupQuad( 0, 0 );
 			// we need to use CL_ScaledMilliseconds because of the smp mode calls from the renderer
@@ -1453,6 +1790,7 @@ static void RoQ_init( void ) {
 static void RoQShutdown( void ) {
 	const char *s;
 
+	CIN_FinishDecode();
 	if ( !cinTable[currentHandle].buf ) {
 		return;
 	}
@@ -1500,6 +1838,7 @@ e_status CIN_StopCinematic( int handle ) {
 
 	Com_DPrintf( "trFMV::stop(), closing %s\n", cinTable[currentHandle].fileName );
 
+	CIN_FinishDecode();
 	if ( !cinTable[currentHandle].buf ) {
 		return FMV_EOF;
 	}
@@ -1568,8 +1907,9 @@ e_status CIN_RunCinematic( int handle ) {
 	// we need to use CL_ScaledMilliseconds because of the smp mode calls from the renderer
 	cinTable[currentHandle].tfps = ( ( ( CL_ScaledMilliseconds() - cinTable[currentHandle].startTime ) * cinTable[currentHandle].roqFPS ) / 1000 );
 
+	// parse cinAhead frames before the due one, so the worker can decode them in time
 	start = cinTable[currentHandle].startTime;
-	while ( ( cinTable[currentHandle].tfps != cinTable[currentHandle].numQuads )
+	while ( ( cinTable[currentHandle].numQuads < cinTable[currentHandle].tfps + cinAhead )
 			&& cinTable[currentHandle].status == FMV_PLAY )
 	{
 		RoQInterrupt();
@@ -1595,6 +1935,8 @@ e_status CIN_RunCinematic( int handle ) {
 
 //----(SA)	end
 
+	CIN_PresentFrames( cinTable[currentHandle].status != FMV_PLAY );
+
 	cinTable[currentHandle].lastTime = thisTime;
 
 	if ( cinTable[currentHandle].status == FMV_LOOPED ) {
@@ -1643,6 +1985,7 @@ int CIN_PlayCinematic( const char *arg, int x, int y, int w, int h, int systemBi
 
 	Com_DPrintf( "SCR_PlayCinematic( %s )\n", arg );
 
+	CIN_StartDecodeAhead();
 	Com_Memset( &cin, 0, sizeof( cinematics_t ) );
 	currentHandle = CIN_HandleForVideo();
 
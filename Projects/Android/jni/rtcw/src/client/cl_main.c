@@ -72,6 +72,7 @@ cvar_t  *cl_motdString;
 cvar_t  *cl_allowDownload;
 cvar_t  *cl_conXOffset;
 cvar_t  *cl_inGameVideo;
+cvar_t  *cl_cinThread;
 
 cvar_t  *cl_serverStatusResendTime;
 cvar_t  *cl_trn;
@@ -2511,6 +2512,7 @@ void CL_Init( void ) {
 
 	cl_conXOffset = Cvar_Get( "cl_conXOffset", "0", 0 );
 	cl_inGameVideo = Cvar_Get( "r_inGameVideo", "1", CVAR_ARCHIVE );
+	cl_cinThread = Cvar_Get( "cl_cinThread", "1", CVAR_ARCHIVE );           // decode RoQ frames ahead on a worker thread
 
 	cl_serverStatusResendTime = Cvar_Get( "cl_serverStatusResendTime", "750", 0 );
 
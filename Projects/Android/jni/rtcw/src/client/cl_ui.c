@@ -927,6 +927,10 @@ int CL_UISystemCalls( int *args ) {
 		re.DrawStretchPic( VMF( 1 ), VMF( 2 ), VMF( 3 ), VMF( 4 ), VMF( 5 ), VMF( 6 ), VMF( 7 ), VMF( 8 ), args[9] );
 		return 0;
 
+	case UI_R_DRAWTEXT:
+		re.DrawText( VMF( 1 ), VMF( 2 ), VMF( 3 ), VMF( 4 ), VMF( 5 ), VMF( 6 ), VMF( 7 ), VMA( 8 ), VMA( 9 ), args[10], VMA( 11 ) );
+		return 0;
+
 	case UI_R_MODELBOUNDS:
 		re.ModelBounds( args[1], VMA( 2 ), VMA( 3 ) );
 		return 0;
@@ -374,6 +374,7 @@ extern cvar_t  *cl_activeAction;
 extern cvar_t  *cl_allowDownload;
 extern cvar_t  *cl_conXOffset;
 extern cvar_t  *cl_inGameVideo;
+extern cvar_t  *cl_cinThread;
 
 extern cvar_t  *cl_missionStats;
 extern cvar_t  *cl_waitForFire;
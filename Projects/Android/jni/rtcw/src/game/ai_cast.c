@@ -80,6 +80,7 @@ float aicast_skillscale;
 vmCvar_t aicast_debug;
 vmCvar_t aicast_debugname;
 vmCvar_t aicast_scripts;
+vmCvar_t aicast_savegameLoading;
 
 // string versions of the attributes used for per-level, per-character definitions
 char *castAttributeStrings[] =
@@ -480,6 +481,8 @@ void AICast_Init( void ) {
 	trap_Cvar_Register( &aicast_debug, "aicast_debug", "0", 0 );
 	trap_Cvar_Register( &aicast_debugname, "aicast_debugname", "", 0 );
 	trap_Cvar_Register( &aicast_scripts, "aicast_scripts", "1", 0 );
+	// registered here so the per-frame checks don't have to look it up by name
+	trap_Cvar_Register( &aicast_savegameLoading, "savegame_loading", "0", CVAR_ROM );
 
 	// (aicast_thinktime / sv_fps) * aicast_maxthink = number of cast's to think between each aicast frame
 	// so..
@@ -495,6 +498,8 @@ void AICast_Init( void ) {
 
 	aicast_maxclients = trap_Cvar_VariableIntegerValue( "sv_maxclients" );
 
+	AICast_ClearSightCache();
+
 	aicast_skillscale = (float)trap_Cvar_VariableIntegerValue( "g_gameSkill" ) / (float)GSKILL_MAX;
 
 	caststates = G_Alloc( aicast_maxclients * sizeof( cast_state_t ) );
@@ -603,6 +603,7 @@ extern float aicast_skillscale;
 extern vmCvar_t aicast_debug;
 extern vmCvar_t aicast_debugname;
 extern vmCvar_t aicast_scripts;
+extern vmCvar_t aicast_savegameLoading;
 //
 //
 // procedure defines
@@ -618,6 +619,8 @@ void    AICast_CheckLevelAttributes( cast_state_t *cs, gentity_t *ent, char **pp
 //
 // ai_cast_sight.c
 void    AICast_SightUpdate( int numchecks );
+void    AICast_ClearSightCache( void );
+void    AICast_SightCacheMoverChanged( void );
 qboolean AICast_VisibleFromPos( vec3_t srcpos, int srcnum,
 								vec3_t destpos, int destnum, qboolean updateVisPos );
 void    AICast_UpdateVisibility( gentity_t *srcent, gentity_t *destent, qboolean shareVis, qboolean directview );
@@ -721,6 +724,8 @@ void AICast_Think( int client, float thinktime );
 void AICast_UpdateInput( cast_state_t *cs, int time );
 void AICast_InputToUserCommand( cast_state_t * cs, bot_input_t * bi, usercmd_t * ucmd, int delta_angles[3] );
 void AICast_PredictMovement( cast_state_t *cs, int numframes, float frametime, aicast_predictmove_t *move, usercmd_t *ucmd, int checkHitEnt );
+void AICast_PredictCacheStats( void );
+void AICast_PredictCacheScope( qboolean open );
 void AICast_Blocked( cast_state_t *cs, bot_moveresult_t *moveresult, int activate, bot_goal_t *goal );
 qboolean AICast_RequestCrouchAttack( cast_state_t *cs, vec3_t org, float time );
 qboolean AICast_GetAvoid( cast_state_t *cs, bot_goal_t *goal, vec3_t outpos, qboolean reverse, int blockEnt );
@@ -76,6 +76,7 @@ void AICast_RecordScriptSound( int client );
 void AICast_UpdateVisibility( gentity_t *srcent, gentity_t *destent, qboolean shareVis, qboolean directview );
 void AICast_ProcessBullet( gentity_t *attacker, vec3_t start, vec3_t end );
 void AICast_AudibleEvent( int srcnum, vec3_t pos, float range );
+void AICast_SightCacheMoverChanged( void );
 
 //----(SA)	added
 int AICast_PlayTime( int entnum );
@@ -377,11 +377,14 @@ void AICast_ScriptLoad( void ) {
 		return;
 	}
 
-	level.scriptAI = G_Alloc( len );
+	level.scriptAI = G_Alloc( len + 1 );
 	trap_FS_Read( level.scriptAI, len, f );
+	level.scriptAI[len] = 0;
 
 	trap_FS_FCloseFile( f );
 
+	level.scriptAIIndex = G_Script_BuildIndex( level.scriptAI, "AICast_ScriptParse" );
+
 	return;
 }
 
@@ -422,10 +425,13 @@ void AICast_ScriptParse( cast_state_t *cs ) {
 	buildScript = trap_Cvar_VariableIntegerValue( "com_buildScript" );
 	buildScript = qtrue;
 
-	pScript = level.scriptAI;
-	wantName = qtrue;
-	inScript = qfalse;
-	COM_BeginParseSession( "AICast_ScriptParse" );
+	// go straight to our own script
+	pScript = G_Script_FindBlock( level.scriptAIIndex, ent->aiName, "AICast_ScriptParse" );
+	if ( !pScript ) {
+		return;
+	}
+	wantName = qfalse;
+	inScript = qtrue;
 	bracketLevel = 0;
 	numEventItems = 0;
 
@@ -61,6 +61,112 @@ static float aiStateFovScales[] =
 orientation_t clientHeadTags[MAX_CLIENTS];
 int clientHeadTagTimes[MAX_CLIENTS];
 
+/*
+Sight cache.
+
+A visibility check between two characters that haven't moved since the last check
+will get the same answer, so remember the result of the traces for a short while.
+Only the timeslice/player sighting checks use this, reaction times still run off
+the vislist timestamps which are updated as normal.
+There is one entry for each source/destination pair of client slots.
+A mover changing state or travelling, or a solid brush being removed, can open or
+close the line of sight, so that throws away every cached result.
+*/
+#define SIGHTCACHE_MAXAGE       250     // msec before a result must be traced again
+#define SIGHTCACHE_MOVE_EPSILON 1.0     // distance either end can move before the result is invalid
+#define SIGHTCACHE_STATS_TIME   10000   // msec between hit/miss reports with aicast_debug set
+
+typedef struct {
+	int time;                   // level.time of the trace, 0 if unused
+	int moverCount;             // sightCacheMoverCount at the time of the trace
+	vec3_t srcpos, destpos;
+	int srcviewheight;
+	float destheight;           // crouching changes the bounding box
+	qboolean visible;
+} aicast_sightcache_t;
+
+static aicast_sightcache_t *sightCache;    // aicast_maxclients * aicast_maxclients entries
+static int sightCacheMoverCount;
+static int sightCacheHits, sightCacheMisses, sightCacheStatsTime;
+
+/*
+==============
+AICast_ClearSightCache
+
+Called by AICast_Init once aicast_maxclients is known
+==============
+*/
+void AICast_ClearSightCache( void ) {
+	sightCache = G_Alloc( aicast_maxclients * aicast_maxclients * sizeof( aicast_sightcache_t ) );
+	memset( sightCache, 0, aicast_maxclients * aicast_maxclients * sizeof( aicast_sightcache_t ) );
+	sightCacheMoverCount = 0;
+	sightCacheHits = 0;
+	sightCacheMisses = 0;
+	sightCacheStatsTime = 0;
+}
+
+/*
+==============
+AICast_SightCacheMoverChanged
+
+Called when a mover starts, stops or is travelling, or a solid brush entity is
+removed, invalidates all cached sightings
+==============
+*/
+void AICast_SightCacheMoverChanged( void ) {
+	sightCacheMoverCount++;
+}
+
+/*
+==============
+AICast_SightCacheStats
+==============
+*/
+static void AICast_SightCacheStats( void ) {
+	if ( sightCacheStatsTime > level.time ) {
+		sightCacheStatsTime = 0;    // loadgame or map_restart
+	}
+	if ( level.time - sightCacheStatsTime < SIGHTCACHE_STATS_TIME ) {
+		return;
+	}
+	if ( sightCacheHits + sightCacheMisses ) {
+		AICast_Printf( AICAST_PRT_DEBUG, "sight cache: %i hits, %i misses (%i%%)\n",
+					   sightCacheHits, sightCacheMisses, sightCacheHits * 100 / ( sightCacheHits + sightCacheMisses ) );
+	}
+	sightCacheHits = 0;
+	sightCacheMisses = 0;
+	sightCacheStatsTime = level.time;
+}
+
+/*
+==============
+AICast_SightCacheValid
+==============
+*/
+static qboolean AICast_SightCacheValid( aicast_sightcache_t *sc, vec3_t srcpos, int srcviewheight,
+										vec3_t destpos, float destheight ) {
+	if ( !sc->time ) {
+		return qfalse;
+	}
+	if ( sc->moverCount != sightCacheMoverCount ) {
+		return qfalse;
+	}
+	// a loadgame or map_restart can send level.time backwards
+	if ( sc->time > level.time || sc->time < level.time - SIGHTCACHE_MAXAGE ) {
+		return qfalse;
+	}
+	if ( sc->srcviewheight != srcviewheight || sc->destheight != destheight ) {
+		return qfalse;
+	}
+	if ( DistanceSquared( sc->srcpos, srcpos ) > SIGHTCACHE_MOVE_EPSILON * SIGHTCACHE_MOVE_EPSILON ) {
+		return qfalse;
+	}
+	if ( DistanceSquared( sc->destpos, destpos ) > SIGHTCACHE_MOVE_EPSILON * SIGHTCACHE_MOVE_EPSILON ) {
+		return qfalse;
+	}
+	return qtrue;
+}
+
 /*
 ==============
 AICast_InFieldOfVision
@@ -114,6 +220,7 @@ qboolean AICast_VisibleFromPos( vec3_t srcpos, int srcnum,
 	vec3_t destmins, destmaxs;
 	vec3_t right, vec;
 	qboolean inPVS;
+	aicast_sightcache_t *sc = NULL;
 
 	if ( g_entities[destnum].flags & FL_NOTARGET ) {
 		return qfalse;
@@ -134,6 +241,23 @@ qboolean AICast_VisibleFromPos( vec3_t srcpos, int srcnum,
 	VectorCopy( g_entities[destnum].r.mins, destmins );
 	VectorCopy( g_entities[destnum].r.maxs, destmaxs );
 	//
+	// sighting checks are repeated every few frames, so see if we already know the answer
+	if ( updateVisPos && srcnum < aicast_maxclients && destnum < aicast_maxclients ) {
+		sc = &sightCache[srcnum * aicast_maxclients + destnum];
+		if ( AICast_SightCacheValid( sc, srcpos, srcviewheight, destpos, destmaxs[2] - destmins[2] ) ) {
+			sightCacheHits++;
+			return sc->visible;
+		}
+		sightCacheMisses++;
+		sc->time = level.time;
+		sc->moverCount = sightCacheMoverCount;
+		VectorCopy( srcpos, sc->srcpos );
+		VectorCopy( destpos, sc->destpos );
+		sc->srcviewheight = srcviewheight;
+		sc->destheight = destmaxs[2] - destmins[2];
+		sc->visible = qfalse;
+	}
+	//
 	//calculate middle of bounding box
 	VectorAdd( destmins, destmaxs, middle );
 	VectorScale( middle, 0.5, middle );
@@ -199,6 +323,9 @@ qboolean AICast_VisibleFromPos( vec3_t srcpos, int srcnum,
 		} //end if
 		  //if a full trace or the hitent was hit
 		if ( trace.fraction >= 1 || trace.entityNum == hitent ) {
+			if ( sc ) {
+				sc->visible = qtrue;
+			}
 			return qtrue;
 		}
 		//check bottom and top of bounding box as well
@@ -580,7 +707,7 @@ void AICast_SightUpdate( int numchecks ) {
 		numchecks = 5;
 	}
 
-	if ( trap_Cvar_VariableIntegerValue( "savegame_loading" ) ) {
+	if ( aicast_savegameLoading.integer ) {
 		return;
 	}
 
@@ -588,6 +715,8 @@ void AICast_SightUpdate( int numchecks ) {
 		return;
 	}
 
+	AICast_SightCacheStats();
+
 	// First, check all REAL clients, so sighting player is only effected by reaction_time, not
 	// effected by framerate also
 	for (   srccount = 0, src = 0, srcent = &g_entities[0];
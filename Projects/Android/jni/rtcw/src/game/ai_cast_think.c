@@ -734,7 +734,9 @@ void AICast_Think( int client, float thinktime ) {
 		AICast_QueryThink( cs );
 	} else if ( cs->pauseTime < level.time )     {
 		// do the thinking
+		AICast_PredictCacheScope( qtrue );
 		AICast_ProcessAIFunctions( cs, thinktime );
+		AICast_PredictCacheScope( qfalse );
 		//
 		// make sure the correct weapon is selected
 		trap_EA_SelectWeapon( cs->bs->client, cs->weaponNum );
@@ -800,7 +802,8 @@ void AICast_StartFrame( int time ) {
 	static vmCvar_t aicast_disable;
 	gentity_t *ent;
 
-	if ( trap_Cvar_VariableIntegerValue( "savegame_loading" ) ) {
+	trap_Cvar_Update( &aicast_savegameLoading );
+	if ( aicast_savegameLoading.integer ) {
 		return;
 	}
 
@@ -933,6 +936,8 @@ void AICast_StartFrame( int time ) {
 	}
 	//
 	lasttime = time;
+	//
+	AICast_PredictCacheStats();
 }
 
 /*
@@ -953,7 +958,8 @@ void AICast_StartServerFrame( int time ) {
 	qboolean highPriority;
 	int oldLegsTimer;
 
-	if ( trap_Cvar_VariableIntegerValue( "savegame_loading" ) ) {
+	trap_Cvar_Update( &aicast_savegameLoading );
+	if ( aicast_savegameLoading.integer ) {
 		return;
 	}
 
@@ -1091,6 +1097,106 @@ void AICast_StartServerFrame( int time ) {
 	}
 }
 
+/*
+Prediction cache.
+
+The attack and avoidance functions of a cast often predict the same movement more
+than once while deciding what to do. The decision pass (AICast_ProcessAIFunctions)
+only queues input for the cast, so nothing in the world moves while it runs and the
+same inputs give the same result. Keep the last few predictions for the current pass
+only: once the pass is over, this cast's move, other casts, movers and scripts may
+change what the traces hit.
+*/
+#define PREDICTCACHE_SIZE   8
+
+typedef struct {
+	int scope;                  // predictCacheScope of the prediction, 0 if unused
+	int entityNum;
+	int numframes;
+	float frametime;
+	int checkHitEnt;
+	usercmd_t ucmd;
+	playerState_t ps;
+	qboolean groundHack;        // see the "hack" at the end of AICast_PredictMovement
+	vec3_t groundHackPos;
+	aicast_predictmove_t move;
+} aicast_predictcache_t;
+
+static aicast_predictcache_t predictCache[PREDICTCACHE_SIZE];
+static int predictCacheNext;
+static int predictCacheScope;       // current decision pass, 0 if not in one
+static int predictCacheScopes;
+static int predictCacheHits, predictCacheMisses, predictFramesRun, predictFramesSaved;
+
+/*
+==============
+AICast_PredictCacheFind
+==============
+*/
+static aicast_predictcache_t *AICast_PredictCacheFind( cast_state_t *cs, int numframes, float frametime, aicast_predictmove_t *move, usercmd_t *ucmd, int checkHitEnt, playerState_t *ps ) {
+	aicast_predictcache_t *pc;
+	int i;
+
+	for ( i = 0, pc = predictCache; i < PREDICTCACHE_SIZE; i++, pc++ ) {
+		if ( pc->scope != predictCacheScope || pc->entityNum != cs->entityNum ) {
+			continue;
+		}
+		if ( pc->numframes != numframes || pc->frametime != frametime || pc->checkHitEnt != checkHitEnt ) {
+			continue;
+		}
+		if ( pc->groundHack != ( move->groundEntityNum == ENTITYNUM_NONE ) ) {
+			continue;
+		}
+		if ( pc->groundHack && !VectorCompare( pc->groundHackPos, move->endpos ) ) {
+			continue;
+		}
+		if ( memcmp( &pc->ucmd, ucmd, sizeof( usercmd_t ) ) ) {
+			continue;
+		}
+		if ( memcmp( &pc->ps, ps, sizeof( playerState_t ) ) ) {
+			continue;
+		}
+		return pc;
+	}
+	return NULL;
+}
+
+/*
+==============
+AICast_PredictCacheScope
+
+  Opens or closes a decision pass, predictions are only reused within one
+==============
+*/
+void AICast_PredictCacheScope( qboolean open ) {
+	if ( open ) {
+		if ( ++predictCacheScopes <= 0 ) {
+			predictCacheScopes = 1;
+		}
+		predictCacheScope = predictCacheScopes;
+	} else {
+		predictCacheScope = 0;
+	}
+}
+
+/*
+==============
+AICast_PredictCacheStats
+
+  Called once per frame, reports and resets the prediction counters
+==============
+*/
+void AICast_PredictCacheStats( void ) {
+	if ( aicast_debug.integer == 3 && ( predictCacheHits || predictCacheMisses ) ) {
+		G_Printf( "AI Predict Cache: %i hits, %i misses, %i pmove frames run, %i saved\n",
+				  predictCacheHits, predictCacheMisses, predictFramesRun, predictFramesSaved );
+	}
+	predictCacheHits = 0;
+	predictCacheMisses = 0;
+	predictFramesRun = 0;
+	predictFramesSaved = 0;
+}
+
 /*
 ==============
 AICast_PredictMovement
@@ -1107,6 +1213,7 @@ void AICast_PredictMovement( cast_state_t *cs, int numframes, float frametime, a
 	qboolean checkReachMarker;
 	gentity_t   *ent = &g_entities[cs->entityNum];
 	bot_input_t bi;
+	aicast_predictcache_t *pc = NULL;
 
 //int pretime = Sys_MilliSeconds();
 //G_Printf("PredictMovement: %f duration, %i frames\n", frametime, numframes );
@@ -1120,6 +1227,36 @@ void AICast_PredictMovement( cast_state_t *cs, int numframes, float frametime, a
 
 	ps.eFlags |= EF_DUMMY_PMOVE;
 
+	// if we're steering towards checkHitEnt, the ucmd gets rebuilt each frame, so don't cache those
+	if ( predictCacheScope && !( cs->bs && checkHitEnt >= 0 ) ) {
+		pc = AICast_PredictCacheFind( cs, numframes, frametime, move, ucmd, checkHitEnt, &ps );
+		if ( pc ) {
+			predictCacheHits++;
+			predictFramesSaved += pc->move.frames;
+			VectorCopy( pc->move.endpos, move->endpos );
+			VectorCopy( pc->move.velocity, move->velocity );
+			move->stopevent = pc->move.stopevent;
+			move->frames = pc->move.frames;
+			move->numtouch = pc->move.numtouch;
+			memcpy( move->touchents, pc->move.touchents, sizeof( move->touchents ) );
+			move->groundEntityNum = pc->move.groundEntityNum;
+			return;
+		}
+		predictCacheMisses++;
+		// store the inputs now, the results are filled in once we're done
+		pc = &predictCache[predictCacheNext];
+		predictCacheNext = ( predictCacheNext + 1 ) % PREDICTCACHE_SIZE;
+		pc->scope = predictCacheScope;
+		pc->entityNum = cs->entityNum;
+		pc->numframes = numframes;
+		pc->frametime = frametime;
+		pc->checkHitEnt = checkHitEnt;
+		pc->ucmd = *ucmd;
+		pc->ps = ps;
+		pc->groundHack = ( move->groundEntityNum == ENTITYNUM_NONE );
+		VectorCopy( move->endpos, pc->groundHackPos );
+	}
+
 	move->stopevent = PREDICTSTOP_NONE;
 
 	if ( checkHitEnt >= 0 && !Q_stricmp( g_entities[checkHitEnt].classname, "ai_marker" ) ) {
@@ -1229,6 +1366,11 @@ done:
 	memcpy( move->touchents, pm.touchents, sizeof( pm.touchents ) );
 	move->groundEntityNum = pm.ps->groundEntityNum;
 
+	predictFramesRun += frame;
+	if ( pc ) {
+		pc->move = *move;
+	}
+
 //G_Printf("PredictMovement: %i ms\n", -pretime + Sys_MilliSeconds() );
 }
 
@@ -151,6 +151,23 @@ typedef struct
 	qboolean ( *eventMatch )( g_script_event_t *event, char *eventParm );
 } g_script_event_define_t;
 //
+// index of the named blocks in a script file, so each entity can go straight to
+// its own script without parsing everyone else's
+#define G_SCRIPT_INDEX_HASH_SIZE    256
+//
+typedef struct g_script_block_s
+{
+	char                        *name;
+	char                        *text;      // script text following the name
+	int line;                               // parse line at the start of text
+	struct g_script_block_s     *hashNext;
+} g_script_block_t;
+//
+typedef struct
+{
+	g_script_block_t            *hash[G_SCRIPT_INDEX_HASH_SIZE];
+} g_script_index_t;
+//
 // Script Flags
 #define SCFL_GOING_TO_MARKER    0x1
 #define SCFL_ANIMATING          0x2
@@ -689,6 +706,7 @@ typedef struct {
 	int portalSequence;
 	// Ridah
 	char        *scriptAI;
+	g_script_index_t    *scriptAIIndex;
 	int reloadPauseTime;                // don't think AI/client's until this time has elapsed
 	int reloadDelayTime;                // don't start loading the savegame until this has expired
 
@@ -719,6 +737,7 @@ typedef struct {
 
 	// RF, entity scripting
 	char        *scriptEntity;
+	g_script_index_t    *scriptEntityIndex;
 
 	// player/AI model scripting (server repository)
 	animScriptData_t animScriptData;
@@ -1069,6 +1088,8 @@ void G_Script_ScriptParse( gentity_t *ent );
 qboolean G_Script_ScriptRun( gentity_t *ent );
 void G_Script_ScriptEvent( gentity_t *ent, char *eventStr, char *params );
 void G_Script_ScriptLoad( void );
+g_script_index_t *G_Script_BuildIndex( char *script, const char *parseName );
+char *G_Script_FindBlock( g_script_index_t *index, const char *name, const char *parseName );
 
 float AngleDifference( float ang1, float ang2 );
 
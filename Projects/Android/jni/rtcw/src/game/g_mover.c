@@ -664,6 +664,8 @@ void G_RunMover( gentity_t *ent ) {
 	// if stationary at one of the positions, don't move anything
 	if ( ent->s.pos.trType != TR_STATIONARY || ent->s.apos.trType != TR_STATIONARY ) {
 		G_MoverTeam( ent );
+		// anything the AI saw past it may now be hidden, or the other way round
+		AICast_SightCacheMoverChanged();
 	}
 
 	// check think function
@@ -701,6 +703,9 @@ void SetMoverState( gentity_t *ent, moverState_t moverState, int time ) {
 	ent->moverState     = moverState;
 	ent->s.pos.trTime   = time;
 	ent->s.apos.trTime  = time;
+
+	// doors opening or closing change what the AI can see
+	AICast_SightCacheMoverChanged();
 	switch ( moverState ) {
 	case MOVER_POS1:
 		VectorCopy( ent->pos1, ent->s.pos.trBase );
@@ -3568,6 +3573,7 @@ Use_Static
 ==============
 */
 void Use_Static( gentity_t *ent, gentity_t *other, gentity_t *activator ) {
+	AICast_SightCacheMoverChanged();
 	if ( ent->r.linked ) {
 		trap_UnlinkEntity( ent );
 		// DISABLED since func_static will carve up AAS anyway, so blocking makes no sense
@@ -4339,6 +4345,7 @@ func_explosive_spawn
 */
 void func_explosive_spawn( gentity_t *self, gentity_t *other, gentity_t *activator ) {
 	trap_LinkEntity( self );
+	AICast_SightCacheMoverChanged();
 	self->use = func_explosive_use;
 	// turn the brush to visible
 
@@ -281,6 +281,47 @@ void G_SaveWriteError( void ) {
 
 static int saveByteCount;
 
+/*
+Savegames are made up of thousands of small reads and writes (a length, an encoded
+chunk, a string), so they are collected here and passed to the filesystem in large
+blocks, rather than making a filesystem call for each one.
+*/
+#define SAVE_IO_BUFSIZE     0x10000
+
+static byte saveIOBuf[SAVE_IO_BUFSIZE];
+static int saveIOBufCount;      // bytes waiting to be written, or bytes available to read
+static int saveIOBufPos;        // read position in saveIOBuf
+static int saveIOFileLeft;      // bytes left in the file that haven't been read into saveIOBuf
+
+/*
+===============
+G_SaveWriteBegin
+===============
+*/
+static void G_SaveWriteBegin( void ) {
+	saveByteCount = 0;
+	saveIOBufCount = 0;
+	saveIOBufPos = 0;
+}
+
+/*
+===============
+G_SaveFlush
+
+  writes out anything left in the buffer, must be called before closing the file
+===============
+*/
+static qboolean G_SaveFlush( fileHandle_t f ) {
+	int len;
+
+	len = saveIOBufCount;
+	saveIOBufCount = 0;
+	if ( !len ) {
+		return qtrue;
+	}
+	return ( trap_FS_Write( saveIOBuf, len, f ) != 0 );
+}
+
 /*
 ===============
 G_SaveWrite
@@ -292,7 +333,70 @@ G_SaveWrite
 int G_SaveWrite( const void *buffer, int len, fileHandle_t f ) {
 	saveByteCount += len;
 
-	return trap_FS_Write( buffer, len, f );
+	if ( saveIOBufCount + len > SAVE_IO_BUFSIZE ) {
+		if ( !G_SaveFlush( f ) ) {
+			return 0;
+		}
+		if ( len > SAVE_IO_BUFSIZE ) {
+			return trap_FS_Write( buffer, len, f );
+		}
+	}
+	memcpy( saveIOBuf + saveIOBufCount, buffer, len );
+	saveIOBufCount += len;
+
+	return len;
+}
+
+/*
+===============
+G_SaveReadBegin
+
+  filelen is the length returned by trap_FS_FOpenFile
+===============
+*/
+static void G_SaveReadBegin( int filelen ) {
+	saveIOBufCount = 0;
+	saveIOBufPos = 0;
+	saveIOFileLeft = filelen;
+}
+
+/*
+===============
+G_SaveRead
+===============
+*/
+static void G_SaveRead( void *buffer, int len, fileHandle_t f ) {
+	byte *out = buffer;
+	int count;
+
+	while ( len > 0 ) {
+		if ( saveIOBufPos >= saveIOBufCount ) {
+			// large reads go straight through
+			if ( len >= SAVE_IO_BUFSIZE ) {
+				trap_FS_Read( out, len, f );
+				saveIOFileLeft -= len;
+				return;
+			}
+			count = saveIOFileLeft < SAVE_IO_BUFSIZE ? saveIOFileLeft : SAVE_IO_BUFSIZE;
+			if ( count <= 0 ) {
+				// past the end of the file, same as a short FS_Read
+				memset( out, 0, len );
+				return;
+			}
+			trap_FS_Read( saveIOBuf, count, f );
+			saveIOFileLeft -= count;
+			saveIOBufCount = count;
+			saveIOBufPos = 0;
+		}
+		count = saveIOBufCount - saveIOBufPos;
+		if ( count > len ) {
+			count = len;
+		}
+		memcpy( out, saveIOBuf + saveIOBufPos, count );
+		saveIOBufPos += count;
+		out += count;
+		len -= count;
+	}
 }
 
 //=========================================================
@@ -438,7 +542,7 @@ void ReadField( fileHandle_t f, saveField_t *field, byte *base ) {
 		} else
 		{
 			*(char **)p = G_Alloc( len );
-			trap_FS_Read( *(char **)p, len, f );
+			G_SaveRead( *(char **)p, len, f );
 		}
 		break;
 	case F_ENTITY:
@@ -483,7 +587,7 @@ void ReadField( fileHandle_t f, saveField_t *field, byte *base ) {
 			if ( len > sizeof( funcStr ) ) {
 				G_Error( "ReadField: function name is greater than buffer (%i chars)", sizeof( funcStr ) );
 			}
-			trap_FS_Read( funcStr, len, f );
+			G_SaveRead( funcStr, len, f );
 			if ( !( *(byte **)p = G_FindFuncByName( funcStr ) ) ) {
 				G_Error( "ReadField: unknown function '%s'\ncannot load game", funcStr );
 			}
@@ -635,14 +739,14 @@ void ReadClient( fileHandle_t f, gclient_t *client, int size ) {
 	int decodedSize;
 
 	if ( ver == 10 ) {
-		trap_FS_Read( &temp, size, f );
+		G_SaveRead( &temp, size, f );
 	} else {
 		// read the encoded chunk
-		trap_FS_Read( &decodedSize, sizeof( int ), f );
+		G_SaveRead( &decodedSize, sizeof( int ), f );
 		if ( decodedSize > sizeof( clientBuf ) ) {
 			G_Error( "G_LoadGame: encoded chunk is greater than buffer" );
 		}
-		trap_FS_Read( clientBuf, decodedSize, f ); \
+		G_SaveRead( clientBuf, decodedSize, f ); \
 		// decode it
 		G_Save_Decode( clientBuf, decodedSize, (byte *)&temp, sizeof( temp ) );
 	}
@@ -795,14 +899,14 @@ void ReadEntity( fileHandle_t f, gentity_t *ent, int size ) {
 	backup = *ent;
 
 	if ( ver == 10 ) {
-		trap_FS_Read( &temp, size, f );
+		G_SaveRead( &temp, size, f );
 	} else {
 		// read the encoded chunk
-		trap_FS_Read( &decodedSize, sizeof( int ), f );
+		G_SaveRead( &decodedSize, sizeof( int ), f );
 		if ( decodedSize > sizeof( entityBuf ) ) {
 			G_Error( "G_LoadGame: encoded chunk is greater than buffer" );
 		}
-		trap_FS_Read( entityBuf, decodedSize, f );
+		G_SaveRead( entityBuf, decodedSize, f );
 		// decode it
 		G_Save_Decode( entityBuf, decodedSize, (byte *)&temp, sizeof( temp ) );
 	}
@@ -957,14 +1061,14 @@ void ReadCastState( fileHandle_t f, cast_state_t *cs, int size ) {
 	int decodedSize;
 
 	if ( ver == 10 ) {
-		trap_FS_Read( &temp, size, f );
+		G_SaveRead( &temp, size, f );
 	} else {
 		// read the encoded chunk
-		trap_FS_Read( &decodedSize, sizeof( int ), f );
+		G_SaveRead( &decodedSize, sizeof( int ), f );
 		if ( decodedSize > sizeof( castStateBuf ) ) {
 			G_Error( "G_LoadGame: encoded chunk is greater than buffer" );
 		}
-		trap_FS_Read( castStateBuf, decodedSize, f ); \
+		G_SaveRead( castStateBuf, decodedSize, f ); \
 		// decode it
 		G_Save_Decode( castStateBuf, decodedSize, (byte *)&temp, sizeof( temp ) );
 	}
@@ -1028,15 +1132,15 @@ ReadTime
 ==============
 */
 void ReadTime( fileHandle_t f, qtime_t *tm ) {
-	trap_FS_Read( &tm->tm_sec, sizeof( tm->tm_sec ), f );
-	trap_FS_Read( &tm->tm_min, sizeof( tm->tm_min ), f );
-	trap_FS_Read( &tm->tm_hour, sizeof( tm->tm_hour ), f );
-	trap_FS_Read( &tm->tm_mday, sizeof( tm->tm_mday ), f );
-	trap_FS_Read( &tm->tm_mon, sizeof( tm->tm_mon ), f );
-	trap_FS_Read( &tm->tm_year, sizeof( tm->tm_year ), f );
-	trap_FS_Read( &tm->tm_wday, sizeof( tm->tm_wday ), f );
-	trap_FS_Read( &tm->tm_yday, sizeof( tm->tm_yday ), f );
-	trap_FS_Read( &tm->tm_isdst, sizeof( tm->tm_isdst ), f );
+	G_SaveRead( &tm->tm_sec, sizeof( tm->tm_sec ), f );
+	G_SaveRead( &tm->tm_min, sizeof( tm->tm_min ), f );
+	G_SaveRead( &tm->tm_hour, sizeof( tm->tm_hour ), f );
+	G_SaveRead( &tm->tm_mday, sizeof( tm->tm_mday ), f );
+	G_SaveRead( &tm->tm_mon, sizeof( tm->tm_mon ), f );
+	G_SaveRead( &tm->tm_year, sizeof( tm->tm_year ), f );
+	G_SaveRead( &tm->tm_wday, sizeof( tm->tm_wday ), f );
+	G_SaveRead( &tm->tm_yday, sizeof( tm->tm_yday ), f );
+	G_SaveRead( &tm->tm_isdst, sizeof( tm->tm_isdst ), f );
 }
 
 /*
@@ -1112,6 +1216,7 @@ qboolean G_SaveGame( char *username ) {
 	gclient_t   *cl;
 	cast_state_t    *cs;
 	int playtime, minutes;
+	int starttime;
 
 	//if (reloading)
 	//	return qtrue;	// actually this should be qtrue, but we should make it silent during reloading
@@ -1141,7 +1246,8 @@ qboolean G_SaveGame( char *username ) {
 		}
 	}
 
-	saveByteCount = 0;
+	starttime = trap_Milliseconds();
+	G_SaveWriteBegin();
 
 	// open the file
 	Com_sprintf( filename, MAX_QPATH, "save\\temp.svg", username );
@@ -1346,6 +1452,9 @@ qboolean G_SaveGame( char *username ) {
 		G_SaveWriteError();
 	}
 
+	if ( !G_SaveFlush( f ) ) {
+		G_SaveWriteError();
+	}
 
 	trap_FS_FCloseFile( f );
 
@@ -1375,6 +1484,8 @@ qboolean G_SaveGame( char *username ) {
 
 #endif
 
+	G_DPrintf( "G_SaveGame: %i bytes in %i msec\n", saveByteCount, trap_Milliseconds() - starttime );
+
 	return qtrue;
 }
 
@@ -1398,6 +1509,7 @@ void G_LoadGame( char *filename ) {
 	cast_state_t    *cs;
 	qtime_t tm;
 	qboolean serverEntityUpdate = qfalse;
+	int starttime, len;
 
 	if ( g_gametype.integer != GT_SINGLE_PLAYER ) {    // don't allow loads in MP
 		return;
@@ -1412,13 +1524,16 @@ void G_LoadGame( char *filename ) {
 	// enforce the "current" savegame, since that is used for all loads
 	filename = "save\\current.svg";
 
+	starttime = trap_Milliseconds();
+
 	// open the file
-	if ( trap_FS_FOpenFile( filename, &f, FS_READ ) < 0 ) {
+	if ( ( len = trap_FS_FOpenFile( filename, &f, FS_READ ) ) < 0 ) {
 		G_Error( "G_LoadGame: savegame '%s' not found\n", filename );
 	}
+	G_SaveReadBegin( len );
 
 	// read the version
-	trap_FS_Read( &i, sizeof( i ), f );
+	G_SaveRead( &i, sizeof( i ), f );
 	// TTimo
 	// show_bug.cgi?id=434
 	// 17 is the only version actually out in the wild
@@ -1435,14 +1550,14 @@ void G_LoadGame( char *filename ) {
 	}
 
 	// read the mapname (this is only used in the sever exe, so just discard it)
-	trap_FS_Read( mapname, MAX_QPATH, f );
+	G_SaveRead( mapname, MAX_QPATH, f );
 
 	// read the level time
-	trap_FS_Read( &i, sizeof( i ), f );
+	G_SaveRead( &i, sizeof( i ), f );
 	leveltime = i;
 
 	// read the totalPlayTime
-	trap_FS_Read( &i, sizeof( i ), f );
+	G_SaveRead( &i, sizeof( i ), f );
 	if ( i > g_totalPlayTime.integer ) {
 		trap_Cvar_Set( "g_totalPlayTime", va( "%i", i ) );
 	}
@@ -1451,7 +1566,7 @@ void G_LoadGame( char *filename ) {
 	// this is only set in the map scripts, and was previously only handled in the menu's
 	// read the 'episode'
 	if ( ver >= 13 ) {
-		trap_FS_Read( &i, sizeof( i ), f );
+		G_SaveRead( &i, sizeof( i ), f );
 		trap_Cvar_Set( "g_episode", va( "%i", i ) );
 	}
 //----(SA)	end
@@ -1459,10 +1574,10 @@ void G_LoadGame( char *filename ) {
 	// NOTE: do not change the above order without also changing the server code
 
 	// read the info string length
-	trap_FS_Read( &i, sizeof( i ), f );
+	G_SaveRead( &i, sizeof( i ), f );
 
 	// read the info string
-	trap_FS_Read( infoString, i, f );
+	G_SaveRead( infoString, i, f );
 
 	if ( ver >= SA_MOVEDSTUFF ) {
 		if ( ver > SA_ADDEDMUSIC ) {
@@ -1470,7 +1585,7 @@ void G_LoadGame( char *filename ) {
 			ReadTime( f, &tm );
 
 			// read music
-			trap_FS_Read( musicString, MAX_QPATH, f );
+			G_SaveRead( musicString, MAX_QPATH, f );
 
 			if ( strlen( musicString ) ) {
 				trap_Cvar_Register( &musicCvar, "s_currentMusic", "", CVAR_ROM ); // get current music
@@ -1489,9 +1604,9 @@ void G_LoadGame( char *filename ) {
 			int k;
 
 			// get length
-			trap_FS_Read( &i, sizeof( i ), f );
+			G_SaveRead( &i, sizeof( i ), f );
 			// get fog string
-			trap_FS_Read( infoString, i, f );
+			G_SaveRead( infoString, i, f );
 			infoString[i] = 0;
 
 			// set the configstring so the 'savegame current' has good fog
@@ -1520,7 +1635,7 @@ void G_LoadGame( char *filename ) {
 
 		if ( ver > 13 ) {
 			// read the game skill
-			trap_FS_Read( &i, sizeof( i ), f );
+			G_SaveRead( &i, sizeof( i ), f );
 			// set the skill level
 			trap_Cvar_Set( "g_gameskill", va( "%i",i ) );
 			// update this
@@ -1535,12 +1650,12 @@ void G_LoadGame( char *filename ) {
 	trap_AAS_SetAASBlockingEntity( vec3_origin, vec3_origin, -1 );
 
 	// read the entity structures
-	trap_FS_Read( &i, sizeof( i ), f );
+	G_SaveRead( &i, sizeof( i ), f );
 	size = i;
 	last = 0;
 	while ( 1 )
 	{
-		trap_FS_Read( &i, sizeof( i ), f );
+		G_SaveRead( &i, sizeof( i ), f );
 		if ( i < 0 ) {
 			break;
 		}
@@ -1576,11 +1691,11 @@ void G_LoadGame( char *filename ) {
 	}
 
 	// read the client structures
-	trap_FS_Read( &i, sizeof( i ), f );
+	G_SaveRead( &i, sizeof( i ), f );
 	size = i;
 	while ( 1 )
 	{
-		trap_FS_Read( &i, sizeof( i ), f );
+		G_SaveRead( &i, sizeof( i ), f );
 		if ( i < 0 ) {
 			break;
 		}
@@ -1597,11 +1712,11 @@ void G_LoadGame( char *filename ) {
 	}
 
 	// read the cast_state structures
-	trap_FS_Read( &i, sizeof( i ), f );
+	G_SaveRead( &i, sizeof( i ), f );
 	size = i;
 	while ( 1 )
 	{
-		trap_FS_Read( &i, sizeof( i ), f );
+		G_SaveRead( &i, sizeof( i ), f );
 		if ( i < 0 ) {
 			break;
 		}
@@ -1627,7 +1742,7 @@ void G_LoadGame( char *filename ) {
 			ReadTime( f, &tm );
 
 			// read music
-			trap_FS_Read( musicString, MAX_QPATH, f );
+			G_SaveRead( musicString, MAX_QPATH, f );
 
 			if ( strlen( musicString ) ) {
 				trap_Cvar_Register( &musicCvar, "s_currentMusic", "", CVAR_ROM ); // get current music
@@ -1641,7 +1756,7 @@ void G_LoadGame( char *filename ) {
 
 		if ( ver > 13 ) {
 			// read the game skill
-			trap_FS_Read( &i, sizeof( i ), f );
+			G_SaveRead( &i, sizeof( i ), f );
 			// set the skill level
 			trap_Cvar_Set( "g_gameskill", va( "%i",i ) );
 			// update this
@@ -1666,6 +1781,8 @@ void G_LoadGame( char *filename ) {
 
 	level.lastLoadTime = leveltime;
 
+	G_DPrintf( "G_LoadGame: %i bytes in %i msec\n", len, trap_Milliseconds() - starttime );
+
 /*
 	// always save to the "current" savegame
 	last = level.time;
@@ -1716,7 +1833,7 @@ void PersReadClient( fileHandle_t f, gclient_t *cl ) {
 	// read the fields
 	for ( field = gclientPersFields ; field->len ; field++ )
 	{   // read the block
-		trap_FS_Read( ( void * )( (byte *)cl + field->ofs ), field->len, f );
+		G_SaveRead( ( void * )( (byte *)cl + field->ofs ), field->len, f );
 	}
 }
 
@@ -1748,7 +1865,7 @@ void PersReadEntity( fileHandle_t f, gentity_t *cl ) {
 	// read the fields
 	for ( field = gentityPersFields ; field->len ; field++ )
 	{   // read the block
-		trap_FS_Read( ( void * )( (byte *)cl + field->ofs ), field->len, f );
+		G_SaveRead( ( void * )( (byte *)cl + field->ofs ), field->len, f );
 	}
 }
 
@@ -1782,7 +1899,7 @@ void PersReadCastState( fileHandle_t f, cast_state_t *cs ) {
 	// read the fields
 	for ( field = castStatePersFields ; field->len ; field++ )
 	{   // read the block
-		trap_FS_Read( ( void * )( (byte *)cs + field->ofs ), field->len, f );
+		G_SaveRead( ( void * )( (byte *)cs + field->ofs ), field->len, f );
 	}
 }
 
@@ -1807,7 +1924,7 @@ qboolean G_SavePersistant( char *nextmap ) {
 	fileHandle_t f;
 	int persid;
 
-	saveByteCount = 0;
+	G_SaveWriteBegin();
 
 	// open the file
 	Com_sprintf( filename, MAX_QPATH, "save\\temp.psw" );
@@ -1832,6 +1949,10 @@ qboolean G_SavePersistant( char *nextmap ) {
 	// write out the cast_state structure
 	PersWriteCastState( f, AICast_GetCastState( 0 ) );
 
+	if ( !G_SaveFlush( f ) ) {
+		G_SaveWriteError();
+	}
+
 	trap_FS_FCloseFile( f );
 
 	// now check that it is the correct size
@@ -1868,18 +1989,19 @@ void G_LoadPersistant( void ) {
 	char *filename;
 	char mapstr[MAX_QPATH];
 	vmCvar_t cvar_mapname;
-	int persid;
+	int persid, len;
 
 	filename = "save\\current.psw";
 
 	// open the file
-	if ( trap_FS_FOpenFile( filename, &f, FS_READ ) < 0 ) {
+	if ( ( len = trap_FS_FOpenFile( filename, &f, FS_READ ) ) < 0 ) {
 		// not here, we shall assume they didn't want one
 		return;
 	}
+	G_SaveReadBegin( len );
 
 	// read the mapname, if it's not the same, then ignore the file
-	trap_FS_Read( mapstr, MAX_QPATH, f );
+	G_SaveRead( mapstr, MAX_QPATH, f );
 	trap_Cvar_Register( &cvar_mapname, "mapname", "", CVAR_SERVERINFO | CVAR_ROM );
 	if ( Q_strcasecmp( cvar_mapname.string, mapstr ) ) {
 		trap_FS_FCloseFile( f );
@@ -1887,7 +2009,7 @@ void G_LoadPersistant( void ) {
 	}
 
 	// check the pers id
-	trap_FS_Read( &persid, sizeof( persid ), f );
+	G_SaveRead( &persid, sizeof( persid ), f );
 	if ( persid != trap_Cvar_VariableIntegerValue( "persid" ) ) {
 		trap_FS_FCloseFile( f );
 		return;
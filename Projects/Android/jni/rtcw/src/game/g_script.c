@@ -269,10 +269,121 @@ void G_Script_ScriptLoad( void ) {
 		return;
 	}
 
-	level.scriptEntity = G_Alloc( len );
+	level.scriptEntity = G_Alloc( len + 1 );
 	trap_FS_Read( level.scriptEntity, len, f );
+	level.scriptEntity[len] = 0;
 
 	trap_FS_FCloseFile( f );
+
+	level.scriptEntityIndex = G_Script_BuildIndex( level.scriptEntity, "G_Script_ScriptParse" );
+}
+
+/*
+==============
+G_Script_HashName
+==============
+*/
+static int G_Script_HashName( const char *name ) {
+	int hash;
+
+	for ( hash = 0; *name; name++ ) {
+		hash = hash * 31 + tolower( *name );
+	}
+	return hash & ( G_SCRIPT_INDEX_HASH_SIZE - 1 );
+}
+
+/*
+==============
+G_Script_BuildIndex
+
+  Parses the script once to find where each named block starts. This also does the
+  syntax checks that used to be done each time the script was parsed for an entity.
+==============
+*/
+g_script_index_t *G_Script_BuildIndex( char *script, const char *parseName ) {
+	g_script_index_t *index;
+	g_script_block_t *block;
+	char *pScript, *token;
+	int hash, bracketLevel;
+
+	index = G_Alloc( sizeof( g_script_index_t ) );
+	memset( index, 0, sizeof( g_script_index_t ) );
+
+	pScript = script;
+	COM_BeginParseSession( parseName );
+
+	while ( 1 )
+	{
+		token = COM_Parse( &pScript );
+
+		if ( !token[0] ) {
+			break;
+		}
+		if ( token[0] == '}' ) {
+			G_Error( "%s(), Error (line %d): '}' found, but not expected.\n", parseName, COM_GetCurrentParseLine() );
+		}
+		if ( token[0] == '{' ) {
+			G_Error( "%s(), Error (line %d): '{' found, NAME expected.\n", parseName, COM_GetCurrentParseLine() );
+		}
+
+		// only the first block with a given name is ever used
+		if ( !G_Script_FindBlock( index, token, NULL ) ) {
+			block = G_Alloc( sizeof( g_script_block_t ) + strlen( token ) + 1 );
+			block->name = (char *)( block + 1 );
+			strcpy( block->name, token );
+			block->text = pScript;
+			block->line = COM_GetCurrentParseLine();
+			hash = G_Script_HashName( block->name );
+			block->hashNext = index->hash[hash];
+			index->hash[hash] = block;
+		}
+
+		// skip the block
+		bracketLevel = 0;
+		while ( 1 )
+		{
+			token = COM_Parse( &pScript );
+			if ( !token[0] ) {
+				G_Error( "%s(), Error (line %d): '}' expected, end of script found.\n", parseName, COM_GetCurrentParseLine() );
+			} else if ( token[0] == '{' ) {
+				bracketLevel++;
+			} else if ( token[0] == '}' ) {
+				if ( !--bracketLevel ) {
+					break;
+				}
+			}
+		}
+	}
+
+	return index;
+}
+
+/*
+==============
+G_Script_FindBlock
+
+  Returns the script text following the given name, or NULL if there isn't one.
+  If parseName is set, a new parse session is started at that point.
+==============
+*/
+char *G_Script_FindBlock( g_script_index_t *index, const char *name, const char *parseName ) {
+	g_script_block_t *block;
+
+	if ( !index ) {
+		return NULL;
+	}
+
+	for ( block = index->hash[G_Script_HashName( name )]; block; block = block->hashNext ) {
+		if ( !Q_strcasecmp( block->name, (char *)name ) ) {
+			if ( parseName ) {
+				COM_BeginParseSession( parseName );
+				COM_SetCurrentParseLine( block->line );
+			}
+			return block->text;
+		}
+	}
+
+	return NULL;
 }
 
 /*
@@ -311,10 +422,13 @@ void G_Script_ScriptParse( gentity_t *ent ) {
 	buildScript = trap_Cvar_VariableIntegerValue( "com_buildScript" );
 	buildScript = qtrue;
 
-	pScript = level.scriptEntity;
-	wantName = qtrue;
-	inScript = qfalse;
-	COM_BeginParseSession( "G_Script_ScriptParse" );
+	// go straight to our own script
+	pScript = G_Script_FindBlock( level.scriptEntityIndex, ent->scriptName, "G_Script_ScriptParse" );
+	if ( !pScript ) {
+		return;
+	}
+	wantName = qfalse;
+	inScript = qtrue;
 	bracketLevel = 0;
 	numEventItems = 0;
 
@@ -493,6 +493,11 @@ Marks the entity as free
 =================
 */
 void G_FreeEntity( gentity_t *ed ) {
+	// a solid brush going away can open up a line of sight for the AI
+	if ( ed->r.linked && ed->r.bmodel && ( ed->r.contents & MASK_AISIGHT ) ) {
+		AICast_SightCacheMoverChanged();
+	}
+
 	trap_UnlinkEntity( ed );     // unlink from world
 
 	if ( ed->neverFree ) {
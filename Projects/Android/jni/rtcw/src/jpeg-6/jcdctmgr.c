@@ -170,8 +170,8 @@ start_pass_fdctmgr( j_compress_ptr cinfo ) {
 	}
 }
 
-// TTimo unused
-#if 0
+// TTimo unused (only needed by the integer DCT methods)
+#if defined( DCT_ISLOW_SUPPORTED ) || defined( DCT_IFAST_SUPPORTED )
 /*
  * Perform forward DCT on one or more blocks of a component.
  *
@@ -12,6 +12,12 @@
 #include "jinclude.h"
 #include "jpeglib.h"
 
+#if ( defined( __ARM_NEON ) || defined( __ARM_NEON__ ) ) && BITS_IN_JSAMPLE == 8 && \
+	RGB_PIXELSIZE == 4 && RGB_RED == 0 && RGB_GREEN == 1 && RGB_BLUE == 2
+#include <arm_neon.h>
+#define YCC_NEON
+#endif
+
 
 /* Private subobject */
 
@@ -139,7 +145,36 @@ ycc_rgb_convert( j_decompress_ptr cinfo,
 		inptr2 = input_buf[2][input_row];
 		input_row++;
 		outptr = *output_buf++;
-		for ( col = 0; col < num_cols; col++ ) {
+		col = 0;
+#ifdef YCC_NEON
+		/* Eight pixels at a time, computing the table entries on the fly with
+		 * the same rounding, so the results are identical.  The padding byte
+		 * of each output pixel is set to MAXJSAMPLE.
+		 */
+		for ( ; col + 8 <= num_cols; col += 8 ) {
+			int16x8_t yv = vreinterpretq_s16_u16( vmovl_u8( vld1_u8( inptr0 + col ) ) );
+			int16x8_t cbv = vreinterpretq_s16_u16( vsubl_u8( vld1_u8( inptr1 + col ), vdup_n_u8( CENTERJSAMPLE ) ) );
+			int16x8_t crv = vreinterpretq_s16_u16( vsubl_u8( vld1_u8( inptr2 + col ), vdup_n_u8( CENTERJSAMPLE ) ) );
+			int32x4_t cbl = vmovl_s16( vget_low_s16( cbv ) ), cbh = vmovl_s16( vget_high_s16( cbv ) );
+			int32x4_t crl = vmovl_s16( vget_low_s16( crv ) ), crh = vmovl_s16( vget_high_s16( crv ) );
+			int16x8_t rv, gv, bv;
+			uint8x8x4_t px;
+
+			rv = vcombine_s16( vrshrn_n_s32( vmulq_n_s32( crl, FIX( 1.40200 ) ), SCALEBITS ),
+							   vrshrn_n_s32( vmulq_n_s32( crh, FIX( 1.40200 ) ), SCALEBITS ) );
+			bv = vcombine_s16( vrshrn_n_s32( vmulq_n_s32( cbl, FIX( 1.77200 ) ), SCALEBITS ),
+							   vrshrn_n_s32( vmulq_n_s32( cbh, FIX( 1.77200 ) ), SCALEBITS ) );
+			gv = vcombine_s16( vrshrn_n_s32( vmlaq_n_s32( vmulq_n_s32( cbl, -FIX( 0.34414 ) ), crl, -FIX( 0.71414 ) ), SCALEBITS ),
+							   vrshrn_n_s32( vmlaq_n_s32( vmulq_n_s32( cbh, -FIX( 0.34414 ) ), crh, -FIX( 0.71414 ) ), SCALEBITS ) );
+			px.val[0] = vqmovun_s16( vaddq_s16( yv, rv ) );
+			px.val[1] = vqmovun_s16( vaddq_s16( yv, gv ) );
+			px.val[2] = vqmovun_s16( vaddq_s16( yv, bv ) );
+			px.val[3] = vdup_n_u8( MAXJSAMPLE );
+			vst4_u8( outptr, px );
+			outptr += 8 * RGB_PIXELSIZE;
+		}
+#endif
+		for ( ; col < num_cols; col++ ) {
 			y  = GETJSAMPLE( inptr0[col] );
 			cb = GETJSAMPLE( inptr1[col] );
 			cr = GETJSAMPLE( inptr2[col] );
@@ -86,7 +86,7 @@ use_merged_upsample( j_decompress_ptr cinfo ) {
 GLOBAL void
 jpeg_calc_output_dimensions( j_decompress_ptr cinfo ) {
 /* Do computations that are needed before master selection phase */
-#if 0   // JDC: commented out to remove warning
+#ifdef IDCT_SCALING_SUPPORTED
 	int ci;
 	jpeg_component_info *compptr;
 #endif
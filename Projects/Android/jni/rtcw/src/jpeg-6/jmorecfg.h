@@ -246,7 +246,7 @@ typedef unsigned int JDIMENSION;
 
 /* Capability options common to encoder and decoder: */
 
-#undef DCT_ISLOW_SUPPORTED  /* slow but accurate integer algorithm */
+#define DCT_ISLOW_SUPPORTED /* slow but accurate integer algorithm */
 #undef DCT_IFAST_SUPPORTED  /* faster, less accurate integer method */
 #define DCT_FLOAT_SUPPORTED /* floating-point: accurate, fast on fast HW */
 
@@ -272,7 +272,7 @@ typedef unsigned int JDIMENSION;
 #undef D_MULTISCAN_FILES_SUPPORTED /* Multiple-scan JPEG files? */
 #undef D_PROGRESSIVE_SUPPORTED      /* Progressive JPEG? (Requires MULTISCAN)*/
 #undef BLOCK_SMOOTHING_SUPPORTED   /* Block smoothing? (Progressive only) */
-#undef IDCT_SCALING_SUPPORTED       /* Output rescaling via IDCT? */
+#define IDCT_SCALING_SUPPORTED      /* Output rescaling via IDCT? */
 #undef  UPSAMPLE_SCALING_SUPPORTED  /* Output rescaling at upsample stage? */
 #undef UPSAMPLE_MERGING_SUPPORTED  /* Fast path for sloppy upsampling? */
 #undef QUANT_1PASS_SUPPORTED        /* 1-pass color quantization? */
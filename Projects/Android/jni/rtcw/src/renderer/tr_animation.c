@@ -29,6 +29,14 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "tr_local.h"
 
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+#define MDS_SIMD_SKINNING
+#elif defined( __SSE__ )
+#include <xmmintrin.h>
+#define MDS_SIMD_SKINNING
+#endif
+
 /*
 
 All bones should be an identity orientation to display the mesh exactly
@@ -55,8 +63,8 @@ static int indexes;
 static int baseIndex, baseVertex, oldIndexes;
 static int numVerts;
 static mdsVertex_t     *v;
-static mdsBoneFrame_t bones[MDS_MAX_BONES], rawBones[MDS_MAX_BONES], oldBones[MDS_MAX_BONES];
-static char validBones[MDS_MAX_BONES];
+static mdsBoneFrame_t bones[MDS_MAX_BONES], *rawBones, *oldBones;
+static char             *validBones;
 static char newBones[ MDS_MAX_BONES ];
 static mdsBoneFrame_t  *bonePtr, *bone, *parentBone;
 static mdsBoneFrameCompressed_t    *cBonePtr, *cTBonePtr, *cOldBonePtr, *cOldTBonePtr, *cBoneList, *cOldBoneList, *cBoneListTorso, *cOldBoneListTorso;
@@ -66,7 +74,8 @@ static mdsFrame_t      *oldFrame, *oldTorsoFrame;
 static int frameSize;
 static short           *sh, *sh2;
 static float           *pf;
-static vec3_t angles, tangles, torsoParentOffset, torsoAxis[3], tmpAxis[3];
+static vec3_t angles, tangles, torsoAxis[3], tmpAxis[3];
+static float           *torsoParentOffset;
 static float           *tempVert, *tempNormal;
 static vec3_t vec, v2, dir;
 static float diff, a1, a2;
@@ -79,7 +88,24 @@ static qboolean isTorso, fullTorso;
 static vec4_t m1[4], m2[4];
 //static  vec4_t m3[4], m4[4], tmp1[4], tmp2[4]; // TTimo: unused
 static vec3_t t;
-static refEntity_t lastBoneEntity;
+
+// skeletons are cached per refEntity, so every surface, tag and eye of a model
+// shares one set of bones instead of rebuilding them whenever another entity
+// was drawn in between
+#define MDS_BONE_CACHE_SIZE     32
+
+typedef struct {
+	refEntity_t entity;
+	int lastUsed;
+	char validBones[MDS_MAX_BONES];
+	mdsBoneFrame_t rawBones[MDS_MAX_BONES];         // before torso rotation
+	mdsBoneFrame_t oldBones[MDS_MAX_BONES];         // final bones
+	vec3_t torsoParentOffset;
+} mdsBoneCache_t;
+
+static mdsBoneCache_t boneCache[MDS_BONE_CACHE_SIZE];
+static mdsBoneCache_t   *lastBoneCache;
+static int boneCacheCount;
 
 static int totalrv, totalrt, totalv, totalt;    //----(SA)
 
@@ -987,6 +1013,69 @@ void R_CalcBoneLerp( mdsHeader_t *header, const refEntity_t *refent, int boneNum
 }
 
 
+/*
+==============
+R_BoneCacheForEntity
+
+	Returns the cached skeleton for this refEntity, recycling the least
+	recently used slot if it hasn't been built yet
+==============
+*/
+static mdsBoneCache_t *R_BoneCacheForEntity( mdsHeader_t *header, const refEntity_t *refent ) {
+	mdsBoneCache_t  *cache, *oldest;
+	int i;
+
+	boneCacheCount++;
+
+	// the common case is several surfaces of the same model in a row
+	if ( lastBoneCache && !memcmp( &lastBoneCache->entity, refent, sizeof( refEntity_t ) ) ) {
+		lastBoneCache->lastUsed = boneCacheCount;
+		return lastBoneCache;
+	}
+
+	if ( r_bonesDebug->integer == 4 && totalrt ) {
+		ri.Printf( PRINT_ALL, "Lod %.2f  verts %4d/%4d  tris %4d/%4d  (%.2f%%)\n",
+				   lodScale,
+				   totalrv,
+				   totalv,
+				   totalrt,
+				   totalt,
+				   ( float )( 100.0 * totalrt ) / (float) totalt );
+	}
+
+	totalrv = totalrt = totalv = totalt = 0;
+
+	oldest = boneCache;
+	for ( i = 0, cache = boneCache; i < MDS_BONE_CACHE_SIZE; i++, cache++ ) {
+		if ( cache->lastUsed && !memcmp( &cache->entity, refent, sizeof( refEntity_t ) ) ) {
+			cache->lastUsed = boneCacheCount;
+			return cache;
+		}
+		if ( cache->lastUsed < oldest->lastUsed ) {
+			oldest = cache;
+		}
+	}
+
+	// different, cached bones are not valid
+	cache = oldest;
+	cache->entity = *refent;
+	cache->lastUsed = boneCacheCount;
+	memset( cache->validBones, 0, header->numBones );
+
+	return cache;
+}
+
+/*
+==============
+R_ClearBoneCache
+==============
+*/
+void R_ClearBoneCache( void ) {
+	memset( boneCache, 0, sizeof( boneCache ) );
+	lastBoneCache = NULL;
+	boneCacheCount = 0;
+}
+
 /*
 ==============
 R_CalcBones
@@ -1001,26 +1090,13 @@ void R_CalcBones( mdsHeader_t *header, const refEntity_t *refent, int *boneList,
 	float torsoWeight;
 
 	//
-	// if the entity has changed since the last time the bones were built, reset them
+	// find the bones already built for this entity
 	//
-	if ( memcmp( &lastBoneEntity, refent, sizeof( refEntity_t ) ) ) {
-		// different, cached bones are not valid
-		memset( validBones, 0, header->numBones );
-		lastBoneEntity = *refent;
-
-		if ( r_bonesDebug->integer == 4 && totalrt ) {
-			ri.Printf( PRINT_ALL, "Lod %.2f  verts %4d/%4d  tris %4d/%4d  (%.2f%%)\n",
-					   lodScale,
-					   totalrv,
-					   totalv,
-					   totalrt,
-					   totalt,
-					   ( float )( 100.0 * totalrt ) / (float) totalt );
-		}
-
-		totalrv = totalrt = totalv = totalt = 0;
-
-	}
+	lastBoneCache = R_BoneCacheForEntity( header, refent );
+	validBones = lastBoneCache->validBones;
+	rawBones = lastBoneCache->rawBones;
+	oldBones = lastBoneCache->oldBones;
+	torsoParentOffset = lastBoneCache->torsoParentOffset;
 
 	memset( newBones, 0, header->numBones );
 
@@ -1073,15 +1149,24 @@ void R_CalcBones( mdsHeader_t *header, const refEntity_t *refent, int *boneList,
 			if ( validBones[*boneRefs] ) {
 				// this bone is still in the cache
 				bones[*boneRefs] = rawBones[*boneRefs];
+				backEnd.pc.c_bonesCached++;
 				continue;
 			}
 
 			// find our parent, and make sure it has been calculated
-			if ( ( boneInfo[*boneRefs].parent >= 0 ) && ( !validBones[boneInfo[*boneRefs].parent] && !newBones[boneInfo[*boneRefs].parent] ) ) {
-				R_CalcBone( header, refent, boneInfo[*boneRefs].parent );
+			if ( boneInfo[*boneRefs].parent >= 0 && !newBones[boneInfo[*boneRefs].parent] ) {
+				if ( !validBones[boneInfo[*boneRefs].parent] ) {
+					R_CalcBone( header, refent, boneInfo[*boneRefs].parent );
+					oldBones[boneInfo[*boneRefs].parent] = bones[boneInfo[*boneRefs].parent];
+					backEnd.pc.c_bonesComputed++;
+				} else {
+					// another entity may have used bones[] since it was cached
+					bones[boneInfo[*boneRefs].parent] = rawBones[boneInfo[*boneRefs].parent];
+				}
 			}
 
 			R_CalcBone( header, refent, *boneRefs );
+			backEnd.pc.c_bonesComputed++;
 
 		}
 
@@ -1095,15 +1180,24 @@ void R_CalcBones( mdsHeader_t *header, const refEntity_t *refent, int *boneList,
 			if ( validBones[*boneRefs] ) {
 				// this bone is still in the cache
 				bones[*boneRefs] = rawBones[*boneRefs];
+				backEnd.pc.c_bonesCached++;
 				continue;
 			}
 
 			// find our parent, and make sure it has been calculated
-			if ( ( boneInfo[*boneRefs].parent >= 0 ) && ( !validBones[boneInfo[*boneRefs].parent] && !newBones[boneInfo[*boneRefs].parent] ) ) {
-				R_CalcBoneLerp( header, refent, boneInfo[*boneRefs].parent );
+			if ( boneInfo[*boneRefs].parent >= 0 && !newBones[boneInfo[*boneRefs].parent] ) {
+				if ( !validBones[boneInfo[*boneRefs].parent] ) {
+					R_CalcBoneLerp( header, refent, boneInfo[*boneRefs].parent );
+					oldBones[boneInfo[*boneRefs].parent] = bones[boneInfo[*boneRefs].parent];
+					backEnd.pc.c_bonesComputed++;
+				} else {
+					// another entity may have used bones[] since it was cached
+					bones[boneInfo[*boneRefs].parent] = rawBones[boneInfo[*boneRefs].parent];
+				}
 			}
 
 			R_CalcBoneLerp( header, refent, *boneRefs );
+			backEnd.pc.c_bonesComputed++;
 
 		}
 
@@ -1158,8 +1252,11 @@ void R_CalcBones( mdsHeader_t *header, const refEntity_t *refent, int *boneList,
 		}
 	}
 
-	// backup the final bones
-	memcpy( oldBones, bones, sizeof( bones[0] ) * header->numBones );
+	// backup the final bones, bones[] outside the list may belong to another entity
+	boneRefs = boneList;
+	for ( i = 0; i < numBones; i++, boneRefs++ ) {
+		oldBones[ *boneRefs ] = bones[ *boneRefs ];
+	}
 }
 
 #ifdef DBG_PROFILE_BONES
@@ -1168,13 +1265,190 @@ void R_CalcBones( mdsHeader_t *header, const refEntity_t *refent, int *boneList,
 #define DBG_SHOWTIME    ;
 #endif
 
+/*
+==============
+RB_SkinVertexes
+
+	Reference skinning, transforms each vertex by its weighted bones[]
+==============
+*/
+static void RB_SkinVertexes( mdsVertex_t *vert, int count, vec4_t *xyz, vec4_t *normal, vec2_t ( *texCoords )[2] ) {
+	mdsWeight_t     *w;
+	mdsBoneFrame_t  *b;
+	int j, k;
+
+	for ( j = 0; j < count; j++, xyz++, normal++, texCoords++ ) {
+		VectorClear( *xyz );
+
+		w = vert->weights;
+		for ( k = 0 ; k < vert->numWeights ; k++, w++ ) {
+			b = &bones[w->boneIndex];
+			LocalAddScaledMatrixTransformVectorTranslate( w->offset, w->boneWeight, b->matrix, b->translation, *xyz );
+		}
+		LocalMatrixTransformVector( vert->normal, bones[vert->weights[0].boneIndex].matrix, *normal );
+
+		( *texCoords )[0][0] = vert->texCoords[0];
+		( *texCoords )[0][1] = vert->texCoords[1];
+
+		vert = (mdsVertex_t *)&vert->weights[vert->numWeights];
+	}
+}
+
+#ifdef MDS_SIMD_SKINNING
+
+// the bones of the current surface as the columns of a 3x4 matrix, so a
+// weight is three multiply-adds of whole vectors
+typedef struct {
+	vec4_t col[4];
+} mdsSkinBone_t;
+
+static mdsSkinBone_t skinBones[MDS_MAX_BONES];
+
+/*
+==============
+RB_BuildSkinPalette
+==============
+*/
+static void RB_BuildSkinPalette( int *boneList, int numBones ) {
+	mdsBoneFrame_t  *b;
+	mdsSkinBone_t   *sb;
+	int i, j;
+
+	for ( i = 0; i < numBones; i++, boneList++ ) {
+		b = &bones[*boneList];
+		sb = &skinBones[*boneList];
+		for ( j = 0; j < 3; j++ ) {
+			sb->col[0][j] = b->matrix[j][0];
+			sb->col[1][j] = b->matrix[j][1];
+			sb->col[2][j] = b->matrix[j][2];
+			sb->col[3][j] = b->translation[j];
+		}
+		sb->col[0][3] = sb->col[1][3] = sb->col[2][3] = sb->col[3][3] = 0;
+	}
+}
+
+/*
+==============
+RB_SkinVertexesSIMD
+
+	Same as RB_SkinVertexes, using the palette from RB_BuildSkinPalette.
+	The fourth component of xyz and normal is written as 0.
+==============
+*/
+static void RB_SkinVertexesSIMD( mdsVertex_t *vert, int count, vec4_t *xyz, vec4_t *normal, vec2_t ( *texCoords )[2] ) {
+	mdsWeight_t     *w;
+	mdsSkinBone_t   *sb;
+	int j, k;
+#ifdef __SSE__
+	__m128 acc, tmp;
+#else
+	float32x4_t acc, tmp;
+#endif
+
+	for ( j = 0; j < count; j++, xyz++, normal++, texCoords++ ) {
+		w = vert->weights;
+#ifdef __SSE__
+		acc = _mm_setzero_ps();
+		for ( k = 0 ; k < vert->numWeights ; k++, w++ ) {
+			sb = &skinBones[w->boneIndex];
+			tmp = _mm_add_ps( _mm_loadu_ps( sb->col[3] ), _mm_mul_ps( _mm_loadu_ps( sb->col[0] ), _mm_set1_ps( w->offset[0] ) ) );
+			tmp = _mm_add_ps( tmp, _mm_mul_ps( _mm_loadu_ps( sb->col[1] ), _mm_set1_ps( w->offset[1] ) ) );
+			tmp = _mm_add_ps( tmp, _mm_mul_ps( _mm_loadu_ps( sb->col[2] ), _mm_set1_ps( w->offset[2] ) ) );
+			acc = _mm_add_ps( acc, _mm_mul_ps( tmp, _mm_set1_ps( w->boneWeight ) ) );
+		}
+		_mm_storeu_ps( *xyz, acc );
+
+		sb = &skinBones[vert->weights[0].boneIndex];
+		tmp = _mm_mul_ps( _mm_loadu_ps( sb->col[0] ), _mm_set1_ps( vert->normal[0] ) );
+		tmp = _mm_add_ps( tmp, _mm_mul_ps( _mm_loadu_ps( sb->col[1] ), _mm_set1_ps( vert->normal[1] ) ) );
+		tmp = _mm_add_ps( tmp, _mm_mul_ps( _mm_loadu_ps( sb->col[2] ), _mm_set1_ps( vert->normal[2] ) ) );
+		_mm_storeu_ps( *normal, tmp );
+#else
+		acc = vdupq_n_f32( 0 );
+		for ( k = 0 ; k < vert->numWeights ; k++, w++ ) {
+			sb = &skinBones[w->boneIndex];
+			tmp = vmlaq_n_f32( vld1q_f32( sb->col[3] ), vld1q_f32( sb->col[0] ), w->offset[0] );
+			tmp = vmlaq_n_f32( tmp, vld1q_f32( sb->col[1] ), w->offset[1] );
+			tmp = vmlaq_n_f32( tmp, vld1q_f32( sb->col[2] ), w->offset[2] );
+			acc = vmlaq_n_f32( acc, tmp, w->boneWeight );
+		}
+		vst1q_f32( *xyz, acc );
+
+		sb = &skinBones[vert->weights[0].boneIndex];
+		tmp = vmulq_n_f32( vld1q_f32( sb->col[0] ), vert->normal[0] );
+		tmp = vmlaq_n_f32( tmp, vld1q_f32( sb->col[1] ), vert->normal[1] );
+		tmp = vmlaq_n_f32( tmp, vld1q_f32( sb->col[2] ), vert->normal[2] );
+		vst1q_f32( *normal, tmp );
+#endif
+
+		( *texCoords )[0][0] = vert->texCoords[0];
+		( *texCoords )[0][1] = vert->texCoords[1];
+
+		vert = (mdsVertex_t *)&vert->weights[vert->numWeights];
+	}
+}
+
+/*
+==============
+RB_CheckSkinning
+
+	r_bonesDebug 5, compare the SIMD skinning against the reference path
+==============
+*/
+static void RB_CheckSkinning( mdsVertex_t *vert, int count, vec4_t *xyz ) {
+	vec4_t          *refXyz, *refNormal;
+	vec2_t ( *refTexCoords )[2];
+	float err, maxErr;
+	int j, k, start, scalarMsec, simdMsec;
+	static int simdCheck = 0;
+
+	refXyz = ri.Hunk_AllocateTempMemory( count * ( sizeof( vec4_t ) * 2 + sizeof( vec2_t ) * 2 ) );
+	refNormal = refXyz + count;
+	refTexCoords = ( vec2_t ( * )[2] )( refNormal + count );
+
+	RB_SkinVertexes( vert, count, refXyz, refNormal, refTexCoords );
+
+	maxErr = 0;
+	for ( j = 0; j < count; j++ ) {
+		for ( k = 0; k < 3; k++ ) {
+			err = fabs( refXyz[j][k] - xyz[j][k] );
+			if ( err > maxErr ) {
+				maxErr = err;
+			}
+		}
+	}
+
+	// time both paths over a few hundred runs every so often
+	if ( !( simdCheck++ & 255 ) ) {
+		start = ri.Milliseconds();
+		for ( j = 0; j < 256; j++ ) {
+			RB_SkinVertexes( vert, count, refXyz, refNormal, refTexCoords );
+		}
+		scalarMsec = ri.Milliseconds() - start;
+
+		start = ri.Milliseconds();
+		for ( j = 0; j < 256; j++ ) {
+			RB_SkinVertexesSIMD( vert, count, refXyz, refNormal, refTexCoords );
+		}
+		simdMsec = ri.Milliseconds() - start;
+
+		ri.Printf( PRINT_ALL, "skinning %4d verts x256: scalar %3i msec, simd %3i msec, max error %f\n", count, scalarMsec, simdMsec, maxErr );
+	} else if ( maxErr > 0.01f ) {
+		ri.Printf( PRINT_ALL, "skinning %4d verts: max error %f\n", count, maxErr );
+	}
+
+	ri.Hunk_FreeTempMemory( refXyz );
+}
+
+#endif // MDS_SIMD_SKINNING
+
 /*
 ==============
 RB_SurfaceAnim
 ==============
 */
 void RB_SurfaceAnim( mdsSurface_t *surface ) {
-	int i, j, k;
+	int i, j;
 	refEntity_t *refent;
 	int             *boneList;
 	mdsHeader_t     *header;
@@ -1312,25 +1586,16 @@ void RB_SurfaceAnim( mdsSurface_t *surface ) {
 	//
 	numVerts = surface->numVerts;
 	v = ( mdsVertex_t * )( (byte *)surface + surface->ofsVerts );
-	tempVert = ( float * )( tess.xyz + baseVertex );
-	tempNormal = ( float * )( tess.normal + baseVertex );
-	for ( j = 0; j < render_count; j++, tempVert += 4, tempNormal += 4 ) {
-		mdsWeight_t *w;
+#ifdef MDS_SIMD_SKINNING
+	RB_BuildSkinPalette( boneList, surface->numBoneReferences );
+	RB_SkinVertexesSIMD( v, render_count, tess.xyz + baseVertex, tess.normal + baseVertex, tess.texCoords + baseVertex );
 
-		VectorClear( tempVert );
-
-		w = v->weights;
-		for ( k = 0 ; k < v->numWeights ; k++, w++ ) {
-			bone = &bones[w->boneIndex];
-			LocalAddScaledMatrixTransformVectorTranslate( w->offset, w->boneWeight, bone->matrix, bone->translation, tempVert );
-		}
-		LocalMatrixTransformVector( v->normal, bones[v->weights[0].boneIndex].matrix, tempNormal );
-
-		tess.texCoords[baseVertex + j][0][0] = v->texCoords[0];
-		tess.texCoords[baseVertex + j][0][1] = v->texCoords[1];
-
-		v = (mdsVertex_t *)&v->weights[v->numWeights];
+	if ( r_bonesDebug->integer == 5 ) {
+		RB_CheckSkinning( v, render_count, tess.xyz + baseVertex );
 	}
+#else
+	RB_SkinVertexes( v, render_count, tess.xyz + baseVertex, tess.normal + baseVertex, tess.texCoords + baseVertex );
+#endif
 
 	DBG_SHOWTIME
 
@@ -1422,8 +1687,8 @@ void RB_SurfaceAnim( mdsSurface_t *surface ) {
 		}
 	}
 
-	if ( r_bonesDebug->integer > 1 ) {
-		// dont draw the actual surface
+	if ( r_bonesDebug->integer > 1 && r_bonesDebug->integer != 5 ) {
+		// dont draw the actual surface, the skinning check (5) still draws it
 		tess.numIndexes = oldIndexes;
 		tess.numVertexes = baseVertex;
 		return;
@@ -1322,20 +1322,15 @@ const void  *RB_SetColor( const void *data ) {
 
 /*
 =============
-RB_StretchPic
+RB_StretchQuad
+
+Appends a 2D quad, only flushing the surface when the shader changes
 =============
 */
-const void *RB_StretchPic( const void *data ) {
-	const stretchPicCommand_t   *cmd;
-	shader_t *shader;
+static void RB_StretchQuad( shader_t *shader, float x, float y, float w, float h,
+							float s1, float t1, float s2, float t2, const byte *color ) {
 	int numVerts, numIndexes;
-	cmd = (const stretchPicCommand_t *)data;
 
-	if ( !backEnd.projection2D ) {
-		RB_SetGL2D();
-	}
-
-	shader = cmd->shader;
 	if ( shader != tess.shader ) {
 		if ( tess.numIndexes ) {
 			RB_EndSurface();
@@ -1361,39 +1356,84 @@ const void *RB_StretchPic( const void *data ) {
 	*(int *)tess.vertexColors[ numVerts ] =
 		*(int *)tess.vertexColors[ numVerts + 1 ] =
 			*(int *)tess.vertexColors[ numVerts + 2 ] =
-				*(int *)tess.vertexColors[ numVerts + 3 ] = *(int *)backEnd.color2D;
+				*(int *)tess.vertexColors[ numVerts + 3 ] = *(const int *)color;
 
-	tess.xyz[ numVerts ][0] = cmd->x;
-	tess.xyz[ numVerts ][1] = cmd->y;
+	tess.xyz[ numVerts ][0] = x;
+	tess.xyz[ numVerts ][1] = y;
 	tess.xyz[ numVerts ][2] = 0;
 
-	tess.texCoords[ numVerts ][0][0] = cmd->s1;
-	tess.texCoords[ numVerts ][0][1] = cmd->t1;
+	tess.texCoords[ numVerts ][0][0] = s1;
+	tess.texCoords[ numVerts ][0][1] = t1;
 
-	tess.xyz[ numVerts + 1 ][0] = cmd->x + cmd->w;
-	tess.xyz[ numVerts + 1 ][1] = cmd->y;
+	tess.xyz[ numVerts + 1 ][0] = x + w;
+	tess.xyz[ numVerts + 1 ][1] = y;
 	tess.xyz[ numVerts + 1 ][2] = 0;
 
-	tess.texCoords[ numVerts + 1 ][0][0] = cmd->s2;
-	tess.texCoords[ numVerts + 1 ][0][1] = cmd->t1;
+	tess.texCoords[ numVerts + 1 ][0][0] = s2;
+	tess.texCoords[ numVerts + 1 ][0][1] = t1;
 
-	tess.xyz[ numVerts + 2 ][0] = cmd->x + cmd->w;
-	tess.xyz[ numVerts + 2 ][1] = cmd->y + cmd->h;
+	tess.xyz[ numVerts + 2 ][0] = x + w;
+	tess.xyz[ numVerts + 2 ][1] = y + h;
 	tess.xyz[ numVerts + 2 ][2] = 0;
 
-	tess.texCoords[ numVerts + 2 ][0][0] = cmd->s2;
-	tess.texCoords[ numVerts + 2 ][0][1] = cmd->t2;
+	tess.texCoords[ numVerts + 2 ][0][0] = s2;
+	tess.texCoords[ numVerts + 2 ][0][1] = t2;
 
-	tess.xyz[ numVerts + 3 ][0] = cmd->x;
-	tess.xyz[ numVerts + 3 ][1] = cmd->y + cmd->h;
+	tess.xyz[ numVerts + 3 ][0] = x;
+	tess.xyz[ numVerts + 3 ][1] = y + h;
 	tess.xyz[ numVerts + 3 ][2] = 0;
 
-	tess.texCoords[ numVerts + 3 ][0][0] = cmd->s1;
-	tess.texCoords[ numVerts + 3 ][0][1] = cmd->t2;
+	tess.texCoords[ numVerts + 3 ][0][0] = s1;
+	tess.texCoords[ numVerts + 3 ][0][1] = t2;
+}
+
+/*
+=============
+RB_StretchPic
+=============
+*/
+const void *RB_StretchPic( const void *data ) {
+	const stretchPicCommand_t   *cmd;
+	cmd = (const stretchPicCommand_t *)data;
+
+	if ( !backEnd.projection2D ) {
+		RB_SetGL2D();
+	}
+
+	RB_StretchQuad( cmd->shader, cmd->x, cmd->y, cmd->w, cmd->h,
+					cmd->s1, cmd->t1, cmd->s2, cmd->t2, backEnd.color2D );
 
 	return (const void *)( cmd + 1 );
 }
 
+/*
+=============
+RB_DrawText
+
+All the glyphs of a string, with their own colors, so a string drawn
+from a single font atlas ends up in one surface
+=============
+*/
+const void *RB_DrawText( const void *data ) {
+	const drawTextCommand_t *cmd;
+	const textQuad_t *quad;
+	int i;
+
+	cmd = (const drawTextCommand_t *)data;
+	quad = (const textQuad_t *)( cmd + 1 );
+
+	if ( !backEnd.projection2D ) {
+		RB_SetGL2D();
+	}
+
+	for ( i = 0; i < cmd->numQuads; i++, quad++ ) {
+		RB_StretchQuad( quad->shader, quad->x, quad->y, quad->w, quad->h,
+						quad->s1, quad->t1, quad->s2, quad->t2, quad->color );
+	}
+
+	return (const void *)quad;
+}
+
 
 /*
 ==============
@@ -1740,6 +1780,9 @@ void RB_ExecuteRenderCommands( const void *data ) {
 		case RC_STRETCH_PIC_GRADIENT:
 			data = RB_StretchPicGradient( data );
 			break;
+		case RC_DRAW_TEXT:
+			data = RB_DrawText( data );
+			break;
 		case RC_DRAW_SURFS:
 			data = RB_DrawSurfs( data );
 			break;
@@ -135,17 +135,26 @@ static void R_ColorShiftLightingBytes( byte in[4], byte out[4] ) {
 ===============
 R_LoadLightmaps
 
+The 128x128 lightmaps are packed into atlas pages, so surfaces that only
+differ by lightmap end up with the same shader and can be batched
 ===============
 */
 #define LIGHTMAP_SIZE   128
+#define MAX_LIGHTMAP_ATLAS_TILES    16      // 2048 pixels
+
+static int lightmapAtlasTilesX, lightmapAtlasTilesY;
+
 static void R_LoadLightmaps( lump_t *l ) {
 	byte        *buf, *buf_p;
 	int len;
 	MAC_STATIC byte image[LIGHTMAP_SIZE * LIGHTMAP_SIZE * 4];
-	int i, j;
+	byte        *page;
+	int i, j, y, maxTiles, numTiles, tilesPerPage, pageWidth, pageHeight, tile;
 	float maxIntensity = 0;
 	double sumIntensity = 0;
 
+	lightmapAtlasTilesX = lightmapAtlasTilesY = 0;
+
 	len = l->filelen;
 	if ( !len ) {
 		return;
@@ -155,68 +164,162 @@ static void R_LoadLightmaps( lump_t *l ) {
 	// we are about to upload textures
 	R_SyncRenderThread();
 
+	numTiles = len / ( LIGHTMAP_SIZE * LIGHTMAP_SIZE * 3 );
+
+	// pick the smallest power of two page that holds every lightmap,
+	// staying under the size r_lowMemTextureSize would shrink it from
+	maxTiles = glConfig.maxTextureSize / LIGHTMAP_SIZE;
+	if ( r_lowMemTextureSize->integer && r_lowMemTextureSize->integer / LIGHTMAP_SIZE < maxTiles ) {
+		maxTiles = r_lowMemTextureSize->integer / LIGHTMAP_SIZE;
+	}
+	if ( maxTiles > MAX_LIGHTMAP_ATLAS_TILES ) {
+		maxTiles = MAX_LIGHTMAP_ATLAS_TILES;
+	}
+	if ( maxTiles < 1 ) {
+		maxTiles = 1;
+	}
+	lightmapAtlasTilesX = lightmapAtlasTilesY = 1;
+	while ( lightmapAtlasTilesX * lightmapAtlasTilesY < numTiles ) {
+		if ( lightmapAtlasTilesY < lightmapAtlasTilesX ) {
+			lightmapAtlasTilesY <<= 1;
+		} else if ( lightmapAtlasTilesX * 2 <= maxTiles ) {
+			lightmapAtlasTilesX <<= 1;
+		} else {
+			break;
+		}
+	}
+	tilesPerPage = lightmapAtlasTilesX * lightmapAtlasTilesY;
+	pageWidth = lightmapAtlasTilesX * LIGHTMAP_SIZE;
+	pageHeight = lightmapAtlasTilesY * LIGHTMAP_SIZE;
+
 	// create all the lightmaps
-	tr.numLightmaps = len / ( LIGHTMAP_SIZE * LIGHTMAP_SIZE * 3 );
+	tr.numLightmaps = ( numTiles + tilesPerPage - 1 ) / tilesPerPage;
 	if ( tr.numLightmaps == 1 ) {
 		//FIXME: HACK: maps with only one lightmap turn up fullbright for some reason.
 		//this avoids this, but isn't the correct solution.
 		tr.numLightmaps++;
 	}
+	if ( tr.numLightmaps > MAX_LIGHTMAPS ) {
+		ri.Error( ERR_DROP, "R_LoadLightmaps: %i lightmap pages exceeds MAX_LIGHTMAPS", tr.numLightmaps );
+	}
 
 	// if we are in r_vertexLight mode, we don't need the lightmaps at all
 	if ( r_vertexLight->integer || glConfig.hardwareType == GLHW_PERMEDIA2 ) {
+		lightmapAtlasTilesX = lightmapAtlasTilesY = 0;
 		return;
 	}
 
+	page = ri.Hunk_AllocateTempMemory( pageWidth * pageHeight * 4 );
+
 	for ( i = 0 ; i < tr.numLightmaps ; i++ ) {
-		// expand the 24 bit on-disk to 32 bit
-		buf_p = buf + i * LIGHTMAP_SIZE * LIGHTMAP_SIZE * 3;
-
-		if ( r_lightmap->integer == 2 ) { // color code by intensity as development tool	(FIXME: check range)
-			for ( j = 0; j < LIGHTMAP_SIZE * LIGHTMAP_SIZE; j++ )
-			{
-				float r = buf_p[j * 3 + 0];
-				float g = buf_p[j * 3 + 1];
-				float b = buf_p[j * 3 + 2];
-				float intensity;
-				float out[3];
-
-				intensity = 0.33f * r + 0.685f * g + 0.063f * b;
-
-				if ( intensity > 255 ) {
-					intensity = 1.0f;
-				} else {
-					intensity /= 255.0f;
-				}
+		memset( page, 0, pageWidth * pageHeight * 4 );
 
-				if ( intensity > maxIntensity ) {
-					maxIntensity = intensity;
-				}
+		for ( tile = 0 ; tile < tilesPerPage && i * tilesPerPage + tile < numTiles ; tile++ ) {
+			// expand the 24 bit on-disk to 32 bit
+			buf_p = buf + ( i * tilesPerPage + tile ) * LIGHTMAP_SIZE * LIGHTMAP_SIZE * 3;
+
+			if ( r_lightmap->integer == 2 ) { // color code by intensity as development tool	(FIXME: check range)
+				for ( j = 0; j < LIGHTMAP_SIZE * LIGHTMAP_SIZE; j++ )
+				{
+					float r = buf_p[j * 3 + 0];
+					float g = buf_p[j * 3 + 1];
+					float b = buf_p[j * 3 + 2];
+					float intensity;
+					float out[3];
 
-				HSVtoRGB( intensity, 1.00, 0.50, out );
+					intensity = 0.33f * r + 0.685f * g + 0.063f * b;
 
-				image[j * 4 + 0] = out[0] * 255;
-				image[j * 4 + 1] = out[1] * 255;
-				image[j * 4 + 2] = out[2] * 255;
-				image[j * 4 + 3] = 255;
+					if ( intensity > 255 ) {
+						intensity = 1.0f;
+					} else {
+						intensity /= 255.0f;
+					}
+
+					if ( intensity > maxIntensity ) {
+						maxIntensity = intensity;
+					}
 
-				sumIntensity += intensity;
+					HSVtoRGB( intensity, 1.00, 0.50, out );
+
+					image[j * 4 + 0] = out[0] * 255;
+					image[j * 4 + 1] = out[1] * 255;
+					image[j * 4 + 2] = out[2] * 255;
+					image[j * 4 + 3] = 255;
+
+					sumIntensity += intensity;
+				}
+			} else {
+				for ( j = 0 ; j < LIGHTMAP_SIZE * LIGHTMAP_SIZE; j++ ) {
+					R_ColorShiftLightingBytes( &buf_p[j * 3], &image[j * 4] );
+					image[j * 4 + 3] = 255;
+				}
 			}
-		} else {
-			for ( j = 0 ; j < LIGHTMAP_SIZE * LIGHTMAP_SIZE; j++ ) {
-				R_ColorShiftLightingBytes( &buf_p[j * 3], &image[j * 4] );
-				image[j * 4 + 3] = 255;
+
+			// copy into its slot in the page
+			for ( y = 0 ; y < LIGHTMAP_SIZE ; y++ ) {
+				memcpy( page + ( ( ( tile / lightmapAtlasTilesX ) * LIGHTMAP_SIZE + y ) * pageWidth
+								 + ( tile % lightmapAtlasTilesX ) * LIGHTMAP_SIZE ) * 4,
+						image + y * LIGHTMAP_SIZE * 4, LIGHTMAP_SIZE * 4 );
 			}
 		}
-		tr.lightmaps[i] = R_CreateImage( va( "*lightmap%d",i ), image,
-										 LIGHTMAP_SIZE, LIGHTMAP_SIZE, qfalse, qfalse, GL_CLAMP );
+
+		tr.lightmaps[i] = R_CreateImage( va( "*lightmap%d",i ), page,
+										 pageWidth, pageHeight, qfalse, qfalse, GL_CLAMP );
 	}
 
+	ri.Hunk_FreeTempMemory( page );
+
 	if ( r_lightmap->integer == 2 ) {
 		ri.Printf( PRINT_ALL, "Brightest lightmap value: %d\n", ( int ) ( maxIntensity * 255 ) );
 	}
 }
 
+/*
+===============
+R_LightmapAtlasPage
+
+Returns the atlas page that holds a bsp lightmap
+===============
+*/
+static int R_LightmapAtlasPage( int lightmapNum ) {
+	if ( lightmapNum < 0 || !lightmapAtlasTilesX ) {
+		return lightmapNum;
+	}
+	return lightmapNum / ( lightmapAtlasTilesX * lightmapAtlasTilesY );
+}
+
+/*
+===============
+R_LightmapAtlasCoords
+
+Moves a lightmap texcoord into the lightmap's slot of its page.  The
+coordinate is kept half a texel inside the slot so filtering doesn't
+pick up the neighbouring lightmap, which is what clamping gave before.
+===============
+*/
+static void R_LightmapAtlasCoords( int lightmapNum, float *st ) {
+	int tile, i;
+	float offset[2], v;
+
+	if ( lightmapNum < 0 || !lightmapAtlasTilesX ) {
+		return;
+	}
+
+	tile = lightmapNum % ( lightmapAtlasTilesX * lightmapAtlasTilesY );
+	offset[0] = tile % lightmapAtlasTilesX;
+	offset[1] = tile / lightmapAtlasTilesX;
+
+	for ( i = 0 ; i < 2 ; i++ ) {
+		v = st[i];
+		if ( v < 0.5f / LIGHTMAP_SIZE ) {
+			v = 0.5f / LIGHTMAP_SIZE;
+		} else if ( v > 1.0f - 0.5f / LIGHTMAP_SIZE ) {
+			v = 1.0f - 0.5f / LIGHTMAP_SIZE;
+		}
+		st[i] = ( offset[i] + v ) / ( i ? lightmapAtlasTilesY : lightmapAtlasTilesX );
+	}
+}
+
 
 /*
 =================
@@ -361,7 +464,7 @@ static void ParseFace( dsurface_t *ds, drawVert_t *verts, msurface_t *surf, int
 	surf->fogIndex = LittleLong( ds->fogNum ) + 1;
 
 	// get shader value
-	surf->shader = ShaderForShaderNum( ds->shaderNum, lightmapNum );
+	surf->shader = ShaderForShaderNum( ds->shaderNum, R_LightmapAtlasPage( lightmapNum ) );
 	if ( r_singleShader->integer && !surf->shader->isSky ) {
 		surf->shader = tr.defaultShader;
 	}
@@ -397,6 +500,7 @@ static void ParseFace( dsurface_t *ds, drawVert_t *verts, msurface_t *surf, int
 			cv->points[i][3 + j] = LittleFloat( verts[i].st[j] );
 			cv->points[i][5 + j] = LittleFloat( verts[i].lightmap[j] );
 		}
+		R_LightmapAtlasCoords( lightmapNum, &cv->points[i][5] );
 		R_ColorShiftLightingBytes( verts[i].color, (byte *)&cv->points[i][7] );
 	}
 
@@ -438,7 +542,7 @@ static void ParseMesh( dsurface_t *ds, drawVert_t *verts, msurface_t *surf ) {
 	surf->fogIndex = LittleLong( ds->fogNum ) + 1;
 
 	// get shader value
-	surf->shader = ShaderForShaderNum( ds->shaderNum, lightmapNum );
+	surf->shader = ShaderForShaderNum( ds->shaderNum, R_LightmapAtlasPage( lightmapNum ) );
 	if ( r_singleShader->integer && !surf->shader->isSky ) {
 		surf->shader = tr.defaultShader;
 	}
@@ -464,6 +568,7 @@ static void ParseMesh( dsurface_t *ds, drawVert_t *verts, msurface_t *surf ) {
 			points[i].st[j] = LittleFloat( verts[i].st[j] );
 			points[i].lightmap[j] = LittleFloat( verts[i].lightmap[j] );
 		}
+		R_LightmapAtlasCoords( lightmapNum, points[i].lightmap );
 		R_ColorShiftLightingBytes( verts[i].color, points[i].color );
 	}
 
@@ -2168,6 +2273,9 @@ void RE_LoadWorldMap( const char *name ) {
 
 	tr.sunShader = 0;   // clear sunshader so it's not there if the level doesn't specify it
 
+	// cluster surface lists point into the old world
+	R_ClearClusterSurfaces();
+
 	// invalidate fogs (likely to be re-initialized to new values by the current map)
 	// TODO:(SA)this is sort of silly.  I'm going to do a general cleanup on fog stuff
 	//			now that I can see how it's been used.  (functionality can narrow since
@@ -2244,6 +2352,7 @@ void RE_LoadWorldMap( const char *name ) {
 	ri.Cmd_ExecuteText( EXEC_NOW, "updatescreen\n" );
 	R_LoadLightGrid( &header->lumps[LUMP_LIGHTGRID] );
 	ri.Cmd_ExecuteText( EXEC_NOW, "updatescreen\n" );
+	R_BuildOccluders( &s_worldData );
 
 	s_worldData.dataSize = (byte *)ri.Hunk_Alloc( 0, h_low ) - startMarker;
 
@@ -59,7 +59,8 @@ void R_PerformanceCounters( void ) {
 				   tr.pc.c_sphere_cull_md3_in, tr.pc.c_sphere_cull_md3_clip, tr.pc.c_sphere_cull_md3_out,
 				   tr.pc.c_box_cull_md3_in, tr.pc.c_box_cull_md3_clip, tr.pc.c_box_cull_md3_out );
 	} else if ( r_speeds->integer == 3 ) {
-		ri.Printf( PRINT_ALL, "viewcluster: %i\n", tr.viewCluster );
+		ri.Printf( PRINT_ALL, "viewcluster: %i  leafs: %i  cluster surfs: %i  list builds: %i\n",
+				   tr.viewCluster, tr.pc.c_leafs, tr.pc.c_clusterSurfaces, tr.pc.c_clusterListBuilds );
 	} else if ( r_speeds->integer == 4 ) {
 		if ( backEnd.pc.c_dlightVertexes ) {
 			ri.Printf( PRINT_ALL, "dlight srf:%i  culled:%i  verts:%i  tris:%i\n",
@@ -73,9 +74,25 @@ void R_PerformanceCounters( void ) {
 //		ri.Printf( PRINT_ALL, "zFar: %.0f\n", tr.viewParms.zFar );
 //	}
 	else if ( r_speeds->integer == 6 ) {
-		ri.Printf( PRINT_ALL, "flare adds:%i tests:%i renders:%i\n",
-				   backEnd.pc.c_flareAdds, backEnd.pc.c_flareTests, backEnd.pc.c_flareRenders );
+		ri.Printf( PRINT_ALL, "flare adds:%i tests:%i renders:%i  corona traces:%i cached:%i\n",
+				   backEnd.pc.c_flareAdds, backEnd.pc.c_flareTests, backEnd.pc.c_flareRenders,
+				   tr.pc.c_coronaTests, tr.pc.c_coronaCached );
+	} else if ( r_speeds->integer == 7 ) {
+		ri.Printf( PRINT_ALL, "bones computed:%i cached:%i\n",
+				   backEnd.pc.c_bonesComputed, backEnd.pc.c_bonesCached );
+	} else if ( r_speeds->integer == 8 ) {
+		ri.Printf( PRINT_ALL, "occluders:%i  occluded nodes:%i  entities:%i\n",
+				   tr.pc.c_occluders, tr.pc.c_occludedNodes, tr.pc.c_occludedEntities );
 	}
+#ifdef HAVE_GLES
+	else if ( r_speeds->integer == 9 ) {
+		unsigned int bytes, draws, orphans, mergedIn, mergedOut;
+
+		gl4es_stream_stats( &bytes, &draws, &orphans );
+		gl4es_merge_stats( &mergedIn, &mergedOut );
+		ri.Printf( PRINT_ALL, "streamed: %ik in %i draws  orphans:%i  merged: %i -> %i draws\n", bytes / 1024, draws, orphans, mergedIn, mergedOut );
+	}
+#endif
 
 	memset( &tr.pc, 0, sizeof( tr.pc ) );
 	memset( &backEnd.pc, 0, sizeof( backEnd.pc ) );
@@ -335,6 +352,135 @@ void RE_StretchPicGradient( float x, float y, float w, float h,
 //----(SA)	end
 
 
+/*
+=============
+R_GlyphHasImage
+
+Spaces and glyphs the font has no image for only advance the pen
+=============
+*/
+static qboolean R_GlyphHasImage( const glyphInfo_t *glyph ) {
+	return glyph->imageWidth > 0 && glyph->imageHeight > 0 && glyph->glyph;
+}
+
+/*
+=============
+R_TextQuad
+=============
+*/
+static textQuad_t *R_TextQuad( textQuad_t *quad, const glyphInfo_t *glyph, float x, float y,
+							   float xscale, float yscale, const byte *color ) {
+	quad->shader = R_GetShaderByHandle( glyph->glyph );
+	quad->x = x;
+	quad->y = y - glyph->top * yscale;
+	quad->w = glyph->imageWidth * xscale;
+	quad->h = glyph->imageHeight * yscale;
+	quad->s1 = glyph->s;
+	quad->t1 = glyph->t;
+	quad->s2 = glyph->s2;
+	quad->t2 = glyph->t2;
+	*(int *)quad->color = *(const int *)color;
+
+	return quad + 1;
+}
+
+/*
+=============
+RE_DrawText
+
+Queues a whole string as a single command instead of a stretch pic and
+a color change per glyph. x/y is the start of the baseline and
+xscale/yscale convert glyph units to screen pixels; a non zero shadow
+offset draws a black copy of each glyph underneath it.
+=============
+*/
+void RE_DrawText( float x, float y, float xscale, float yscale, float adjust, float shadowX, float shadowY,
+				  const float *rgba, const char *text, int limit, const fontInfo_t *font ) {
+	drawTextCommand_t *cmd;
+	textQuad_t *quad;
+	const unsigned char *s;
+	const glyphInfo_t *glyph;
+	byte textColor[4], shadowColor[4];
+	qboolean shadow;
+	int len, count, numGlyphs, numQuads;
+
+	if ( !tr.registered ) {
+		return;
+	}
+	if ( !text || !font ) {
+		return;
+	}
+	if ( !rgba ) {
+		static float colorWhite[4] = { 1, 1, 1, 1 };
+
+		rgba = colorWhite;
+	}
+
+	len = strlen( text );
+	if ( limit > 0 && len > limit ) {
+		len = limit;
+	}
+
+	// count the visible glyphs so the command is allocated in one go
+	count = 0;
+	numGlyphs = 0;
+	for ( s = (const unsigned char *)text; *s && count < len; s++ ) {
+		if ( Q_IsColorString( s ) ) {
+			s++;
+			continue;
+		}
+		if ( R_GlyphHasImage( &font->glyphs[*s] ) ) {
+			numGlyphs++;
+		}
+		count++;
+	}
+
+	shadow = ( shadowX != 0 || shadowY != 0 );
+	numQuads = shadow ? numGlyphs * 2 : numGlyphs;
+	if ( !numQuads ) {
+		return;
+	}
+
+	cmd = R_GetCommandBuffer( sizeof( *cmd ) + numQuads * sizeof( textQuad_t ) );
+	if ( !cmd ) {
+		return;
+	}
+	cmd->commandId = RC_DRAW_TEXT;
+	cmd->numQuads = numQuads;
+
+	textColor[0] = rgba[0] * 255;
+	textColor[1] = rgba[1] * 255;
+	textColor[2] = rgba[2] * 255;
+	textColor[3] = rgba[3] * 255;
+	shadowColor[0] = shadowColor[1] = shadowColor[2] = 0;
+	shadowColor[3] = textColor[3];
+
+	quad = (textQuad_t *)( cmd + 1 );
+	count = 0;
+	for ( s = (const unsigned char *)text; *s && count < len; s++ ) {
+		if ( Q_IsColorString( s ) ) {
+			// color codes keep the alpha of the caller
+			textColor[0] = g_color_table[ColorIndex( s[1] )][0] * 255;
+			textColor[1] = g_color_table[ColorIndex( s[1] )][1] * 255;
+			textColor[2] = g_color_table[ColorIndex( s[1] )][2] * 255;
+			s++;
+			continue;
+		}
+
+		glyph = &font->glyphs[*s];
+		if ( R_GlyphHasImage( glyph ) ) {
+			if ( shadow ) {
+				quad = R_TextQuad( quad, glyph, x + shadowX, y + shadowY, xscale, yscale, shadowColor );
+			}
+			quad = R_TextQuad( quad, glyph, x, y, xscale, yscale, textColor );
+		}
+
+		x += glyph->xSkip * xscale + adjust;
+		count++;
+	}
+}
+
+
 /*
 ====================
 RE_BeginFrame
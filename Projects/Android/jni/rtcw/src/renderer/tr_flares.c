@@ -299,6 +299,285 @@ void RB_AddCoronaFlares( void ) {
 /*
 ===============================================================================
 
+CORONA VISIBILITY
+
+Coronas are tested against the world on the front end instead of by cgame
+traces.  The segment from the view to each corona is walked through the
+bsp: a solid leaf or an opaque world surface blocks it.  cgame still traces
+against doors, movers and players, which the renderer can't see.  The
+segment starts at the head origin between the eyes, and results are kept
+for the rest of the frame, so the second eye of a stereo pair reuses the
+tests of the first.
+
+===============================================================================
+*/
+
+#define CORONA_VIS_HASH     1024        // corona ids are entity numbers
+#define CORONA_VIS_EPSILON  1.0f        // surfaces the corona sits on don't hide it
+
+typedef struct {
+	int id;
+	int time;
+	vec3_t origin;
+	vec3_t headorg;
+	qboolean visible;
+} coronaVis_t;
+
+static coronaVis_t coronaVis[CORONA_VIS_HASH];
+
+static vec3_t coronaStart, coronaEnd, coronaDir;
+static float coronaLength;
+
+/*
+==================
+R_CoronaHitTriangle
+==================
+*/
+static qboolean R_CoronaHitTriangle( const float *v0, const float *v1, const float *v2 ) {
+	vec3_t e1, e2, p, s, q;
+	float det, u, v, t;
+
+	VectorSubtract( v1, v0, e1 );
+	VectorSubtract( v2, v0, e2 );
+	CrossProduct( coronaDir, e2, p );
+	det = DotProduct( e1, p );
+	if ( det > -0.0001f && det < 0.0001f ) {
+		return qfalse;
+	}
+	det = 1.0f / det;
+
+	VectorSubtract( coronaStart, v0, s );
+	u = DotProduct( s, p ) * det;
+	if ( u < 0 || u > 1 ) {
+		return qfalse;
+	}
+	CrossProduct( s, e1, q );
+	v = DotProduct( coronaDir, q ) * det;
+	if ( v < 0 || u + v > 1 ) {
+		return qfalse;
+	}
+
+	t = DotProduct( e2, q ) * det;
+	return ( t > 0 && t < coronaLength - CORONA_VIS_EPSILON );
+}
+
+/*
+==================
+R_CoronaHitBounds
+==================
+*/
+static qboolean R_CoronaHitBounds( vec3_t bounds[2] ) {
+	int i;
+	float t0, t1, tmin, tmax;
+
+	tmin = 0;
+	tmax = coronaLength;
+	for ( i = 0 ; i < 3 ; i++ ) {
+		if ( coronaDir[i] == 0 ) {
+			if ( coronaStart[i] < bounds[0][i] || coronaStart[i] > bounds[1][i] ) {
+				return qfalse;
+			}
+			continue;
+		}
+		t0 = ( bounds[0][i] - coronaStart[i] ) / coronaDir[i];
+		t1 = ( bounds[1][i] - coronaStart[i] ) / coronaDir[i];
+		if ( t0 > t1 ) {
+			float tmp = t0;
+			t0 = t1;
+			t1 = tmp;
+		}
+		if ( t0 > tmin ) {
+			tmin = t0;
+		}
+		if ( t1 < tmax ) {
+			tmax = t1;
+		}
+		if ( tmin > tmax ) {
+			return qfalse;
+		}
+	}
+	return qtrue;
+}
+
+/*
+==================
+R_CoronaHitSurface
+==================
+*/
+static qboolean R_CoronaHitSurface( msurface_t *surf ) {
+	int i, j;
+	float d0, d1;
+	int                 *indexes;
+	srfSurfaceFace_t    *face;
+	srfGridMesh_t       *grid;
+	drawVert_t          *dv;
+
+	if ( !R_IsOccluderShader( surf->shader ) ) {
+		return qfalse;
+	}
+
+	switch ( *surf->data ) {
+	case SF_FACE:
+		face = (srfSurfaceFace_t *)surf->data;
+		d0 = DotProduct( coronaStart, face->plane.normal ) - face->plane.dist;
+		d1 = DotProduct( coronaEnd, face->plane.normal ) - face->plane.dist;
+		if ( ( d0 > 0 ) == ( d1 > 0 ) ) {
+			return qfalse;
+		}
+		indexes = ( int * )( (byte *)face + face->ofsIndices );
+		for ( i = 0 ; i < face->numIndices ; i += 3 ) {
+			if ( R_CoronaHitTriangle( face->points[indexes[i]], face->points[indexes[i + 1]], face->points[indexes[i + 2]] ) ) {
+				return qtrue;
+			}
+		}
+		return qfalse;
+
+	case SF_GRID:
+		grid = (srfGridMesh_t *)surf->data;
+		if ( !R_CoronaHitBounds( grid->meshBounds ) ) {
+			return qfalse;
+		}
+		for ( i = 0 ; i < grid->height - 1 ; i++ ) {
+			dv = grid->verts + i * grid->width;
+			for ( j = 0 ; j < grid->width - 1 ; j++, dv++ ) {
+				if ( R_CoronaHitTriangle( dv[0].xyz, dv[grid->width].xyz, dv[1].xyz )
+					 || R_CoronaHitTriangle( dv[1].xyz, dv[grid->width].xyz, dv[grid->width + 1].xyz ) ) {
+					return qtrue;
+				}
+			}
+		}
+		return qfalse;
+
+	default:
+		return qfalse;
+	}
+}
+
+/*
+==================
+R_CoronaBlocked_r
+
+Walks the part of the segment from start to end that is inside node
+==================
+*/
+static qboolean R_CoronaBlocked_r( mnode_t *node, const vec3_t in, const vec3_t end ) {
+	float d0, d1, frac;
+	vec3_t start, mid;
+	int i, side;
+	msurface_t  **mark;
+
+	VectorCopy( in, start );
+
+	while ( node->contents == CONTENTS_NODE ) {
+		d0 = DotProduct( start, node->plane->normal ) - node->plane->dist;
+		d1 = DotProduct( end, node->plane->normal ) - node->plane->dist;
+
+		if ( d0 >= 0 && d1 >= 0 ) {
+			node = node->children[0];
+			continue;
+		}
+		if ( d0 < 0 && d1 < 0 ) {
+			node = node->children[1];
+			continue;
+		}
+
+		side = d0 < 0;
+		frac = d0 / ( d0 - d1 );
+		mid[0] = start[0] + frac * ( end[0] - start[0] );
+		mid[1] = start[1] + frac * ( end[1] - start[1] );
+		mid[2] = start[2] + frac * ( end[2] - start[2] );
+
+		if ( R_CoronaBlocked_r( node->children[side], start, mid ) ) {
+			return qtrue;
+		}
+		node = node->children[side ^ 1];
+		VectorCopy( mid, start );
+	}
+
+	// solid leafs have no cluster
+	if ( node->cluster < 0 ) {
+		return qtrue;
+	}
+
+	// detail brushes don't split the tree, so check the surfaces too
+	for ( i = 0, mark = node->firstmarksurface ; i < node->nummarksurfaces ; i++, mark++ ) {
+		if ( R_CoronaHitSurface( *mark ) ) {
+			return qtrue;
+		}
+	}
+
+	return qfalse;
+}
+
+/*
+==================
+R_CoronaVisible
+==================
+*/
+static qboolean R_CoronaVisible( const vec3_t origin ) {
+	vec3_t end;
+
+	VectorCopy( tr.refdef.headorg, coronaStart );
+	VectorCopy( origin, coronaEnd );
+	VectorSubtract( coronaEnd, coronaStart, coronaDir );
+	coronaLength = VectorNormalize( coronaDir );
+	if ( coronaLength <= CORONA_VIS_EPSILON ) {
+		return qtrue;
+	}
+
+	// the leaf the corona is embedded in is not checked for solid
+	VectorMA( coronaEnd, -CORONA_VIS_EPSILON, coronaDir, end );
+
+	return !R_CoronaBlocked_r( tr.world->nodes, coronaStart, end );
+}
+
+/*
+==================
+R_TestCoronas
+
+Clears the visible flag of the scene's coronas that the world hides
+==================
+*/
+void R_TestCoronas( void ) {
+	int i;
+	corona_t    *cor;
+	coronaVis_t *cv;
+	vec3_t delta, viewDelta;
+
+	if ( !r_flares->integer || !tr.world || ( tr.refdef.rdflags & RDF_NOWORLDMODEL ) ) {
+		return;
+	}
+
+	for ( i = 0, cor = tr.refdef.coronas ; i < tr.refdef.num_coronas ; i++, cor++ ) {
+		if ( !( cor->flags & 1 ) ) {
+			continue;
+		}
+
+		// another scene this frame may have tested it already
+		cv = &coronaVis[cor->id & ( CORONA_VIS_HASH - 1 )];
+		VectorSubtract( cor->origin, cv->origin, delta );
+		VectorSubtract( tr.refdef.headorg, cv->headorg, viewDelta );
+		if ( cv->id == cor->id && cv->time == tr.refdef.time && DotProduct( delta, delta ) < 1.0f
+			 && DotProduct( viewDelta, viewDelta ) < 1.0f ) {
+			tr.pc.c_coronaCached++;
+		} else {
+			cv->id = cor->id;
+			cv->time = tr.refdef.time;
+			VectorCopy( cor->origin, cv->origin );
+			VectorCopy( tr.refdef.headorg, cv->headorg );
+			cv->visible = R_CoronaVisible( cor->origin );
+			tr.pc.c_coronaTests++;
+		}
+
+		if ( !cv->visible ) {
+			cor->flags &= ~1;
+		}
+	}
+}
+
+/*
+===============================================================================
+
 FLARE BACK END
 
 ===============================================================================
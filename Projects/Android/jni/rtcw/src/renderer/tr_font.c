@@ -333,6 +333,112 @@ float readFloat() {
 	return me.ffred;
 }
 
+#define FONT_PAGE_SIZE  256
+#define MAX_FONT_PAGES  8
+
+/*
+===============
+R_BuildFontAtlas
+
+Stacks the glyph pages of a pre-rendered font into a single texture so a
+whole string can be drawn without changing shader. The merged image is
+cached as fonts/fontAtlas_<size>.tga when r_saveFontData is set, and
+loaded from there instead of the separate pages when present.
+Pages defined by a shader script are left alone.
+===============
+*/
+static qboolean R_BuildFontAtlas( fontInfo_t *font, int pointSize ) {
+	char pages[MAX_FONT_PAGES][32];
+	int pageOfGlyph[GLYPHS_PER_FONT];
+	int numPages, page, i, width, height, atlasHeight, pageBytes;
+	byte *pic, *atlas, *flipped;
+	char name[MAX_QPATH];
+	image_t *image;
+	qhandle_t h;
+
+	numPages = 0;
+	for ( i = GLYPH_START; i < GLYPH_END; i++ ) {
+		pageOfGlyph[i] = -1;
+		// spaces have no image, RE_DrawText skips them
+		if ( !font->glyphs[i].shaderName[0] || font->glyphs[i].imageWidth <= 0 || font->glyphs[i].imageHeight <= 0 ) {
+			continue;
+		}
+		for ( page = 0; page < numPages; page++ ) {
+			if ( !Q_stricmp( pages[page], font->glyphs[i].shaderName ) ) {
+				break;
+			}
+		}
+		if ( page == numPages ) {
+			if ( numPages == MAX_FONT_PAGES || R_ShaderTextExists( font->glyphs[i].shaderName ) ) {
+				return qfalse;
+			}
+			Q_strncpyz( pages[numPages++], font->glyphs[i].shaderName, sizeof( pages[0] ) );
+		}
+		pageOfGlyph[i] = page;
+	}
+	if ( numPages < 2 ) {
+		return qfalse;
+	}
+
+	for ( atlasHeight = 1; atlasHeight < numPages * FONT_PAGE_SIZE; atlasHeight <<= 1 ) {
+	}
+	if ( atlasHeight > glConfig.maxTextureSize ) {
+		return qfalse;
+	}
+
+	pageBytes = FONT_PAGE_SIZE * FONT_PAGE_SIZE * 4;
+	atlas = Z_Malloc( FONT_PAGE_SIZE * atlasHeight * 4 );
+	Com_Memset( atlas, 0, FONT_PAGE_SIZE * atlasHeight * 4 );
+
+	Com_sprintf( name, sizeof( name ), "fonts/fontAtlas_%i.tga", pointSize );
+	R_LoadImage( name, &pic, &width, &height );
+	if ( pic && width == FONT_PAGE_SIZE && height == atlasHeight ) {
+		memcpy( atlas, pic, pageBytes * numPages );
+	} else {
+		// the loaders share one buffer, so copy each page out before the next load
+		for ( page = 0; page < numPages; page++ ) {
+			Q_strncpyz( name, pages[page], sizeof( name ) );
+			COM_DefaultExtension( name, sizeof( name ), ".tga" );
+			R_LoadImage( name, &pic, &width, &height );
+			if ( !pic || width != FONT_PAGE_SIZE || height != FONT_PAGE_SIZE ) {
+				ri.Printf( PRINT_DEVELOPER, "R_BuildFontAtlas: %s is not a %ix%i page\n", pages[page], FONT_PAGE_SIZE, FONT_PAGE_SIZE );
+				Z_Free( atlas );
+				return qfalse;
+			}
+			memcpy( atlas + page * pageBytes, pic, pageBytes );
+		}
+
+		Com_sprintf( name, sizeof( name ), "fonts/fontAtlas_%i.tga", pointSize );
+
+		if ( r_saveFontData->integer ) {
+			// WriteTGA stores the rows bottom up
+			flipped = Z_Malloc( FONT_PAGE_SIZE * atlasHeight * 4 );
+			for ( i = 0; i < atlasHeight; i++ ) {
+				memcpy( flipped + i * FONT_PAGE_SIZE * 4, atlas + ( atlasHeight - 1 - i ) * FONT_PAGE_SIZE * 4, FONT_PAGE_SIZE * 4 );
+			}
+			WriteTGA( name, flipped, FONT_PAGE_SIZE, atlasHeight );
+			Z_Free( flipped );
+		}
+	}
+
+	COM_StripExtension( name, name );
+	image = R_CreateImage( name, atlas, FONT_PAGE_SIZE, atlasHeight, qfalse, qfalse, GL_CLAMP );
+	h = RE_RegisterShaderFromImage( name, LIGHTMAP_2D, image, qfalse );
+	Z_Free( atlas );
+
+	for ( i = GLYPH_START; i < GLYPH_END; i++ ) {
+		if ( pageOfGlyph[i] < 0 ) {
+			continue;
+		}
+		font->glyphs[i].t = ( pageOfGlyph[i] + font->glyphs[i].t ) * FONT_PAGE_SIZE / atlasHeight;
+		font->glyphs[i].t2 = ( pageOfGlyph[i] + font->glyphs[i].t2 ) * FONT_PAGE_SIZE / atlasHeight;
+		font->glyphs[i].glyph = h;
+		Q_strncpyz( font->glyphs[i].shaderName, name, sizeof( font->glyphs[i].shaderName ) );
+	}
+
+	return qtrue;
+}
+
 void RE_RegisterFont( const char *fontName, int pointSize, fontInfo_t *font ) {
 #ifdef BUILD_FREETYPE
 	FT_Face face;
@@ -398,8 +504,10 @@ void RE_RegisterFont( const char *fontName, int pointSize, fontInfo_t *font ) {
 
 //		memcpy(font, faceData, sizeof(fontInfo_t));
 		Q_strncpyz( font->name, name, sizeof( font->name ) );
-		for ( i = GLYPH_START; i < GLYPH_END; i++ ) {
-			font->glyphs[i].glyph = RE_RegisterShaderNoMip( font->glyphs[i].shaderName );
+		if ( !R_BuildFontAtlas( font, pointSize ) ) {
+			for ( i = GLYPH_START; i < GLYPH_END; i++ ) {
+				font->glyphs[i].glyph = RE_RegisterShaderNoMip( font->glyphs[i].shaderName );
+			}
 		}
 		memcpy( &registeredFont[registeredFontCount++], font, sizeof( fontInfo_t ) );
 		return;
@@ -49,11 +49,15 @@ If you have questions concerning this license or the applicable additional terms
 
 static void LoadBMP( const char *name, byte **pic, int *width, int *height );
 static void LoadTGA( const char *name, byte **pic, int *width, int *height );
-static void LoadJPG( const char *name, byte **pic, int *width, int *height );
+static void LoadJPG( const char *name, byte **pic, int *width, int *height, int *picmip );
 
 static byte s_intensitytable[256];
 static unsigned char s_gammatable[256];
 
+// picmip levels the loader already applied to the image being created,
+// set by R_FindImageFileExt around R_CreateImageExt
+static int imagePicmipDone;
+
 int gl_filter_min = GL_LINEAR_MIPMAP_NEAREST;
 int gl_filter_max = GL_LINEAR;
 
@@ -772,11 +776,11 @@ static void Upload32(   unsigned *data,
 	//
 	if ( picmip ) {
 		if ( characterMip ) {
-			scaled_width >>= r_picmip2->integer;
-			scaled_height >>= r_picmip2->integer;
+			scaled_width >>= r_picmip2->integer - imagePicmipDone;
+			scaled_height >>= r_picmip2->integer - imagePicmipDone;
 		} else {
-			scaled_width >>= r_picmip->integer;
-			scaled_height >>= r_picmip->integer;
+			scaled_width >>= r_picmip->integer - imagePicmipDone;
+			scaled_height >>= r_picmip->integer - imagePicmipDone;
 		}
 	}
 
@@ -1709,7 +1713,7 @@ breakOut:;
 	ri.FS_FreeFile( buffer );
 }
 
-static void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height ) {
+static void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height, int *picmip ) {
 	/* This struct contains the JPEG decompression parameters and pointers to
 	 * working space (which is allocated as needed by the JPEG library).
 	 */
@@ -1772,9 +1776,19 @@ static void LoadJPG( const char *filename, unsigned char **pic, int *width, int
 
 	/* Step 4: set parameters for decompression */
 
-	/* In this example, we don't need to change any of the defaults set by
-	 * jpeg_read_header(), so we do nothing here.
+	/* The integer IDCT is the one with a NEON version, and the one the
+	 * library scales with.  If the image is going to be picmipped, decode
+	 * it at 1/2, 1/4 or 1/8 size directly and tell the caller how many
+	 * picmip levels are left to do.
 	 */
+	cinfo.dct_method = JDCT_ISLOW;
+	if ( picmip && *picmip > 0 ) {
+		int scale = *picmip < 3 ? *picmip : 3;
+
+		cinfo.scale_num = 1;
+		cinfo.scale_denom = 1 << scale;
+		*picmip -= scale;
+	}
 
 	/* Step 5: Start decompressor */
 
@@ -2158,13 +2172,15 @@ void SaveJPG( char * filename, int quality, int image_width, int image_height, u
 
 /*
 =================
-R_LoadImage
+R_LoadImageExt
 
 Loads any of the supported image types into a cannonical
 32 bit format.
+If picmip is given, the loader may already reduce the image by up to
+that many levels, and returns the number of levels left to apply.
 =================
 */
-void R_LoadImage( const char *name, byte **pic, int *width, int *height ) {
+static void R_LoadImageExt( const char *name, byte **pic, int *width, int *height, int *picmip ) {
 	int len;
 
 	*pic = NULL;
@@ -2185,17 +2201,26 @@ void R_LoadImage( const char *name, byte **pic, int *width, int *height ) {
 			altname[len - 3] = 'j';
 			altname[len - 2] = 'p';
 			altname[len - 1] = 'g';
-			LoadJPG( altname, pic, width, height );
+			LoadJPG( altname, pic, width, height, picmip );
 		}
 	} else if ( !Q_stricmp( name + len - 4, ".pcx" ) ) {
 		LoadPCX32( name, pic, width, height );
 	} else if ( !Q_stricmp( name + len - 4, ".bmp" ) ) {
 		LoadBMP( name, pic, width, height );
 	} else if ( !Q_stricmp( name + len - 4, ".jpg" ) ) {
-		LoadJPG( name, pic, width, height );
+		LoadJPG( name, pic, width, height, picmip );
 	}
 }
 
+/*
+=================
+R_LoadImage
+=================
+*/
+void R_LoadImage( const char *name, byte **pic, int *width, int *height ) {
+	R_LoadImageExt( name, pic, width, height, NULL );
+}
+
 
 //----(SA)	modified
 /*
@@ -2213,6 +2238,7 @@ image_t *R_FindImageFileExt( const char *name, qboolean mipmap, qboolean allowPi
 	int width, height;
 	byte    *pic;
 	long hash;
+	int picmip, picmipLeft;
 
 	if ( !name ) {
 		return NULL;
@@ -2257,9 +2283,14 @@ image_t *R_FindImageFileExt( const char *name, qboolean mipmap, qboolean allowPi
 	// done.
 
 	//
-	// load the pic from disk
+	// load the pic from disk, letting the loader do the picmip if it can
 	//
-	R_LoadImage( name, &pic, &width, &height );
+	picmip = 0;
+	if ( allowPicmip ) {
+		picmip = characterMIP ? r_picmip2->integer : r_picmip->integer;
+	}
+	picmipLeft = picmip;
+	R_LoadImageExt( name, &pic, &width, &height, &picmipLeft );
 	if ( pic == NULL ) {                                    // if we dont get a successful load
 // RF, no need to check uppercase on win32 systems
 // TTimo: Duane changed to _DEBUG in all cases
@@ -2275,7 +2306,7 @@ image_t *R_FindImageFileExt( const char *name, qboolean mipmap, qboolean allowPi
 		altname[len - 2] = toupper( altname[len - 2] );   //
 		altname[len - 1] = toupper( altname[len - 1] );   //
 		ri.Printf( PRINT_DEVELOPER, "trying %s...", altname );
-		R_LoadImage( altname, &pic, &width, &height );      //
+		R_LoadImageExt( altname, &pic, &width, &height, &picmipLeft );  //
 		if ( pic == NULL ) {                              // if that fails
 			ri.Printf( PRINT_DEVELOPER, "no\n" );
 			return NULL;                                  // bail
@@ -2286,7 +2317,9 @@ image_t *R_FindImageFileExt( const char *name, qboolean mipmap, qboolean allowPi
 #endif
 	}
 
+	imagePicmipDone = picmip - picmipLeft;
 	image = R_CreateImageExt( ( char * ) name, pic, width, height, mipmap, allowPicmip, characterMIP, glWrapClampMode );
+	imagePicmipDone = 0;
 	//ri.Free( pic );
 	return image;
 }
@@ -87,7 +87,9 @@ cvar_t  *r_drawworld;
 cvar_t  *r_speeds;
 cvar_t  *r_fullbright;
 cvar_t  *r_novis;
+cvar_t  *r_clusterSurfaces;
 cvar_t  *r_nocull;
+cvar_t  *r_occlusion;
 cvar_t  *r_facePlaneCull;
 cvar_t  *r_showcluster;
 cvar_t  *r_nocurves;
@@ -184,6 +186,7 @@ cvar_t  *r_saveFontData;
 // Ridah
 cvar_t  *r_cache;
 cvar_t  *r_cacheShaders;
+cvar_t  *r_compiledShaders;
 cvar_t  *r_cacheModels;
 cvar_t  *r_compressModels;
 cvar_t  *r_exportCompressedModels;
@@ -1145,6 +1148,7 @@ void R_Register( void ) {
 	ri.Cvar_Set( "r_cacheShaders", "0" );
 	r_cacheShaders = ri.Cvar_Get( "r_cacheShaders", "0", CVAR_LATCH );
 //----(SA)	end
+	r_compiledShaders = ri.Cvar_Get( "r_compiledShaders", "1", CVAR_ARCHIVE | CVAR_LATCH );
 
 	r_cacheModels = ri.Cvar_Get( "r_cacheModels", "1", CVAR_LATCH );
 	r_compressModels = ri.Cvar_Get( "r_compressModels", "0", 0 );     // converts MD3 -> MDC at run-time
@@ -1175,7 +1179,9 @@ void R_Register( void ) {
 	r_drawentities = ri.Cvar_Get( "r_drawentities", "1", CVAR_CHEAT );
 	r_ignore = ri.Cvar_Get( "r_ignore", "1", CVAR_CHEAT );
 	r_nocull = ri.Cvar_Get( "r_nocull", "0", CVAR_CHEAT );
+	r_occlusion = ri.Cvar_Get( "r_occlusion", "0", CVAR_ARCHIVE );
 	r_novis = ri.Cvar_Get( "r_novis", "0", CVAR_CHEAT );
+	r_clusterSurfaces = ri.Cvar_Get( "r_clusterSurfaces", "0", CVAR_ARCHIVE );
 	r_showcluster = ri.Cvar_Get( "r_showcluster", "0", CVAR_CHEAT );
 	r_speeds = ri.Cvar_Get( "r_speeds", "0", CVAR_CHEAT );
 	r_verbose = ri.Cvar_Get( "r_verbose", "0", CVAR_CHEAT );
@@ -1299,6 +1305,11 @@ void R_Init( void ) {
 
 	R_InitShaders();
 
+#ifdef HAVE_GLES
+	// compile the emulated fixed pipeline programs now instead of on first use
+	gl4es_warmup_fpe();
+#endif
+
 	R_InitSkins();
 
 	R_ModelInit();
@@ -1393,6 +1404,7 @@ Touch all images to make sure they are resident
 */
 void RE_EndRegistration( void ) {
 	R_SyncRenderThread();
+	R_SaveCompiledShaders();
 	if ( !Sys_LowPhysicalMemory() ) {
 		RB_ShowImages();
 	}
@@ -1459,6 +1471,7 @@ refexport_t *GetRefAPI( int apiVersion, refimport_t *rimp ) {
 	re.SetColor         = RE_SetColor;
 	re.DrawStretchPic   = RE_StretchPic;
 	re.DrawStretchPicGradient   = RE_StretchPicGradient;
+	re.DrawText         = RE_DrawText;
 	re.DrawStretchRaw   = RE_StretchRaw;
 	re.UploadCinematic  = RE_UploadCinematic;
 	re.RegisterFont     = RE_RegisterFont;
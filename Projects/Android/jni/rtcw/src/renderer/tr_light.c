@@ -58,6 +58,31 @@ void R_TransformDlights( int count, dlight_t *dl, orientationr_t *or ) {
 	}
 }
 
+/*
+=============
+R_SetupDlightViewBits
+
+Marks the dynamic lights that reach the view frustum.  A light whose
+sphere is entirely outside can't light any visible pixel, so it is left
+out of every surface and bmodel test for this view.
+=============
+*/
+void R_SetupDlightViewBits( void ) {
+	int i;
+	dlight_t    *dl;
+
+	if ( tr.refdef.num_dlights > 32 ) {
+		tr.refdef.num_dlights = 32 ;
+	}
+
+	tr.viewParms.dlightBits = 0;
+	for ( i = 0, dl = tr.refdef.dlights ; i < tr.refdef.num_dlights ; i++, dl++ ) {
+		if ( R_CullPointAndRadius( dl->origin, dl->radius ) != CULL_OUT ) {
+			tr.viewParms.dlightBits |= 1 << i;
+		}
+	}
+}
+
 /*
 =============
 R_DlightBmodel
@@ -76,6 +101,9 @@ void R_DlightBmodel( bmodel_t *bmodel ) {
 
 	mask = 0;
 	for ( i = 0 ; i < tr.refdef.num_dlights ; i++ ) {
+		if ( !( tr.viewParms.dlightBits & ( 1 << i ) ) ) {
+			continue;
+		}
 		dl = &tr.refdef.dlights[i];
 
 		// see if the point is close enough to the bounds to matter
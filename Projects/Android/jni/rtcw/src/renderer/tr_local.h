@@ -477,6 +477,7 @@ typedef struct {
 	vec3_t viewaxis[3];             // transformation matrix
 	int stereoView;
 	float worldscale;
+	vec3_t headorg;                 // between the eyes, vieworg when not stereo
 
 	int time;                       // time in milliseconds for shader effects and other time dependent rendering issues
 	int rdflags;                    // RDF_NOWORLDMODEL, etc
@@ -562,6 +563,8 @@ typedef struct {
 	vec3_t visBounds[2];
 	float zFar;
 
+	int dlightBits;                 // dlights that reach the frustum
+
 	int dirty;
 
 	glfog_t glFog;                  // fog parameters	//----(SA)	added
@@ -755,6 +758,15 @@ typedef struct {
 	int numSurfaces;
 } bmodel_t;
 
+// large opaque world faces used to fill the occlusion depth buffer
+typedef struct {
+	srfSurfaceFace_t    *face;
+	cullType_t cullType;
+	vec3_t bounds[2];
+	vec3_t center;
+	float area;
+} occluder_t;
+
 typedef struct {
 	char name[MAX_QPATH];               // ie: maps/tim_dm2.bsp
 	char baseName[MAX_QPATH];           // ie: tim_dm2
@@ -779,6 +791,9 @@ typedef struct {
 	int nummarksurfaces;
 	msurface_t  **marksurfaces;
 
+	int numOccluders;
+	occluder_t  *occluders;
+
 	int numfogs;
 	fog_t       *fogs;
 
@@ -900,6 +915,16 @@ typedef struct {
 	int c_leafs;
 	int c_dlightSurfaces;
 	int c_dlightSurfacesCulled;
+
+	int c_occluders;
+	int c_occludedNodes;
+	int c_occludedEntities;
+
+	int c_clusterSurfaces;
+	int c_clusterListBuilds;
+
+	int c_coronaTests;
+	int c_coronaCached;
 } frontEndCounters_t;
 
 #define FOG_TABLE_SIZE      256
@@ -930,6 +955,9 @@ typedef struct {
 	int c_flareTests;
 	int c_flareRenders;
 
+	int c_bonesComputed;
+	int c_bonesCached;
+
 	int msec;               // total msec for backend run
 } backEndCounters_t;
 
@@ -1123,7 +1151,9 @@ extern cvar_t  *r_drawworld;            // disable/enable world rendering
 extern cvar_t  *r_speeds;               // various levels of information display
 extern cvar_t  *r_detailTextures;       // enables/disables detail texturing stages
 extern cvar_t  *r_novis;                // disable/enable usage of PVS
+extern cvar_t  *r_clusterSurfaces;      // walk per-cluster surface lists instead of the bsp tree
 extern cvar_t  *r_nocull;
+extern cvar_t  *r_occlusion;            // software depth buffer occlusion culling, 2 = show occluders
 extern cvar_t  *r_facePlaneCull;        // enables culling of planar surfaces with back side test
 extern cvar_t  *r_nocurves;
 extern cvar_t  *r_showcluster;
@@ -1218,6 +1248,7 @@ extern cvar_t  *r_saveFontData;
 // Ridah
 extern cvar_t  *r_cache;
 extern cvar_t  *r_cacheShaders;
+extern cvar_t  *r_compiledShaders;      // keep parsed shader scripts in shaders.bin
 extern cvar_t  *r_cacheModels;
 
 extern cvar_t  *r_cacheGathering;
@@ -1267,6 +1298,7 @@ int R_CullPointAndRadius( vec3_t origin, float radius );
 int R_CullLocalPointAndRadius( vec3_t origin, float radius );
 
 void R_RotateForEntity( const trRefEntity_t * ent, const viewParms_t * viewParms, orientationr_t * or );
+void R_DebugPolygon( int color, int numPoints, float *points );
 
 /*
 ** GL wrapper/helper functions
@@ -1343,6 +1375,7 @@ image_t     *R_FindImageFileExt( const char *name, qboolean mipmap, qboolean all
 
 image_t     *R_CreateImage( const char *name, const byte *pic, int width, int height, qboolean mipmap
 							, qboolean allowPicmip, int wrapClampMode );
+void        R_LoadImage( const char *name, byte **pic, int *width, int *height );
 //----(SA)	added (didn't want to modify all instances of R_CreateImage()
 image_t     *R_CreateImageExt( const char *name, const byte *pic, int width, int height, qboolean mipmap
 							   , qboolean allowPicmip, qboolean characterMip, int wrapClampMode );
@@ -1378,6 +1411,7 @@ shader_t    *R_FindShader( const char *name, int lightmapIndex, qboolean mipRawI
 shader_t    *R_GetShaderByHandle( qhandle_t hShader );
 shader_t    *R_GetShaderByState( int index, long *cycleTime );
 shader_t *R_FindShaderByName( const char *name );
+qboolean    R_ShaderTextExists( const char *name );
 void        R_InitShaders( void );
 void        R_ShaderList_f( void );
 void    R_RemapShader( const char *oldShader, const char *newShader, const char *timeOffset );
@@ -1405,6 +1439,13 @@ void GLimp_SetGamma( unsigned char red[256],
 					 unsigned char green[256],
 					 unsigned char blue[256] );
 
+#ifdef HAVE_GLES
+// gl4es extensions
+void gl4es_warmup_fpe( void );
+void gl4es_stream_stats( unsigned int *bytes, unsigned int *draws, unsigned int *orphans );
+void gl4es_merge_stats( unsigned int *in, unsigned int *out );
+#endif
+
 
 /*
 ====================================================================
@@ -1457,6 +1498,7 @@ void RB_BeginSurface( shader_t *shader, int fogNum );
 void RB_EndSurface( void );
 void RB_CheckOverflow( int verts, int indexes );
 #define RB_CHECKOVERFLOW( v,i ) if ( tess.numVertexes + ( v ) >= SHADER_MAX_VERTEXES || tess.numIndexes + ( i ) >= SHADER_MAX_INDEXES ) {RB_CheckOverflow( v,i );}
+void R_ClearMeshCache( void );
 
 void RB_StageIteratorGeneric( void );
 void RB_StageIteratorSky( void );
@@ -1480,6 +1522,7 @@ WORLD MAP
 
 void R_AddBrushModelSurfaces( trRefEntity_t *e );
 void R_AddWorldSurfaces( void );
+void R_ClearClusterSurfaces( void );
 
 
 /*
@@ -1491,6 +1534,7 @@ FLARES
 */
 
 void R_ClearFlares( void );
+void R_TestCoronas( void );
 
 void RB_AddFlare( void *surface, int fogNum, vec3_t point, vec3_t color, float scale, vec3_t normal, int id, int flags ); // TTimo updated prototype
 void RB_AddDlightFlares( void );
@@ -1505,6 +1549,7 @@ LIGHTS
 */
 
 void R_DlightBmodel( bmodel_t *bmodel );
+void R_SetupDlightViewBits( void );
 void R_SetupEntityLighting( const trRefdef_t *refdef, trRefEntity_t *ent );
 void R_TransformDlights( int count, dlight_t * dl, orientationr_t * or );
 int R_LightForPoint( vec3_t point, vec3_t ambientLight, vec3_t directedLight, vec3_t lightDir );
@@ -1519,12 +1564,30 @@ SHADOWS
 */
 
 void RB_ShadowTessEnd( void );
+void RB_AddShadowSurface( void *surf, int numTriangles );
+void R_BuildShadowEdges( void *surf, const int *triangles, int numTriangles );
+void R_ClearShadowEdges( void );
 void RB_ShadowFinish( void );
 void RB_ProjectionShadowDeform( void );
 
 /*
 ============================================================
 
+OCCLUSION
+
+============================================================
+*/
+
+qboolean R_IsOccluderShader( shader_t *shader );
+void R_BuildOccluders( world_t *w );
+void R_SetupOcclusion( void );
+qboolean R_OcclusionCullBox( const vec3_t mins, const vec3_t maxs );
+qboolean R_OcclusionCullEntity( trRefEntity_t *ent );
+void R_DebugOcclusion( void );
+
+/*
+============================================================
+
 SKIES
 
 ============================================================
@@ -1600,6 +1663,7 @@ void R_MakeAnimModel( model_t *model );
 void R_AddAnimSurfaces( trRefEntity_t *ent );
 void RB_SurfaceAnim( mdsSurface_t *surfType );
 int R_GetBoneTag( orientation_t *outTag, mdsHeader_t *mds, int startTagIndex, const refEntity_t *refent, const char *tagName );
+void R_ClearBoneCache( void );
 
 /*
 =============================================================
@@ -1614,12 +1678,9 @@ void    RB_DeformTessGeometry( void );
 void    RB_CalcEnvironmentTexCoords( float *dstTexCoords );
 void    RB_CalcFireRiseEnvTexCoords( float *st );
 void    RB_CalcFogTexCoords( float *dstTexCoords );
-void    RB_CalcScrollTexCoords( const float scroll[2], float *dstTexCoords );
-void    RB_CalcRotateTexCoords( float rotSpeed, float *dstTexCoords );
-void    RB_CalcScaleTexCoords( const float scale[2], float *dstTexCoords );
-void    RB_CalcSwapTexCoords( float *dstTexCoords );
 void    RB_CalcTurbulentTexCoords( const waveForm_t *wf, float *dstTexCoords );
 void    RB_CalcTransformTexCoords( const texModInfo_t *tmi, float *dstTexCoords );
+qboolean RB_ConcatTexMod( texModInfo_t *tmi, const texModInfo_t *tm );
 void    RB_CalcModulateColorsByFog( unsigned char *dstColors );
 void    RB_CalcModulateAlphasByFog( unsigned char *dstColors );
 void    RB_CalcModulateRGBAsByFog( unsigned char *dstColors );
@@ -1627,7 +1688,6 @@ void    RB_CalcWaveAlpha( const waveForm_t *wf, unsigned char *dstColors );
 void    RB_CalcWaveColor( const waveForm_t *wf, unsigned char *dstColors );
 void    RB_CalcAlphaFromEntity( unsigned char *dstColors );
 void    RB_CalcAlphaFromOneMinusEntity( unsigned char *dstColors );
-void    RB_CalcStretchTexCoords( const waveForm_t *wf, float *texCoords );
 void    RB_CalcColorFromEntity( unsigned char *dstColors );
 void    RB_CalcColorFromOneMinusEntity( unsigned char *dstColors );
 void    RB_CalcSpecularAlpha( unsigned char *alphas );
@@ -1702,6 +1762,20 @@ typedef struct {
 	int gradientType;       //----(SA)	added
 } stretchPicCommand_t;
 
+typedef struct {
+	shader_t    *shader;
+	float x, y;
+	float w, h;
+	float s1, t1;
+	float s2, t2;
+	byte color[4];
+} textQuad_t;
+
+typedef struct {
+	int commandId;
+	int numQuads;           // followed by numQuads textQuad_t
+} drawTextCommand_t;
+
 typedef struct {
 	int commandId;
 	trRefdef_t refdef;
@@ -1715,6 +1789,7 @@ typedef enum {
 	RC_SET_COLOR,
 	RC_STRETCH_PIC,
 	RC_STRETCH_PIC_GRADIENT,    // (SA) added
+	RC_DRAW_TEXT,
 	RC_DRAW_SURFS,
 	RC_DRAW_BUFFER,
 	RC_SWAP_BUFFERS,
@@ -1772,6 +1847,8 @@ void RE_StretchPic( float x, float y, float w, float h,
 					float s1, float t1, float s2, float t2, qhandle_t hShader );
 void RE_StretchPicGradient( float x, float y, float w, float h,
 							float s1, float t1, float s2, float t2, qhandle_t hShader, const float *gradientColor, int gradientType );
+void RE_DrawText( float x, float y, float xscale, float yscale, float adjust, float shadowX, float shadowY,
+				  const float *rgba, const char *text, int limit, const fontInfo_t *font );
 void RE_BeginFrame( stereoFrame_t stereoFrame );
 void RE_EndFrame( int stereoFrame, int *frontEndMsec, int *backEndMsec );
 void RE_SubmitStereoFrame();
@@ -1808,6 +1885,7 @@ shader_t *R_FindCachedShader( const char *name, int lightmapIndex, int hash );
 void R_BackupShaders( void );
 void R_PurgeShaders( int count );
 void R_LoadCacheShaders( void );
+void R_SaveCompiledShaders( void );
 // done.
 
 //------------------------------------------------------------------------------
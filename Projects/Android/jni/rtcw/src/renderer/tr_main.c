@@ -811,26 +811,18 @@ static void SetFarClip( void ) {
 
 /*
 ===============
-R_SetupProjection
+R_SetupProjectionXY
+
+The x and y rows of the projection matrix only depend on the
+field of view, so they are known before the world is walked
 ===============
 */
-void R_SetupProjection( void ) {
+static void R_SetupProjectionXY( void ) {
 	float xmin, xmax, ymin, ymax;
-	float width, height, depth;
-	float zNear, zFar;
-
-	// dynamically compute far clip plane distance
-	SetFarClip();
+	float width, height;
+	float zNear;
 
-	//
-	// set up projection matrix
-	//
 	zNear   = r_znear->value;
-	if ( r_zfar->value ) {
-		zFar = r_zfar->value;   // (SA) allow override for helping level designers test fog distances
-	} else {
-		zFar = tr.viewParms.zFar;
-	}
 
 	ymax = zNear * tan( tr.refdef.fov_y * M_PI / 360.0f );
 	ymin = -ymax;
@@ -840,7 +832,6 @@ void R_SetupProjection( void ) {
 
 	width = xmax - xmin;
 	height = ymax - ymin;
-	depth = zFar - zNear;
 
 	tr.viewParms.projectionMatrix[0] = 2 * zNear / width;
 	tr.viewParms.projectionMatrix[4] = 0;
@@ -852,17 +843,42 @@ void R_SetupProjection( void ) {
 	tr.viewParms.projectionMatrix[9] = ( ymax + ymin ) / height;    // normally 0
 	tr.viewParms.projectionMatrix[13] = 0;
 
-	tr.viewParms.projectionMatrix[2] = 0;
-	tr.viewParms.projectionMatrix[6] = 0;
-	tr.viewParms.projectionMatrix[10] = -( zFar + zNear ) / depth;
-	tr.viewParms.projectionMatrix[14] = -2 * zFar * zNear / depth;
-
 	tr.viewParms.projectionMatrix[3] = 0;
 	tr.viewParms.projectionMatrix[7] = 0;
 	tr.viewParms.projectionMatrix[11] = -1;
 	tr.viewParms.projectionMatrix[15] = 0;
 }
 
+/*
+===============
+R_SetupProjection
+===============
+*/
+void R_SetupProjection( void ) {
+	float depth;
+	float zNear, zFar;
+
+	// dynamically compute far clip plane distance
+	SetFarClip();
+
+	//
+	// set up projection matrix
+	//
+	zNear   = r_znear->value;
+	if ( r_zfar->value ) {
+		zFar = r_zfar->value;   // (SA) allow override for helping level designers test fog distances
+	} else {
+		zFar = tr.viewParms.zFar;
+	}
+
+	depth = zFar - zNear;
+
+	tr.viewParms.projectionMatrix[2] = 0;
+	tr.viewParms.projectionMatrix[6] = 0;
+	tr.viewParms.projectionMatrix[10] = -( zFar + zNear ) / depth;
+	tr.viewParms.projectionMatrix[14] = -2 * zFar * zNear / depth;
+}
+
 /*
 =================
 R_SetupFrustum
@@ -1710,6 +1726,9 @@ void R_AddEntitySurfaces( void ) {
 			R_RotateForEntity( ent, &tr.viewParms, &tr.or );
 
 			tr.currentModel = R_GetModelByHandle( ent->e.hModel );
+			if ( tr.currentModel && R_OcclusionCullEntity( ent ) ) {
+				break;
+			}
 			if ( !tr.currentModel ) {
 // GR - not tessellated
 				R_AddDrawSurf( &entitySurface, tr.defaultShader, 0, 0, ATI_TESS_NONE );
@@ -1757,6 +1776,13 @@ R_GenerateDrawSurfs
 ====================
 */
 void R_GenerateDrawSurfs( void ) {
+	R_SetupDlightViewBits();
+
+	// the occlusion rasterizer projects with the real matrix
+	R_SetupProjectionXY();
+
+	R_SetupOcclusion();
+
 	R_AddWorldSurfaces();
 
 	R_AddPolygonSurfaces();
@@ -1891,6 +1917,7 @@ void R_RenderView( viewParms_t *parms ) {
 	// draw main system development information (surface outlines, etc)
 	R_FogOff();
 	R_DebugGraphics();
+	R_DebugOcclusion();
 	R_FogOn();
 
 }
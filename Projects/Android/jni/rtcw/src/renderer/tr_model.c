@@ -37,6 +37,7 @@ static qboolean R_LoadMDC( model_t *mod, int lod, void *buffer, const char *mod_
 // done.
 static qboolean R_LoadMD3( model_t *mod, int lod, void *buffer, const char *name );
 static qboolean R_LoadMDS( model_t *mod, void *buffer, const char *name );
+static void R_BuildModelShadowEdges( model_t *mod, int lod );
 
 model_t *loadmodel;
 
@@ -253,6 +254,9 @@ qhandle_t RE_RegisterModel( const char *name ) {
 		} else {
 			mod->numLods++;
 			numLoaded++;
+			if ( r_shadows->integer == 2 ) {
+				R_BuildModelShadowEdges( mod, lod );
+			}
 			// if we have a valid model and are biased
 			// so that we won't see any higher detail ones,
 			// stop loading them
@@ -704,6 +708,33 @@ static qboolean R_MDC_ConvertMD3( model_t *mod, int lod, const char *mod_name )
 	return qtrue;
 }
 
+/*
+=================
+R_BuildModelShadowEdges
+=================
+*/
+static void R_BuildModelShadowEdges( model_t *mod, int lod ) {
+	md3Surface_t    *surf;
+	mdcSurface_t    *cSurf;
+	int i;
+
+	if ( mod->md3[lod] ) {
+		surf = ( md3Surface_t * )( (byte *)mod->md3[lod] + mod->md3[lod]->ofsSurfaces );
+		for ( i = 0 ; i < mod->md3[lod]->numSurfaces ; i++ ) {
+			R_BuildShadowEdges( surf, ( int * )( (byte *)surf + surf->ofsTriangles ), surf->numTriangles );
+			surf = ( md3Surface_t * )( (byte *)surf + surf->ofsEnd );
+		}
+	}
+
+	if ( mod->mdc[lod] ) {
+		cSurf = ( mdcSurface_t * )( (byte *)mod->mdc[lod] + mod->mdc[lod]->ofsSurfaces );
+		for ( i = 0 ; i < mod->mdc[lod]->numSurfaces ; i++ ) {
+			R_BuildShadowEdges( cSurf, ( int * )( (byte *)cSurf + cSurf->ofsTriangles ), cSurf->numTriangles );
+			cSurf = ( mdcSurface_t * )( (byte *)cSurf + cSurf->ofsEnd );
+		}
+	}
+}
+
 /*
 =================
 R_LoadMDC
@@ -1331,6 +1362,11 @@ void R_ModelInit( void ) {
 	mod = R_AllocModel();
 	mod->type = MOD_BAD;
 
+	// model handles are about to be reused
+	R_ClearBoneCache();
+	R_ClearMeshCache();
+	R_ClearShadowEdges();
+
 	// Ridah, load in the cacheModels
 	R_LoadCacheModels();
 	// done.
@@ -0,0 +1,749 @@
+/*
+===========================================================================
+
+Return to Castle Wolfenstein single player GPL Source Code
+Copyright (C) 1999-2010 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Return to Castle Wolfenstein single player GPL Source Code (RTCW SP Source Code).
+
+RTCW SP Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+RTCW SP Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RTCW SP Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the RTCW SP Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the RTCW SP Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+// tr_occlusion.c -- coarse software depth buffer for occlusion culling
+
+#include "tr_local.h"
+
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+#elif defined( __SSE__ )
+#include <xmmintrin.h>
+#endif
+
+/*
+
+  Large opaque world faces are picked as occluders when the map loads.
+  Every view, the ones that cover the most of the screen are rasterized
+  into a small depth buffer, and nodes and entities whose screen rectangle
+  is completely behind them are rejected before any surfaces are added.
+
+  The test is conservative: an occluder only writes the pixels it covers
+  completely, and it writes the depth of its farthest point, so anything
+  that is culled could not have drawn a single pixel.
+
+*/
+
+#define OCCLUSION_WIDTH         256
+#define OCCLUSION_HEIGHT        128
+
+#define OCCLUDER_MIN_AREA       ( 128 * 128 )
+#define OCCLUDER_MIN_SCORE      0.01f           // area / distance squared
+#define MAX_OCCLUDER_POINTS     64
+#define MAX_VIEW_OCCLUDERS      64
+
+#define OCCLUSION_CLEAR_DEPTH   1e30f
+
+static float occlusionDepth[OCCLUSION_HEIGHT * OCCLUSION_WIDTH];
+
+static qboolean occlusionActive;
+static vec3_t occlusionOrigin;
+static vec3_t occlusionAxis[3];
+static float occlusionScaleX, occlusionScaleY;
+static float occlusionCenterX, occlusionCenterY;   // where the view axis lands, off center in an asymmetric frustum
+static float occlusionZNear;
+
+static occluder_t   *viewOccluders[MAX_VIEW_OCCLUDERS];
+static float viewOccluderScores[MAX_VIEW_OCCLUDERS];
+static int numViewOccluders;
+
+/*
+=================
+R_OccluderArea
+
+Returns 0 if the face points are not a simple convex outline,
+since the rasterizer relies on that
+=================
+*/
+static float R_OccluderArea( srfSurfaceFace_t *face ) {
+	int i, n;
+	float   *p0, *p1, *p2;
+	vec3_t e0, e1, cross;
+	float turn, area;
+
+	n = face->numPoints;
+	if ( n < 3 || n > MAX_OCCLUDER_POINTS - 1 ) {
+		return 0;
+	}
+
+	turn = 0;
+	area = 0;
+	for ( i = 0 ; i < n ; i++ ) {
+		p0 = face->points[i];
+		p1 = face->points[( i + 1 ) % n];
+		p2 = face->points[( i + 2 ) % n];
+
+		VectorSubtract( p1, p0, e0 );
+		VectorSubtract( p2, p1, e1 );
+		CrossProduct( e0, e1, cross );
+		turn += atan2( DotProduct( cross, face->plane.normal ), DotProduct( e0, e1 ) );
+
+		CrossProduct( p0, p1, cross );
+		area += DotProduct( cross, face->plane.normal );
+	}
+
+	// a convex outline turns through exactly one full circle
+	if ( fabs( fabs( turn ) - 2 * M_PI ) > 0.01f ) {
+		return 0;
+	}
+
+	for ( i = 0 ; i < n ; i++ ) {
+		p0 = face->points[i];
+		p1 = face->points[( i + 1 ) % n];
+		p2 = face->points[( i + 2 ) % n];
+
+		VectorSubtract( p1, p0, e0 );
+		VectorSubtract( p2, p1, e1 );
+		CrossProduct( e0, e1, cross );
+		if ( DotProduct( cross, face->plane.normal ) * turn < -0.01f ) {
+			return 0;
+		}
+	}
+
+	return 0.5f * fabs( area );
+}
+
+/*
+=================
+R_IsOccluderShader
+
+Opaque, static surfaces that can hide what is behind them
+=================
+*/
+qboolean R_IsOccluderShader( shader_t *shader ) {
+	int i;
+
+	if ( shader->sort != SS_OPAQUE || shader->numDeforms || shader->numStates ) {
+		return qfalse;
+	}
+	if ( shader->surfaceFlags & ( SURF_NODRAW | SURF_SKY ) ) {
+		return qfalse;
+	}
+	for ( i = 0 ; i < MAX_SHADER_STAGES ; i++ ) {
+		if ( !shader->stages[i] || !shader->stages[i]->active ) {
+			break;
+		}
+		if ( shader->stages[i]->stateBits & GLS_ATEST_BITS ) {
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/*
+=================
+R_BuildOccluders
+
+Called at map load, before tr.world is set
+=================
+*/
+void R_BuildOccluders( world_t *w ) {
+	int i, pass, count;
+	msurface_t          *surf;
+	srfSurfaceFace_t    *face;
+	occluder_t          *occ;
+	float area;
+
+	w->numOccluders = 0;
+	w->occluders = NULL;
+
+	// only the world model, brush models can move
+	if ( !w->bmodels ) {
+		return;
+	}
+
+	occ = NULL;
+	for ( pass = 0 ; pass < 2 ; pass++ ) {
+		count = 0;
+		surf = w->bmodels[0].firstSurface;
+		for ( i = 0 ; i < w->bmodels[0].numSurfaces ; i++, surf++ ) {
+			if ( *surf->data != SF_FACE ) {
+				continue;
+			}
+			if ( !R_IsOccluderShader( surf->shader ) ) {
+				continue;
+			}
+			face = (srfSurfaceFace_t *)surf->data;
+			area = R_OccluderArea( face );
+			if ( area < OCCLUDER_MIN_AREA ) {
+				continue;
+			}
+
+			if ( occ ) {
+				int j;
+
+				occ[count].face = face;
+				occ[count].cullType = surf->shader->cullType;
+				occ[count].area = area;
+				ClearBounds( occ[count].bounds[0], occ[count].bounds[1] );
+				for ( j = 0 ; j < face->numPoints ; j++ ) {
+					AddPointToBounds( face->points[j], occ[count].bounds[0], occ[count].bounds[1] );
+				}
+				VectorAdd( occ[count].bounds[0], occ[count].bounds[1], occ[count].center );
+				VectorScale( occ[count].center, 0.5f, occ[count].center );
+			}
+			count++;
+		}
+
+		if ( !count ) {
+			return;
+		}
+		if ( !occ ) {
+			occ = ri.Hunk_Alloc( count * sizeof( *occ ), h_low );
+		}
+	}
+
+	w->occluders = occ;
+	w->numOccluders = count;
+}
+
+/*
+=================
+R_OcclusionFillSpan
+
+depth = min( depth, z )
+=================
+*/
+static void R_OcclusionFillSpan( float *depth, int count, float z ) {
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	float32x4_t vz = vdupq_n_f32( z );
+
+	for ( ; count >= 4 ; count -= 4, depth += 4 ) {
+		vst1q_f32( depth, vminq_f32( vld1q_f32( depth ), vz ) );
+	}
+#elif defined( __SSE__ )
+	__m128 vz = _mm_set1_ps( z );
+
+	for ( ; count >= 4 ; count -= 4, depth += 4 ) {
+		_mm_storeu_ps( depth, _mm_min_ps( _mm_loadu_ps( depth ), vz ) );
+	}
+#endif
+	for ( ; count > 0 ; count--, depth++ ) {
+		if ( *depth > z ) {
+			*depth = z;
+		}
+	}
+}
+
+/*
+=================
+R_OcclusionSpanVisible
+
+Returns qtrue if any depth in the span is not in front of z
+=================
+*/
+static qboolean R_OcclusionSpanVisible( const float *depth, int count, float z ) {
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	float32x4_t vz = vdupq_n_f32( z );
+
+	for ( ; count >= 4 ; count -= 4, depth += 4 ) {
+		uint32x4_t ge = vcgeq_f32( vld1q_f32( depth ), vz );
+		uint32x2_t m = vorr_u32( vget_low_u32( ge ), vget_high_u32( ge ) );
+
+		if ( vget_lane_u32( vpmax_u32( m, m ), 0 ) ) {
+			return qtrue;
+		}
+	}
+#elif defined( __SSE__ )
+	__m128 vz = _mm_set1_ps( z );
+
+	for ( ; count >= 4 ; count -= 4, depth += 4 ) {
+		if ( _mm_movemask_ps( _mm_cmpge_ps( _mm_loadu_ps( depth ), vz ) ) ) {
+			return qtrue;
+		}
+	}
+#endif
+	for ( ; count > 0 ; count--, depth++ ) {
+		if ( *depth >= z ) {
+			return qtrue;
+		}
+	}
+
+	return qfalse;
+}
+
+/*
+=================
+R_OcclusionViewPoint
+
+Transforms a world point into x = right, y = up, z = forward
+=================
+*/
+static void R_OcclusionViewPoint( const vec3_t in, vec3_t out ) {
+	vec3_t delta;
+
+	VectorSubtract( in, occlusionOrigin, delta );
+	out[0] = -DotProduct( delta, occlusionAxis[1] );
+	out[1] = DotProduct( delta, occlusionAxis[2] );
+	out[2] = DotProduct( delta, occlusionAxis[0] );
+}
+
+/*
+=================
+R_RasterizeOccluder
+
+Only pixels that are entirely inside the polygon are written
+=================
+*/
+static void R_RasterizeOccluder( const occluder_t *occ ) {
+	srfSurfaceFace_t    *face;
+	vec3_t view[MAX_OCCLUDER_POINTS];
+	vec3_t clipped[MAX_OCCLUDER_POINTS];
+	float sx[MAX_OCCLUDER_POINTS], sy[MAX_OCCLUDER_POINTS];
+	float ea[MAX_OCCLUDER_POINTS], eb[MAX_OCCLUDER_POINTS], ec[MAX_OCCLUDER_POINTS];
+	int i, j, n, numClipped, y, y0, y1, x0, x1;
+	float maxZ, area, ymin, ymax, side, lo, hi, k;
+	qboolean inFront, nextInFront;
+
+	face = occ->face;
+	n = face->numPoints;
+
+	maxZ = 0;
+	for ( i = 0 ; i < n ; i++ ) {
+		R_OcclusionViewPoint( face->points[i], view[i] );
+		if ( view[i][2] > maxZ ) {
+			maxZ = view[i][2];
+		}
+	}
+	if ( maxZ <= occlusionZNear ) {
+		return;
+	}
+
+	// clip to the near plane
+	numClipped = 0;
+	for ( i = 0 ; i < n ; i++ ) {
+		j = ( i + 1 ) % n;
+		inFront = view[i][2] >= occlusionZNear;
+		nextInFront = view[j][2] >= occlusionZNear;
+		if ( inFront ) {
+			VectorCopy( view[i], clipped[numClipped] );
+			numClipped++;
+		}
+		if ( inFront != nextInFront ) {
+			float frac = ( occlusionZNear - view[i][2] ) / ( view[j][2] - view[i][2] );
+
+			clipped[numClipped][0] = view[i][0] + frac * ( view[j][0] - view[i][0] );
+			clipped[numClipped][1] = view[i][1] + frac * ( view[j][1] - view[i][1] );
+			clipped[numClipped][2] = occlusionZNear;
+			numClipped++;
+		}
+	}
+	if ( numClipped < 3 ) {
+		return;
+	}
+
+	// project
+	ymin = OCCLUSION_HEIGHT;
+	ymax = 0;
+	for ( i = 0 ; i < numClipped ; i++ ) {
+		sx[i] = occlusionCenterX + clipped[i][0] * occlusionScaleX / clipped[i][2];
+		sy[i] = occlusionCenterY - clipped[i][1] * occlusionScaleY / clipped[i][2];
+		if ( sy[i] < ymin ) {
+			ymin = sy[i];
+		}
+		if ( sy[i] > ymax ) {
+			ymax = sy[i];
+		}
+	}
+
+	area = 0;
+	for ( i = 0 ; i < numClipped ; i++ ) {
+		j = ( i + 1 ) % numClipped;
+		area += sx[i] * sy[j] - sx[j] * sy[i];
+	}
+	if ( fabs( area ) < 1.0f ) {
+		return;     // edge on or smaller than a pixel
+	}
+	side = area > 0 ? 1.0f : -1.0f;
+
+	// edge functions, positive inside
+	for ( i = 0 ; i < numClipped ; i++ ) {
+		float dx, dy;
+
+		j = ( i + 1 ) % numClipped;
+		dx = sx[j] - sx[i];
+		dy = sy[j] - sy[i];
+		ea[i] = -dy * side;
+		eb[i] = dx * side;
+		ec[i] = ( dy * sx[i] - dx * sy[i] ) * side;
+	}
+
+	y0 = ymin < 0 ? 0 : (int)ymin;
+	y1 = ymax > OCCLUSION_HEIGHT ? OCCLUSION_HEIGHT - 1 : (int)ceil( ymax ) - 1;
+
+	for ( y = y0 ; y <= y1 ; y++ ) {
+		lo = 0;
+		hi = OCCLUSION_WIDTH - 1;
+
+		// every corner of the pixel must be inside every edge
+		for ( i = 0 ; i < numClipped ; i++ ) {
+			k = ec[i] + ( eb[i] >= 0 ? eb[i] * y : eb[i] * ( y + 1 ) );
+			if ( ea[i] > 0 ) {
+				if ( -k / ea[i] > lo ) {
+					lo = -k / ea[i];
+				}
+			} else if ( ea[i] < 0 ) {
+				if ( k / -ea[i] - 1 < hi ) {
+					hi = k / -ea[i] - 1;
+				}
+			} else if ( k < 0 ) {
+				break;
+			}
+			if ( lo > hi ) {
+				break;
+			}
+		}
+		if ( i != numClipped ) {
+			continue;
+		}
+
+		x0 = (int)ceil( lo );
+		x1 = (int)floor( hi );
+		if ( x0 <= x1 ) {
+			R_OcclusionFillSpan( occlusionDepth + y * OCCLUSION_WIDTH + x0, x1 - x0 + 1, maxZ );
+		}
+	}
+}
+
+/*
+=================
+R_SetupOcclusion
+
+Picks the occluders for this view and fills the depth buffer,
+called before the world is walked
+=================
+*/
+void R_SetupOcclusion( void ) {
+	int i, j;
+	occluder_t  *occ;
+	vec3_t delta;
+	float d, score;
+
+	occlusionActive = qfalse;
+	numViewOccluders = 0;
+
+	if ( !r_occlusion->integer || r_nocull->integer || !r_drawworld->integer ) {
+		return;
+	}
+	if ( !tr.world || !tr.world->numOccluders ) {
+		return;
+	}
+	if ( tr.refdef.rdflags & RDF_NOWORLDMODEL ) {
+		return;
+	}
+
+	// occluders behind a portal clip plane are not drawn
+	if ( tr.viewParms.isPortal ) {
+		return;
+	}
+
+	VectorCopy( tr.viewParms.or.origin, occlusionOrigin );
+	AxisCopy( tr.viewParms.or.axis, occlusionAxis );
+	occlusionScaleX = OCCLUSION_WIDTH * 0.5f * tr.viewParms.projectionMatrix[0];
+	occlusionScaleY = OCCLUSION_HEIGHT * 0.5f * tr.viewParms.projectionMatrix[5];
+	occlusionCenterX = OCCLUSION_WIDTH * 0.5f * ( 1.0f - tr.viewParms.projectionMatrix[8] );
+	occlusionCenterY = OCCLUSION_HEIGHT * 0.5f * ( 1.0f + tr.viewParms.projectionMatrix[9] );
+	occlusionZNear = r_znear->value;
+
+	// keep the ones that cover the most of the screen
+	for ( i = 0, occ = tr.world->occluders ; i < tr.world->numOccluders ; i++, occ++ ) {
+		d = DotProduct( occlusionOrigin, occ->face->plane.normal ) - occ->face->plane.dist;
+		if ( occ->cullType == CT_FRONT_SIDED ) {
+			if ( d <= 0 ) {
+				continue;
+			}
+		} else if ( occ->cullType == CT_BACK_SIDED ) {
+			if ( d >= 0 ) {
+				continue;
+			}
+		}
+
+		VectorSubtract( occ->center, occlusionOrigin, delta );
+		d = DotProduct( delta, delta );
+		score = occ->area / ( d > 1.0f ? d : 1.0f );
+		if ( score < OCCLUDER_MIN_SCORE ) {
+			continue;
+		}
+		if ( numViewOccluders == MAX_VIEW_OCCLUDERS && score <= viewOccluderScores[numViewOccluders - 1] ) {
+			continue;
+		}
+
+		for ( j = 0 ; j < 4 ; j++ ) {
+			if ( BoxOnPlaneSide( occ->bounds[0], occ->bounds[1], &tr.viewParms.frustum[j] ) == 2 ) {
+				break;
+			}
+		}
+		if ( j != 4 ) {
+			continue;
+		}
+
+		if ( numViewOccluders < MAX_VIEW_OCCLUDERS ) {
+			numViewOccluders++;
+		}
+		for ( j = numViewOccluders - 1 ; j > 0 && viewOccluderScores[j - 1] < score ; j-- ) {
+			viewOccluders[j] = viewOccluders[j - 1];
+			viewOccluderScores[j] = viewOccluderScores[j - 1];
+		}
+		viewOccluders[j] = occ;
+		viewOccluderScores[j] = score;
+	}
+
+	if ( !numViewOccluders ) {
+		return;
+	}
+
+	for ( i = 0 ; i < OCCLUSION_WIDTH * OCCLUSION_HEIGHT ; i++ ) {
+		occlusionDepth[i] = OCCLUSION_CLEAR_DEPTH;
+	}
+
+	for ( i = 0 ; i < numViewOccluders ; i++ ) {
+		R_RasterizeOccluder( viewOccluders[i] );
+	}
+
+	tr.pc.c_occluders += numViewOccluders;
+	occlusionActive = qtrue;
+}
+
+/*
+=================
+R_OccludedPoints
+
+Returns qtrue if the screen rectangle of the points is
+entirely behind the occluders
+=================
+*/
+static qboolean R_OccludedPoints( vec3_t points[8] ) {
+	int i, y, x0, x1, y0, y1;
+	vec3_t v;
+	float minZ, minX, maxX, minY, maxY, sx, sy;
+
+	minZ = OCCLUSION_CLEAR_DEPTH;
+	minX = minY = OCCLUSION_CLEAR_DEPTH;
+	maxX = maxY = -OCCLUSION_CLEAR_DEPTH;
+
+	for ( i = 0 ; i < 8 ; i++ ) {
+		R_OcclusionViewPoint( points[i], v );
+		if ( v[2] < occlusionZNear ) {
+			return qfalse;
+		}
+		if ( v[2] < minZ ) {
+			minZ = v[2];
+		}
+
+		sx = occlusionCenterX + v[0] * occlusionScaleX / v[2];
+		sy = occlusionCenterY - v[1] * occlusionScaleY / v[2];
+		if ( sx < minX ) {
+			minX = sx;
+		}
+		if ( sx > maxX ) {
+			maxX = sx;
+		}
+		if ( sy < minY ) {
+			minY = sy;
+		}
+		if ( sy > maxY ) {
+			maxY = sy;
+		}
+	}
+
+	// anything touching a pixel has to be tested against it
+	x0 = minX < 0 ? 0 : (int)minX;
+	y0 = minY < 0 ? 0 : (int)minY;
+	x1 = maxX >= OCCLUSION_WIDTH ? OCCLUSION_WIDTH - 1 : (int)floor( maxX );
+	y1 = maxY >= OCCLUSION_HEIGHT ? OCCLUSION_HEIGHT - 1 : (int)floor( maxY );
+	if ( x0 > x1 || y0 > y1 ) {
+		return qfalse;      // off screen, leave it to the frustum
+	}
+
+	for ( y = y0 ; y <= y1 ; y++ ) {
+		if ( R_OcclusionSpanVisible( occlusionDepth + y * OCCLUSION_WIDTH + x0, x1 - x0 + 1, minZ ) ) {
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/*
+=================
+R_OcclusionCullBox
+
+World space bounds
+=================
+*/
+qboolean R_OcclusionCullBox( const vec3_t mins, const vec3_t maxs ) {
+	int i;
+	vec3_t points[8];
+
+	if ( !occlusionActive ) {
+		return qfalse;
+	}
+
+	for ( i = 0 ; i < 8 ; i++ ) {
+		points[i][0] = ( i & 1 ) ? maxs[0] : mins[0];
+		points[i][1] = ( i & 2 ) ? maxs[1] : mins[1];
+		points[i][2] = ( i & 4 ) ? maxs[2] : mins[2];
+	}
+
+	return R_OccludedPoints( points );
+}
+
+/*
+=================
+R_OcclusionCullLocalBox
+
+Bounds in the tr.or coordinate system
+=================
+*/
+static qboolean R_OcclusionCullLocalBox( vec3_t bounds[2] ) {
+	int i;
+	vec3_t points[8];
+
+	for ( i = 0 ; i < 8 ; i++ ) {
+		VectorCopy( tr.or.origin, points[i] );
+		VectorMA( points[i], bounds[i & 1][0], tr.or.axis[0], points[i] );
+		VectorMA( points[i], bounds[( i >> 1 ) & 1][1], tr.or.axis[1], points[i] );
+		VectorMA( points[i], bounds[( i >> 2 ) & 1][2], tr.or.axis[2], points[i] );
+	}
+
+	return R_OccludedPoints( points );
+}
+
+/*
+=================
+R_OcclusionCullEntity
+
+tr.or and tr.currentModel must be set up for the entity
+=================
+*/
+qboolean R_OcclusionCullEntity( trRefEntity_t *ent ) {
+	model_t     *model;
+	vec3_t bounds[2];
+	float       *newBounds, *oldBounds;
+	int i, numFrames;
+
+	if ( !occlusionActive ) {
+		return qfalse;
+	}
+
+	if ( ent->e.renderfx & ( RF_FIRST_PERSON | RF_DEPTHHACK ) ) {
+		return qfalse;
+	}
+
+	// a hidden entity can still throw a shadow volume into view
+	if ( r_shadows->integer > 1 && !( ent->e.renderfx & RF_NOSHADOW ) ) {
+		return qfalse;
+	}
+
+	model = tr.currentModel;
+
+	switch ( model->type ) {
+	case MOD_BRUSH:
+		if ( R_OcclusionCullLocalBox( model->bmodel->bounds ) ) {
+			tr.pc.c_occludedEntities++;
+			return qtrue;
+		}
+		return qfalse;
+	case MOD_MESH:
+		numFrames = model->md3[0]->numFrames;
+		break;
+	case MOD_MDC:
+		numFrames = model->mdc[0]->numFrames;
+		break;
+	case MOD_MDS:
+		numFrames = model->mds->numFrames;
+		break;
+	default:
+		return qfalse;
+	}
+
+	// bad frames are reported when the surfaces are added
+	if ( ent->e.frame < 0 || ent->e.frame >= numFrames || ent->e.oldframe < 0 || ent->e.oldframe >= numFrames ) {
+		return qfalse;
+	}
+
+	if ( model->type == MOD_MDS ) {
+		mdsHeader_t *header = model->mds;
+		int frameSize = (int) ( sizeof( mdsFrame_t ) - sizeof( mdsBoneFrameCompressed_t ) + header->numBones * sizeof( mdsBoneFrameCompressed_t ) );
+
+		newBounds = ( ( mdsFrame_t * )( ( byte * ) header + header->ofsFrames + ent->e.frame * frameSize ) )->bounds[0];
+		oldBounds = ( ( mdsFrame_t * )( ( byte * ) header + header->ofsFrames + ent->e.oldframe * frameSize ) )->bounds[0];
+	} else {
+		md3Frame_t *frames;
+
+		if ( model->type == MOD_MESH ) {
+			frames = ( md3Frame_t * )( ( byte * ) model->md3[0] + model->md3[0]->ofsFrames );
+		} else {
+			frames = ( md3Frame_t * )( ( byte * ) model->mdc[0] + model->mdc[0]->ofsFrames );
+		}
+		newBounds = frames[ent->e.frame].bounds[0];
+		oldBounds = frames[ent->e.oldframe].bounds[0];
+	}
+
+	for ( i = 0 ; i < 3 ; i++ ) {
+		bounds[0][i] = oldBounds[i] < newBounds[i] ? oldBounds[i] : newBounds[i];
+		bounds[1][i] = oldBounds[3 + i] > newBounds[3 + i] ? oldBounds[3 + i] : newBounds[3 + i];
+	}
+
+	if ( R_OcclusionCullLocalBox( bounds ) ) {
+		tr.pc.c_occludedEntities++;
+		return qtrue;
+	}
+	return qfalse;
+}
+
+/*
+=================
+R_DebugOcclusion
+
+Draws this view's occluders
+=================
+*/
+void R_DebugOcclusion( void ) {
+	int i, j;
+	srfSurfaceFace_t    *face;
+	vec3_t points[MAX_OCCLUDER_POINTS];
+
+	if ( r_occlusion->integer != 2 || !numViewOccluders ) {
+		return;
+	}
+
+	// the render thread can't make callbacks to the main thread
+	R_SyncRenderThread();
+
+	GL_Bind( tr.whiteImage );
+	GL_Cull( CT_TWO_SIDED );
+	for ( i = 0 ; i < numViewOccluders ; i++ ) {
+		face = viewOccluders[i]->face;
+		for ( j = 0 ; j < face->numPoints ; j++ ) {
+			VectorCopy( face->points[j], points[j] );
+		}
+		R_DebugPolygon( 5, face->numPoints, points[0] );
+	}
+}
@@ -89,6 +89,9 @@ typedef struct {
 							  float s1, float t1, float s2, float t2, qhandle_t hShader ); // 0 = white
 	void ( *DrawStretchPicGradient )( float x, float y, float w, float h,
 									  float s1, float t1, float s2, float t2, qhandle_t hShader, const float *gradientColor, int gradientType );
+	// draws a whole string with one command, x/y is the baseline start and the scales map glyph units to screen pixels
+	void ( *DrawText )( float x, float y, float xscale, float yscale, float adjust, float shadowX, float shadowY,
+						const float *rgba, const char *text, int limit, const fontInfo_t *font );
 
 	// Draw images for cinematic rendering, pass as 32 bit rgba
 	void ( *DrawStretchRaw )( int x, int y, int w, int h, int cols, int rows, const byte *data, int client, qboolean dirty );
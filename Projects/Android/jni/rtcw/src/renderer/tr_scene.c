@@ -466,6 +466,11 @@ void RE_RenderScene( const refdef_t *fd ) {
 	tr.refdef.fov_y = fd->fov_y;
 
 	VectorCopy( fd->vieworg, tr.refdef.vieworg );
+	if ( fd->stereoView ) {
+		VectorCopy( fd->headorg, tr.refdef.headorg );
+	} else {
+		VectorCopy( fd->vieworg, tr.refdef.headorg );
+	}
 	VectorCopy( fd->viewaxis[0], tr.refdef.viewaxis[0] );
 	VectorCopy( fd->viewaxis[1], tr.refdef.viewaxis[1] );
 	VectorCopy( fd->viewaxis[2], tr.refdef.viewaxis[2] );
@@ -523,6 +528,9 @@ void RE_RenderScene( const refdef_t *fd ) {
 	tr.refdef.numPolys = r_numpolys - r_firstScenePoly;
 	tr.refdef.polys = &backEndData[tr.smpFrame]->polys[r_firstScenePoly];
 
+	// decide which coronas the world hides before the back end fades them
+	R_TestCoronas();
+
 	// turn off dynamic lighting globally by clearing all the
 	// dlights if it needs to be disabled or if vertex lighting is enabled
 	if ( /*r_dynamiclight->integer == 0 ||*/    // RF, disabled so we can force things like lightning dlights
@@ -1018,7 +1018,8 @@ static void ComputeTexCoords( shaderStage_t *pStage ) {
 	int b;
 
 	for ( b = 0; b < NUM_TEXTURE_BUNDLES; b++ ) {
-		int tm;
+		int tm, numTransforms;
+		texModInfo_t tmi;
 
 		//
 		// generate the texture coordinates
@@ -1060,8 +1061,10 @@ static void ComputeTexCoords( shaderStage_t *pStage ) {
 		}
 
 		//
-		// alter texture coordinates
+		// alter texture coordinates, runs of affine tcMods are
+		// concatenated and applied in one pass
 		//
+		numTransforms = 0;
 		for ( tm = 0; tm < pStage->bundle[b].numTexMods ; tm++ ) {
 			switch ( pStage->bundle[b].texMods[tm].type )
 			{
@@ -1069,50 +1072,32 @@ static void ComputeTexCoords( shaderStage_t *pStage ) {
 				tm = TR_MAX_TEXMODS;        // break out of for loop
 				break;
 
-			case TMOD_SWAP:
-				RB_CalcSwapTexCoords( ( float * ) tess.svars.texcoords[b] );
-				break;
-
 			case TMOD_TURBULENT:
+				if ( numTransforms ) {
+					RB_CalcTransformTexCoords( &tmi, ( float * ) tess.svars.texcoords[b] );
+					numTransforms = 0;
+				}
 				RB_CalcTurbulentTexCoords( &pStage->bundle[b].texMods[tm].wave,
 										   ( float * ) tess.svars.texcoords[b] );
 				break;
 
-			case TMOD_ENTITY_TRANSLATE:
-				RB_CalcScrollTexCoords( backEnd.currentEntity->e.shaderTexCoord,
-										( float * ) tess.svars.texcoords[b] );
-				break;
-
-			case TMOD_SCROLL:
-				RB_CalcScrollTexCoords( pStage->bundle[b].texMods[tm].scroll,
-										( float * ) tess.svars.texcoords[b] );
-				break;
-
-			case TMOD_SCALE:
-				RB_CalcScaleTexCoords( pStage->bundle[b].texMods[tm].scale,
-									   ( float * ) tess.svars.texcoords[b] );
-				break;
-
-			case TMOD_STRETCH:
-				RB_CalcStretchTexCoords( &pStage->bundle[b].texMods[tm].wave,
-										 ( float * ) tess.svars.texcoords[b] );
-				break;
-
-			case TMOD_TRANSFORM:
-				RB_CalcTransformTexCoords( &pStage->bundle[b].texMods[tm],
-										   ( float * ) tess.svars.texcoords[b] );
-				break;
-
-			case TMOD_ROTATE:
-				RB_CalcRotateTexCoords( pStage->bundle[b].texMods[tm].rotateSpeed,
-										( float * ) tess.svars.texcoords[b] );
-				break;
-
 			default:
-				ri.Error( ERR_DROP, "ERROR: unknown texmod '%d' in shader '%s'\n", pStage->bundle[b].texMods[tm].type, tess.shader->name );
+				if ( !numTransforms ) {
+					tmi.matrix[0][0] = tmi.matrix[1][1] = 1;
+					tmi.matrix[0][1] = tmi.matrix[1][0] = 0;
+					tmi.translate[0] = tmi.translate[1] = 0;
+				}
+				if ( !RB_ConcatTexMod( &tmi, &pStage->bundle[b].texMods[tm] ) ) {
+					ri.Error( ERR_DROP, "ERROR: unknown texmod '%d' in shader '%s'\n", pStage->bundle[b].texMods[tm].type, tess.shader->name );
+				}
+				numTransforms++;
 				break;
 			}
 		}
+
+		if ( numTransforms ) {
+			RB_CalcTransformTexCoords( &tmi, ( float * ) tess.svars.texcoords[b] );
+		}
 	}
 }
 
@@ -30,6 +30,11 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "tr_local.h"
 
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+#elif defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
 
 #define WAVEVALUE( table, base, amplitude, phase, freq )  ( ( base ) + table[ myftol( ( ( ( phase ) + tess.shaderTime * ( freq ) ) * FUNCTABLE_SIZE ) ) & FUNCTABLE_MASK ] * ( amplitude ) )
 
@@ -83,23 +88,20 @@ static float EvalWaveFormClamped( const waveForm_t *wf ) {
 }
 
 /*
-** RB_CalcStretchTexCoords
+** RB_StretchTransform
 */
-void RB_CalcStretchTexCoords( const waveForm_t *wf, float *st ) {
+static void RB_StretchTransform( const waveForm_t *wf, texModInfo_t *tmi ) {
 	float p;
-	texModInfo_t tmi;
 
 	p = 1.0f / EvalWaveForm( wf );
 
-	tmi.matrix[0][0] = p;
-	tmi.matrix[1][0] = 0;
-	tmi.translate[0] = 0.5f - 0.5f * p;
-
-	tmi.matrix[0][1] = 0;
-	tmi.matrix[1][1] = p;
-	tmi.translate[1] = 0.5f - 0.5f * p;
+	tmi->matrix[0][0] = p;
+	tmi->matrix[1][0] = 0;
+	tmi->translate[0] = 0.5f - 0.5f * p;
 
-	RB_CalcTransformTexCoords( &tmi, st );
+	tmi->matrix[0][1] = 0;
+	tmi->matrix[1][1] = p;
+	tmi->translate[1] = 0.5f - 0.5f * p;
 }
 
 /*
@@ -987,22 +989,6 @@ void RB_CalcFireRiseEnvTexCoords( float *st ) {
 }
 
 
-/*
-** RB_CalcSwapTexCoords
-*/
-void RB_CalcSwapTexCoords( float *st ) {
-	int i;
-
-	for ( i = 0; i < tess.numVertexes; i++, st += 2 )
-	{
-		float s = st[0];
-		float t = st[1];
-
-		st[0] = t;
-		st[1] = 1.0 - s;    // err, flaming effect needs this
-	}
-}
-
 /*
 ** RB_CalcTurbulentTexCoords
 */
@@ -1023,48 +1009,41 @@ void RB_CalcTurbulentTexCoords( const waveForm_t *wf, float *st ) {
 }
 
 /*
-** RB_CalcScaleTexCoords
+** RB_CalcTransformTexCoords
 */
-void RB_CalcScaleTexCoords( const float scale[2], float *st ) {
+void RB_CalcTransformTexCoords( const texModInfo_t *tmi, float *st  ) {
 	int i;
 
-	for ( i = 0; i < tess.numVertexes; i++, st += 2 )
+	i = 0;
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	for ( ; i + 4 <= tess.numVertexes; i += 4, st += 8 )
 	{
-		st[0] *= scale[0];
-		st[1] *= scale[1];
-	}
-}
+		float32x4x2_t in, out;
 
-/*
-** RB_CalcScrollTexCoords
-*/
-void RB_CalcScrollTexCoords( const float scrollSpeed[2], float *st ) {
-	int i;
-	float timeScale = tess.shaderTime;
-	float adjustedScrollS, adjustedScrollT;
-
-	adjustedScrollS = scrollSpeed[0] * timeScale;
-	adjustedScrollT = scrollSpeed[1] * timeScale;
-
-	// clamp so coordinates don't continuously get larger, causing problems
-	// with hardware limits
-	adjustedScrollS = adjustedScrollS - floor( adjustedScrollS );
-	adjustedScrollT = adjustedScrollT - floor( adjustedScrollT );
-
-	for ( i = 0; i < tess.numVertexes; i++, st += 2 )
-	{
-		st[0] += adjustedScrollS;
-		st[1] += adjustedScrollT;
+		in = vld2q_f32( st );
+		out.val[0] = vmlaq_n_f32( vmlaq_n_f32( vdupq_n_f32( tmi->translate[0] ), in.val[0], tmi->matrix[0][0] ), in.val[1], tmi->matrix[1][0] );
+		out.val[1] = vmlaq_n_f32( vmlaq_n_f32( vdupq_n_f32( tmi->translate[1] ), in.val[0], tmi->matrix[0][1] ), in.val[1], tmi->matrix[1][1] );
+		vst2q_f32( st, out );
 	}
-}
+#elif defined( __SSE2__ )
+	{
+		// two vertexes per vector, { s0, t0, s1, t1 }
+		__m128 ms = _mm_setr_ps( tmi->matrix[0][0], tmi->matrix[0][1], tmi->matrix[0][0], tmi->matrix[0][1] );
+		__m128 mt = _mm_setr_ps( tmi->matrix[1][0], tmi->matrix[1][1], tmi->matrix[1][0], tmi->matrix[1][1] );
+		__m128 tr = _mm_setr_ps( tmi->translate[0], tmi->translate[1], tmi->translate[0], tmi->translate[1] );
+		__m128 in;
 
-/*
-** RB_CalcTransformTexCoords
-*/
-void RB_CalcTransformTexCoords( const texModInfo_t *tmi, float *st  ) {
-	int i;
+		for ( ; i + 2 <= tess.numVertexes; i += 2, st += 4 )
+		{
+			in = _mm_loadu_ps( st );
+			_mm_storeu_ps( st, _mm_add_ps( tr, _mm_add_ps(
+											   _mm_mul_ps( _mm_shuffle_ps( in, in, _MM_SHUFFLE( 2, 2, 0, 0 ) ), ms ),
+											   _mm_mul_ps( _mm_shuffle_ps( in, in, _MM_SHUFFLE( 3, 3, 1, 1 ) ), mt ) ) ) );
+		}
+	}
+#endif
 
-	for ( i = 0; i < tess.numVertexes; i++, st += 2 )
+	for ( ; i < tess.numVertexes; i++, st += 2 )
 	{
 		float s = st[0];
 		float t = st[1];
@@ -1075,14 +1054,13 @@ void RB_CalcTransformTexCoords( const texModInfo_t *tmi, float *st  ) {
 }
 
 /*
-** RB_CalcRotateTexCoords
+** RB_RotateTransform
 */
-void RB_CalcRotateTexCoords( float degsPerSecond, float *st ) {
+static void RB_RotateTransform( float degsPerSecond, texModInfo_t *tmi ) {
 	float timeScale = tess.shaderTime;
 	float degs;
 	int index;
 	float sinValue, cosValue;
-	texModInfo_t tmi;
 
 	degs = -degsPerSecond * timeScale;
 	index = degs * ( FUNCTABLE_SIZE / 360.0f );
@@ -1090,15 +1068,98 @@ void RB_CalcRotateTexCoords( float degsPerSecond, float *st ) {
 	sinValue = tr.sinTable[ index & FUNCTABLE_MASK ];
 	cosValue = tr.sinTable[ ( index + FUNCTABLE_SIZE / 4 ) & FUNCTABLE_MASK ];
 
-	tmi.matrix[0][0] = cosValue;
-	tmi.matrix[1][0] = -sinValue;
-	tmi.translate[0] = 0.5 - 0.5 * cosValue + 0.5 * sinValue;
+	tmi->matrix[0][0] = cosValue;
+	tmi->matrix[1][0] = -sinValue;
+	tmi->translate[0] = 0.5 - 0.5 * cosValue + 0.5 * sinValue;
+
+	tmi->matrix[0][1] = sinValue;
+	tmi->matrix[1][1] = cosValue;
+	tmi->translate[1] = 0.5 - 0.5 * sinValue - 0.5 * cosValue;
+}
+
+/*
+** RB_ScrollTransform
+*/
+static void RB_ScrollTransform( const float scrollSpeed[2], texModInfo_t *tmi ) {
+	float timeScale = tess.shaderTime;
+
+	tmi->matrix[0][0] = 1;
+	tmi->matrix[1][0] = 0;
+	tmi->translate[0] = scrollSpeed[0] * timeScale;
+
+	tmi->matrix[0][1] = 0;
+	tmi->matrix[1][1] = 1;
+	tmi->translate[1] = scrollSpeed[1] * timeScale;
+
+	// clamp so coordinates don't continuously get larger, causing problems
+	// with hardware limits
+	tmi->translate[0] = tmi->translate[0] - floor( tmi->translate[0] );
+	tmi->translate[1] = tmi->translate[1] - floor( tmi->translate[1] );
+}
+
+/*
+** RB_ConcatTexMod
+**
+** Appends an affine tcMod to tmi, so a run of them costs a single pass
+** over the texcoords.  Returns qfalse for tcMods that aren't affine.
+*/
+qboolean RB_ConcatTexMod( texModInfo_t *tmi, const texModInfo_t *tm ) {
+	texModInfo_t a;
+	float m00, m01, m10, m11, t0, t1;
+
+	switch ( tm->type )
+	{
+	case TMOD_SWAP:
+		a.matrix[0][0] = 0;
+		a.matrix[1][0] = 1;
+		a.translate[0] = 0;
+		a.matrix[0][1] = -1;
+		a.matrix[1][1] = 0;
+		a.translate[1] = 1;     // err, flaming effect needs this
+		break;
+	case TMOD_ENTITY_TRANSLATE:
+		RB_ScrollTransform( backEnd.currentEntity->e.shaderTexCoord, &a );
+		break;
+	case TMOD_SCROLL:
+		RB_ScrollTransform( tm->scroll, &a );
+		break;
+	case TMOD_SCALE:
+		a.matrix[0][0] = tm->scale[0];
+		a.matrix[1][0] = 0;
+		a.translate[0] = 0;
+		a.matrix[0][1] = 0;
+		a.matrix[1][1] = tm->scale[1];
+		a.translate[1] = 0;
+		break;
+	case TMOD_STRETCH:
+		RB_StretchTransform( &tm->wave, &a );
+		break;
+	case TMOD_TRANSFORM:
+		a = *tm;
+		break;
+	case TMOD_ROTATE:
+		RB_RotateTransform( tm->rotateSpeed, &a );
+		break;
+	default:
+		return qfalse;
+	}
+
+	m00 = tmi->matrix[0][0];
+	m01 = tmi->matrix[0][1];
+	m10 = tmi->matrix[1][0];
+	m11 = tmi->matrix[1][1];
+	t0 = tmi->translate[0];
+	t1 = tmi->translate[1];
+
+	tmi->matrix[0][0] = m00 * a.matrix[0][0] + m01 * a.matrix[1][0];
+	tmi->matrix[1][0] = m10 * a.matrix[0][0] + m11 * a.matrix[1][0];
+	tmi->translate[0] = t0 * a.matrix[0][0] + t1 * a.matrix[1][0] + a.translate[0];
 
-	tmi.matrix[0][1] = sinValue;
-	tmi.matrix[1][1] = cosValue;
-	tmi.translate[1] = 0.5 - 0.5 * sinValue - 0.5 * cosValue;
+	tmi->matrix[0][1] = m00 * a.matrix[0][1] + m01 * a.matrix[1][1];
+	tmi->matrix[1][1] = m10 * a.matrix[0][1] + m11 * a.matrix[1][1];
+	tmi->translate[1] = t0 * a.matrix[0][1] + t1 * a.matrix[1][1] + a.translate[1];
 
-	RB_CalcTransformTexCoords( &tmi, st );
+	return qtrue;
 }
 
 
@@ -1183,7 +1244,7 @@ void RB_CalcSpecularAlpha( unsigned char *alphas ) {
 */
 void RB_CalcDiffuseColor( unsigned char *colors ) {
 	int i, j;
-	float           *v, *normal;
+	float           *normal;
 	float incoming;
 	trRefEntity_t   *ent;
 	int ambientLightInt;
@@ -1198,11 +1259,64 @@ void RB_CalcDiffuseColor( unsigned char *colors ) {
 	VectorCopy( ent->directedLight, directedLight );
 	VectorCopy( ent->lightDir, lightDir );
 
-	v = tess.xyz[0];
 	normal = tess.normal[0];
 
 	numVertexes = tess.numVertexes;
-	for ( i = 0 ; i < numVertexes ; i++, v += 4, normal += 4 ) {
+	i = 0;
+
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	{
+		float32x4_t max = vdupq_n_f32( 255 ), zero = vdupq_n_f32( 0 );
+		uint32x4_t alpha = vdupq_n_u32( 0xff000000 );
+		float32x4_t in, r, g, b;
+		float32x4x4_t n;
+
+		for ( ; i + 4 <= numVertexes ; i += 4, normal += 16 ) {
+			n = vld4q_f32( normal );
+			in = vmulq_n_f32( n.val[0], lightDir[0] );
+			in = vmlaq_n_f32( in, n.val[1], lightDir[1] );
+			in = vmlaq_n_f32( in, n.val[2], lightDir[2] );
+			in = vmaxq_f32( in, zero );
+
+			r = vminq_f32( vmlaq_n_f32( vdupq_n_f32( ambientLight[0] ), in, directedLight[0] ), max );
+			g = vminq_f32( vmlaq_n_f32( vdupq_n_f32( ambientLight[1] ), in, directedLight[1] ), max );
+			b = vminq_f32( vmlaq_n_f32( vdupq_n_f32( ambientLight[2] ), in, directedLight[2] ), max );
+
+			vst1q_u32( (unsigned int *)&colors[i * 4], vorrq_u32( vorrq_u32( vcvtq_u32_f32( r ),
+																			  vshlq_n_u32( vcvtq_u32_f32( g ), 8 ) ),
+																   vorrq_u32( vshlq_n_u32( vcvtq_u32_f32( b ), 16 ), alpha ) ) );
+		}
+	}
+#elif defined( __SSE2__ )
+	{
+		__m128 max = _mm_set1_ps( 255 ), zero = _mm_setzero_ps();
+		__m128i alpha = _mm_set1_epi32( 0xff000000 );
+		__m128 nx, ny, nz, nw, in, r, g, b;
+
+		for ( ; i + 4 <= numVertexes ; i += 4, normal += 16 ) {
+			nx = _mm_loadu_ps( normal );
+			ny = _mm_loadu_ps( normal + 4 );
+			nz = _mm_loadu_ps( normal + 8 );
+			nw = _mm_loadu_ps( normal + 12 );
+			_MM_TRANSPOSE4_PS( nx, ny, nz, nw );
+
+			in = _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, _mm_set1_ps( lightDir[0] ) ),
+										 _mm_mul_ps( ny, _mm_set1_ps( lightDir[1] ) ) ),
+							 _mm_mul_ps( nz, _mm_set1_ps( lightDir[2] ) ) );
+			in = _mm_max_ps( in, zero );
+
+			r = _mm_min_ps( _mm_add_ps( _mm_set1_ps( ambientLight[0] ), _mm_mul_ps( in, _mm_set1_ps( directedLight[0] ) ) ), max );
+			g = _mm_min_ps( _mm_add_ps( _mm_set1_ps( ambientLight[1] ), _mm_mul_ps( in, _mm_set1_ps( directedLight[1] ) ) ), max );
+			b = _mm_min_ps( _mm_add_ps( _mm_set1_ps( ambientLight[2] ), _mm_mul_ps( in, _mm_set1_ps( directedLight[2] ) ) ), max );
+
+			_mm_storeu_si128( (__m128i *)&colors[i * 4], _mm_or_si128( _mm_or_si128( _mm_cvttps_epi32( r ),
+																					  _mm_slli_epi32( _mm_cvttps_epi32( g ), 8 ) ),
+																	   _mm_or_si128( _mm_slli_epi32( _mm_cvttps_epi32( b ), 16 ), alpha ) ) );
+		}
+	}
+#endif
+
+	for ( ; i < numVertexes ; i++, normal += 4 ) {
 		incoming = DotProduct( normal, lightDir );
 		if ( incoming <= 0 ) {
 			*(int *)&colors[i * 4] = ambientLightInt;
@@ -39,6 +39,19 @@ static shader_t shader;
 static texModInfo_t texMods[MAX_SHADER_STAGES][TR_MAX_TEXMODS];
 static qboolean deferLoad;
 
+// cleared while parsing when the shader text changes global state or depends
+// on the hardware, so the parsed result can't be stored in the compiled cache
+static qboolean shaderCompilable;
+
+// the load parms ParseStage asked for when it found the images of each stage,
+// the image_t it got back may have been loaded first with other parms
+#define CIMGF_MIPMAP            1
+#define CIMGF_PICMIP            2
+#define CIMGF_CHARACTERMIP      4
+#define CIMGF_CLAMP             8
+
+static int stageImageParms[MAX_SHADER_STAGES];
+
 #define FILE_HASH_SIZE      4096
 
 static shader_t*       hashTable[FILE_HASH_SIZE];
@@ -526,6 +539,20 @@ static void ParseTexMod( char *_text, shaderStage_t *stage ) {
 ParseStage
 ===================
 */
+/*
+===================
+StageImageParms
+
+Load parms for the images of a stage, as ParseStage passes them to R_FindImageFileExt
+===================
+*/
+static int StageImageParms( int glWrapClampMode ) {
+	return ( !shader.noMipMaps ? CIMGF_MIPMAP : 0 ) |
+		   ( !shader.noPicMip ? CIMGF_PICMIP : 0 ) |
+		   ( shader.characterMip ? CIMGF_CHARACTERMIP : 0 ) |
+		   ( glWrapClampMode == GL_CLAMP ? CIMGF_CLAMP : 0 );
+}
+
 static qboolean ParseStage( shaderStage_t *stage, char **text ) {
 	char *token;
 	int depthMaskBits = GLS_DEPTHMASK_TRUE, blendSrcBits = 0, blendDstBits = 0, atestBits = 0, depthFuncBits = 0;
@@ -547,6 +574,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text ) {
 		//
 		// check special case for map16/map32/mapcomp/mapnocomp (compression enabled)
 		if ( !Q_stricmp( token, "map16" ) ) {    // only use this texture if 16 bit color depth
+			shaderCompilable = qfalse;
 			if ( glConfig.colorBits <= 16 ) {
 				token = "map";   // use this map
 			} else {
@@ -554,6 +582,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text ) {
 				continue;
 			}
 		} else if ( !Q_stricmp( token, "map32" ) )    { // only use this texture if 16 bit color depth
+			shaderCompilable = qfalse;
 			if ( glConfig.colorBits > 16 ) {
 				token = "map";   // use this map
 			} else {
@@ -561,6 +590,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text ) {
 				continue;
 			}
 		} else if ( !Q_stricmp( token, "mapcomp" ) )    { // only use this texture if compression is enabled
+			shaderCompilable = qfalse;
 			if ( glConfig.textureCompression && r_ext_compressed_textures->integer ) {
 				token = "map";   // use this map
 			} else {
@@ -568,6 +598,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text ) {
 				continue;
 			}
 		} else if ( !Q_stricmp( token, "mapnocomp" ) )    { // only use this texture if compression is not available or disabled
+			shaderCompilable = qfalse;
 			if ( !glConfig.textureCompression ) {
 				token = "map";   // use this map
 			} else {
@@ -575,6 +606,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text ) {
 				continue;
 			}
 		} else if ( !Q_stricmp( token, "animmapcomp" ) )    { // only use this texture if compression is enabled
+			shaderCompilable = qfalse;
 			if ( glConfig.textureCompression && r_ext_compressed_textures->integer ) {
 				token = "animmap";   // use this map
 			} else {
@@ -583,6 +615,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text ) {
 				continue;
 			}
 		} else if ( !Q_stricmp( token, "animmapnocomp" ) )    { // only use this texture if compression is not available or disabled
+			shaderCompilable = qfalse;
 			if ( !glConfig.textureCompression ) {
 				token = "animmap";   // use this map
 			} else {
@@ -631,6 +664,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text ) {
 					ri.Printf( PRINT_WARNING, "WARNING: R_FindImageFile could not find '%s' in shader '%s'\n", token, shader.name );
 					return qfalse;
 				}
+				stageImageParms[stage - stages] = StageImageParms( GL_REPEAT );
 			}
 		}
 		//
@@ -648,6 +682,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text ) {
 				ri.Printf( PRINT_WARNING, "WARNING: R_FindImageFile could not find '%s' in shader '%s'\n", token, shader.name );
 				return qfalse;
 			}
+			stageImageParms[stage - stages] = StageImageParms( GL_CLAMP );
 		}
 		//
 		// animMap <frequency> <image1> .... <imageN>
@@ -675,10 +710,12 @@ static qboolean ParseStage( shaderStage_t *stage, char **text ) {
 						ri.Printf( PRINT_WARNING, "WARNING: R_FindImageFile could not find '%s' in shader '%s'\n", token, shader.name );
 						return qfalse;
 					}
+					stageImageParms[stage - stages] = StageImageParms( GL_REPEAT );
 					stage->bundle[0].numImageAnimations++;
 				}
 			}
 		} else if ( !Q_stricmp( token, "videoMap" ) )    {
+			shaderCompilable = qfalse;
 			token = COM_ParseExt( text, qfalse );
 			if ( !token[0] ) {
 				ri.Printf( PRINT_WARNING, "WARNING: missing parameter for 'videoMmap' keyword in shader '%s'\n", shader.name );
@@ -1414,6 +1451,7 @@ static qboolean ParseShader( char **text ) {
 		else if ( !Q_stricmp( token, "q3map_sun" ) ) {
 			float a, b;
 
+			shaderCompilable = qfalse;
 			token = COM_ParseExt( text, qfalse );
 			tr.sunLight[0] = atof( token );
 			token = COM_ParseExt( text, qfalse );
@@ -1513,6 +1551,7 @@ static qboolean ParseShader( char **text ) {
 		}
 		// skyparms <cloudheight> <outerbox> <innerbox>
 		else if ( !Q_stricmp( token, "skyparms" ) ) {
+			shaderCompilable = qfalse;
 			ParseSkyParms( text );
 			continue;
 		}
@@ -1523,6 +1562,7 @@ static qboolean ParseShader( char **text ) {
 		else if ( !Q_stricmp( token, "skyfogvars" ) ) {
 			vec3_t fogColor;
 
+			shaderCompilable = qfalse;
 			if ( !ParseVector( text, 3, fogColor ) ) {
 				return qfalse;
 			}
@@ -1541,6 +1581,7 @@ static qboolean ParseShader( char **text ) {
 			R_SetFog( FOG_SKY, 0, 5, fogColor[0], fogColor[1], fogColor[2], atof( token ) );
 			continue;
 		} else if ( !Q_stricmp( token, "sunshader" ) )        {
+			shaderCompilable = qfalse;
 			token = COM_ParseExt( text, qfalse );
 			if ( !token[0] ) {
 				ri.Printf( PRINT_WARNING, "WARNING: missing shader name for 'sunshader'\n" );
@@ -1550,6 +1591,7 @@ static qboolean ParseShader( char **text ) {
 		}
 //----(SA)	added
 		else if ( !Q_stricmp( token, "lightgridmulamb" ) ) { // ambient multiplier for lightgrid
+			shaderCompilable = qfalse;
 			token = COM_ParseExt( text, qfalse );
 			if ( !token[0] ) {
 				ri.Printf( PRINT_WARNING, "WARNING: missing value for 'lightgrid ambient multiplier'\n" );
@@ -1559,6 +1601,7 @@ static qboolean ParseShader( char **text ) {
 				tr.lightGridMulAmbient = atof( token );
 			}
 		} else if ( !Q_stricmp( token, "lightgridmuldir" ) )        { // directional multiplier for lightgrid
+			shaderCompilable = qfalse;
 			token = COM_ParseExt( text, qfalse );
 			if ( !token[0] ) {
 				ri.Printf( PRINT_WARNING, "WARNING: missing value for 'lightgrid directional multiplier'\n" );
@@ -1574,6 +1617,7 @@ static qboolean ParseShader( char **text ) {
 			float fogvar;
 			char fogString[64];
 
+			shaderCompilable = qfalse;
 			if ( !ParseVector( text, 3, watercolor ) ) {
 				return qfalse;
 			}
@@ -1615,6 +1659,7 @@ static qboolean ParseShader( char **text ) {
 			float fogDensity;
 			int fogFar;
 
+			shaderCompilable = qfalse;
 			if ( !ParseVector( text, 3, fogColor ) ) {
 				return qfalse;
 			}
@@ -1651,9 +1696,11 @@ static qboolean ParseShader( char **text ) {
 		// done.
 		// RF, allow each shader to permit compression if available
 		else if ( !Q_stricmp( token, "allowcompress" ) ) {
+			shaderCompilable = qfalse;
 			tr.allowCompress = qtrue;
 			continue;
 		} else if ( !Q_stricmp( token, "nocompress" ) )   {
+			shaderCompilable = qfalse;
 			tr.allowCompress = -1;
 			continue;
 		}
@@ -2373,6 +2420,418 @@ static char *FindShaderInShaderText( const char *shadername ) {
 	return NULL;
 }
 
+/*
+====================
+R_ShaderTextExists
+
+Returns qtrue if a shader script defines the given name
+====================
+*/
+qboolean R_ShaderTextExists( const char *name ) {
+	char strippedName[MAX_QPATH];
+
+	COM_StripExtension( name, strippedName );
+	return FindShaderInShaderText( strippedName ) != NULL;
+}
+
+/*
+========================================================================================
+
+COMPILED SHADERS
+
+Shaders parsed from the script text are kept in a binary form, indexed by the
+hash of their name and saved to shaders.bin, so later registrations of the same
+shader are a hash lookup and a copy instead of tokenizing the text again.  The
+file is only used while the checksum of the .shader files it was built from
+still matches.  Image pointers are not stored, the image names are, and the
+images are found again when the shader is loaded.
+
+========================================================================================
+*/
+
+#define COMPILED_SHADERS_FILE       "shaders.bin"
+#define COMPILED_SHADERS_IDENT      ( ( 'B' << 24 ) + ( 'H' << 16 ) + ( 'S' << 8 ) + 'C' )
+#define COMPILED_SHADERS_VERSION    2
+
+typedef struct {
+	int ident;
+	int version;
+	unsigned checksum;                  // of the .shader files the records were parsed from
+	int shaderSize;                     // structure sizes of the build that wrote the file
+	int stageSize;
+	int texModSize;
+} compiledShaderHeader_t;
+
+// a record is followed by numStages shaderStage_t, numImages compiledImage_t
+// and numTexMods texModInfo_t, and padded to 8 bytes
+typedef struct {
+	int size;
+	int next;                           // offset of the next record in the hash chain, 0 = none
+	int numStages;
+	int numImages;
+	int numTexMods;
+	shader_t shader;
+} compiledShader_t;
+
+typedef enum {
+	CIMG_FILE,
+	CIMG_WHITE,
+	CIMG_DLIGHT,
+	CIMG_LIGHTMAP
+} compiledImageType_t;
+
+typedef struct {
+	byte type;                          // compiledImageType_t
+	byte stage;
+	byte slot;                          // in bundle[0].image
+	byte flags;                         // CIMGF_xxx, the parms ParseStage asked for
+	char name[MAX_QPATH];
+} compiledImage_t;
+
+// the header followed by the records, allocated with malloc so it is kept
+// across renderer restarts
+static byte *compiledData;
+static int compiledSize, compiledAlloc;
+static int compiledHash[FILE_HASH_SIZE];
+static qboolean compiledDirty;
+static unsigned s_shaderTextChecksum;
+
+#define COMPILED_RECORD_SIZE( st, im, tm ) ( ( sizeof( compiledShader_t ) + ( st ) * sizeof( shaderStage_t ) + ( im ) * sizeof( compiledImage_t ) + ( tm ) * sizeof( texModInfo_t ) + 7 ) & ~7 )
+
+/*
+===============
+R_ClearCompiledShaders
+===============
+*/
+static void R_ClearCompiledShaders( void ) {
+	compiledShaderHeader_t *header;
+
+	if ( !compiledData ) {
+		compiledAlloc = 0x10000;
+		compiledData = malloc( compiledAlloc );
+		if ( !compiledData ) {
+			ri.Error( ERR_FATAL, "R_ClearCompiledShaders: out of memory" );
+		}
+	}
+
+	header = (compiledShaderHeader_t *)compiledData;
+	header->ident = COMPILED_SHADERS_IDENT;
+	header->version = COMPILED_SHADERS_VERSION;
+	header->checksum = s_shaderTextChecksum;
+	header->shaderSize = sizeof( shader_t );
+	header->stageSize = sizeof( shaderStage_t );
+	header->texModSize = sizeof( texModInfo_t );
+
+	compiledSize = ( sizeof( compiledShaderHeader_t ) + 7 ) & ~7;
+	memset( compiledHash, 0, sizeof( compiledHash ) );
+	compiledDirty = qfalse;
+}
+
+/*
+===============
+R_HashCompiledShaders
+
+Links the records into the hash chains, returns qfalse if the data is corrupt
+===============
+*/
+static qboolean R_HashCompiledShaders( void ) {
+	compiledShader_t *cs;
+	int offset, hash;
+
+	memset( compiledHash, 0, sizeof( compiledHash ) );
+
+	for ( offset = ( sizeof( compiledShaderHeader_t ) + 7 ) & ~7; offset < compiledSize; offset += cs->size ) {
+		if ( compiledSize - offset < sizeof( compiledShader_t ) ) {
+			return qfalse;
+		}
+		cs = (compiledShader_t *)( compiledData + offset );
+		if ( cs->numStages < 0 || cs->numStages > MAX_SHADER_STAGES
+			 || cs->numImages < 0 || cs->numImages > MAX_SHADER_STAGES * MAX_IMAGE_ANIMATIONS
+			 || cs->numTexMods < 0 || cs->numTexMods > MAX_SHADER_STAGES * TR_MAX_TEXMODS
+			 || cs->size != COMPILED_RECORD_SIZE( cs->numStages, cs->numImages, cs->numTexMods )
+			 || cs->size > compiledSize - offset ) {
+			return qfalse;
+		}
+		cs->shader.name[MAX_QPATH - 1] = 0;
+
+		hash = generateHashValue( cs->shader.name );
+		cs->next = compiledHash[hash];
+		compiledHash[hash] = offset;
+	}
+
+	return qtrue;
+}
+
+/*
+===============
+R_InitCompiledShaders
+
+Keeps the records in memory if they were built from the same shader files,
+otherwise reads them from shaders.bin
+===============
+*/
+static void R_InitCompiledShaders( void ) {
+	compiledShaderHeader_t *header;
+	byte *buf;
+	int len;
+
+	if ( !r_compiledShaders->integer || !s_shaderText ) {
+		free( compiledData );
+		compiledData = NULL;
+		return;
+	}
+
+	if ( compiledData && ( (compiledShaderHeader_t *)compiledData )->checksum == s_shaderTextChecksum ) {
+		return;
+	}
+
+	R_ClearCompiledShaders();
+
+	len = ri.FS_ReadFile( COMPILED_SHADERS_FILE, (void **)&buf );
+	if ( !buf ) {
+		return;
+	}
+
+	header = (compiledShaderHeader_t *)buf;
+	if ( len < sizeof( *header )
+		 || header->ident != COMPILED_SHADERS_IDENT
+		 || header->version != COMPILED_SHADERS_VERSION
+		 || header->checksum != s_shaderTextChecksum
+		 || header->shaderSize != sizeof( shader_t )
+		 || header->stageSize != sizeof( shaderStage_t )
+		 || header->texModSize != sizeof( texModInfo_t ) ) {
+		ri.FS_FreeFile( buf );
+		return;
+	}
+
+	if ( len > compiledAlloc ) {
+		free( compiledData );
+		compiledAlloc = len;
+		compiledData = malloc( compiledAlloc );
+		if ( !compiledData ) {
+			ri.Error( ERR_FATAL, "R_InitCompiledShaders: out of memory" );
+		}
+	}
+	memcpy( compiledData, buf, len );
+	compiledSize = len;
+	ri.FS_FreeFile( buf );
+
+	if ( !R_HashCompiledShaders() ) {
+		ri.Printf( PRINT_WARNING, "WARNING: %s is corrupt, ignoring it\n", COMPILED_SHADERS_FILE );
+		R_ClearCompiledShaders();
+		return;
+	}
+
+	ri.Printf( PRINT_ALL, "...loaded %i bytes of compiled shaders\n", compiledSize );
+}
+
+/*
+===============
+R_CompileShader
+
+Stores the shader that was just parsed into the global shader and stages,
+before FinishShader changes them
+===============
+*/
+static void R_CompileShader( void ) {
+	compiledShader_t *cs;
+	shaderStage_t *stage;
+	compiledImage_t *img;
+	texModInfo_t *tm;
+	int numStages, numImages, numTexMods;
+	int i, j, size, hash;
+
+	if ( !compiledData || !shaderCompilable ) {
+		return;
+	}
+
+	numStages = numImages = numTexMods = 0;
+	for ( i = 0; i < MAX_SHADER_STAGES && stages[i].active; i++ ) {
+		for ( j = 0; j < MAX_IMAGE_ANIMATIONS && stages[i].bundle[0].image[j]; j++ ) {
+			numImages++;
+		}
+		numTexMods += stages[i].bundle[0].numTexMods;
+		numStages++;
+	}
+
+	size = COMPILED_RECORD_SIZE( numStages, numImages, numTexMods );
+	if ( compiledSize + size > compiledAlloc ) {
+		byte *data;
+		int alloc;
+
+		alloc = compiledAlloc * 2;
+		while ( compiledSize + size > alloc ) {
+			alloc *= 2;
+		}
+		data = realloc( compiledData, alloc );
+		if ( !data ) {
+			return;
+		}
+		compiledData = data;
+		compiledAlloc = alloc;
+	}
+
+	cs = (compiledShader_t *)( compiledData + compiledSize );
+	memset( cs, 0, size );
+	cs->size = size;
+	cs->numStages = numStages;
+	cs->numImages = numImages;
+	cs->numTexMods = numTexMods;
+	cs->shader = shader;
+
+	stage = (shaderStage_t *)( cs + 1 );
+	img = (compiledImage_t *)( stage + numStages );
+	tm = (texModInfo_t *)( img + numImages );
+
+	for ( i = 0; i < numStages; i++, stage++ ) {
+		*stage = stages[i];
+
+		for ( j = 0; j < MAX_IMAGE_ANIMATIONS && stage->bundle[0].image[j]; j++, img++ ) {
+			image_t *image = stage->bundle[0].image[j];
+
+			img->stage = i;
+			img->slot = j;
+			if ( stage->bundle[0].isLightmap ) {
+				img->type = CIMG_LIGHTMAP;
+			} else if ( image == tr.whiteImage ) {
+				img->type = CIMG_WHITE;
+			} else if ( image == tr.dlightImage ) {
+				img->type = CIMG_DLIGHT;
+			} else {
+				img->type = CIMG_FILE;
+				img->flags = stageImageParms[i];
+				Q_strncpyz( img->name, image->imgName, sizeof( img->name ) );
+			}
+			stage->bundle[0].image[j] = NULL;
+		}
+
+		memcpy( tm, stage->bundle[0].texMods, stage->bundle[0].numTexMods * sizeof( texModInfo_t ) );
+		tm += stage->bundle[0].numTexMods;
+		stage->bundle[0].texMods = NULL;
+	}
+
+	hash = generateHashValue( cs->shader.name );
+	cs->next = compiledHash[hash];
+	compiledHash[hash] = compiledSize;
+
+	compiledSize += size;
+	compiledDirty = qtrue;
+}
+
+/*
+===============
+R_FindCompiledShader
+===============
+*/
+static compiledShader_t *R_FindCompiledShader( const char *name, int hash ) {
+	compiledShader_t *cs;
+	int offset;
+
+	if ( !compiledData ) {
+		return NULL;
+	}
+
+	for ( offset = compiledHash[hash]; offset; offset = cs->next ) {
+		cs = (compiledShader_t *)( compiledData + offset );
+		if ( !Q_stricmp( cs->shader.name, name ) ) {
+			return cs;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+===============
+R_LoadCompiledShader
+
+Copies a compiled shader into the global shader and stages, ready for
+FinishShader.  Returns qfalse and leaves them untouched if one of its
+images can't be found anymore.
+===============
+*/
+static qboolean R_LoadCompiledShader( compiledShader_t *cs ) {
+	image_t *images[MAX_SHADER_STAGES * MAX_IMAGE_ANIMATIONS];
+	shaderStage_t *stage;
+	compiledImage_t *img;
+	texModInfo_t *tm;
+	int lightmapIndex;
+	int i, numTexMods;
+
+	stage = (shaderStage_t *)( cs + 1 );
+	img = (compiledImage_t *)( stage + cs->numStages );
+	tm = (texModInfo_t *)( img + cs->numImages );
+
+	numTexMods = 0;
+	for ( i = 0; i < cs->numStages; i++ ) {
+		if ( stage[i].bundle[0].numTexMods < 0 || stage[i].bundle[0].numTexMods > TR_MAX_TEXMODS ) {
+			return qfalse;
+		}
+		numTexMods += stage[i].bundle[0].numTexMods;
+	}
+	if ( numTexMods != cs->numTexMods ) {
+		return qfalse;
+	}
+
+	// find the images first, so a missing one falls back to the text
+	lightmapIndex = shader.lightmapIndex;
+	for ( i = 0; i < cs->numImages; i++ ) {
+		if ( img[i].stage >= cs->numStages || img[i].slot >= MAX_IMAGE_ANIMATIONS ) {
+			return qfalse;
+		}
+		switch ( img[i].type ) {
+		case CIMG_WHITE:
+			images[i] = tr.whiteImage;
+			break;
+		case CIMG_DLIGHT:
+			images[i] = tr.dlightImage;
+			break;
+		case CIMG_LIGHTMAP:
+			images[i] = lightmapIndex < 0 ? tr.whiteImage : tr.lightmaps[lightmapIndex];
+			break;
+		default:
+			img[i].name[MAX_QPATH - 1] = 0;
+			images[i] = R_FindImageFileExt( img[i].name, ( img[i].flags & CIMGF_MIPMAP ) != 0, ( img[i].flags & CIMGF_PICMIP ) != 0,
+											( img[i].flags & CIMGF_CHARACTERMIP ) != 0, ( img[i].flags & CIMGF_CLAMP ) ? GL_CLAMP : GL_REPEAT );
+			if ( !images[i] ) {
+				return qfalse;
+			}
+			break;
+		}
+	}
+
+	shader = cs->shader;
+	shader.lightmapIndex = lightmapIndex;
+
+	for ( i = 0; i < cs->numStages; i++, stage++ ) {
+		stages[i] = *stage;
+		stages[i].bundle[0].texMods = texMods[i];
+		memcpy( texMods[i], tm, stage->bundle[0].numTexMods * sizeof( texModInfo_t ) );
+		tm += stage->bundle[0].numTexMods;
+	}
+	for ( i = 0; i < cs->numImages; i++ ) {
+		stages[img[i].stage].bundle[0].image[img[i].slot] = images[i];
+	}
+
+	return qtrue;
+}
+
+/*
+===============
+R_SaveCompiledShaders
+
+Writes shaders.bin if shaders were compiled since it was read
+===============
+*/
+void R_SaveCompiledShaders( void ) {
+	if ( !compiledData || !compiledDirty ) {
+		return;
+	}
+
+	ri.FS_WriteFile( COMPILED_SHADERS_FILE, compiledData, compiledSize );
+	compiledDirty = qfalse;
+}
+
 /*
 ==================
 R_FindShaderByName
@@ -2447,6 +2906,7 @@ shader_t *R_FindShader( const char *name, int lightmapIndex, qboolean mipRawImag
 	char        *shaderText;
 	image_t     *image;
 	shader_t    *sh;
+	compiledShader_t *compiled;
 
 	if ( name[0] == 0 ) {
 		return tr.defaultShader;
@@ -2511,6 +2971,17 @@ shader_t *R_FindShader( const char *name, int lightmapIndex, qboolean mipRawImag
 	shader.needsST2 = qtrue;
 	shader.needsColor = qtrue;
 
+	//
+	// attempt to define shader from the compiled form of a parameter file
+	//
+	compiled = R_FindCompiledShader( strippedName, hash );
+	if ( compiled && R_LoadCompiledShader( compiled ) ) {
+		if ( r_printShaders->integer ) {
+			ri.Printf( PRINT_ALL, "*SHADER* %s\n", name );
+		}
+		return FinishShader();
+	}
+
 	//
 	// attempt to define shader from an explicit parameter file
 	//
@@ -2522,9 +2993,12 @@ shader_t *R_FindShader( const char *name, int lightmapIndex, qboolean mipRawImag
 			ri.Printf( PRINT_ALL, "*SHADER* %s\n", name );
 		}
 
+		shaderCompilable = qtrue;
 		if ( !ParseShader( &shaderText ) ) {
 			// had errors, so use default shader
 			shader.defaultShader = qtrue;
+		} else if ( !compiled ) {
+			R_CompileShader();
 		}
 		sh = FinishShader();
 		return sh;
@@ -2961,9 +3435,13 @@ static void ScanAndLoadShaderFiles( void ) {
 	char *buffers[MAX_SHADER_FILES];
 	char *p;
 	int numShaders;
-	int i;
+	int i, len;
 
 	long sum = 0;
+	unsigned sums[2];
+
+	s_shaderTextChecksum = 0;
+
 	// scan for shader files
 	shaderFiles = ri.FS_ListFiles( "scripts", ".shader", &numShaders );
 
@@ -2983,24 +3461,35 @@ static void ScanAndLoadShaderFiles( void ) {
 
 		Com_sprintf( filename, sizeof( filename ), "scripts/%s", shaderFiles[i] );
 		ri.Printf( PRINT_ALL, "...loading '%s'\n", filename );
-		sum += ri.FS_ReadFile( filename, (void **)&buffers[i] );
+		len = ri.FS_ReadFile( filename, (void **)&buffers[i] );
 		if ( !buffers[i] ) {
 			ri.Error( ERR_DROP, "Couldn't load %s", filename );
 		}
+		sum += len;
+
+		// the compiled shaders are only valid for this exact set of files
+		sums[0] = Com_BlockChecksum( filename, strlen( filename ) );
+		sums[1] = Com_BlockChecksum( buffers[i], len );
+		s_shaderTextChecksum = Com_BlockChecksumKey( sums, sizeof( sums ), s_shaderTextChecksum );
 	}
 
 	// build single large buffer
 	s_shaderText = ri.Hunk_Alloc( sum + numShaders * 2, h_low );
 
 	// free in reverse order, so the temp files are all dumped
+	// append at a running end pointer, rescanning the whole text
+	// with strcat for every file made this quadratic in the total size
+	p = s_shaderText;
 	for ( i = numShaders - 1; i >= 0 ; i-- ) {
-		strcat( s_shaderText, "\n" );
-		p = &s_shaderText[strlen( s_shaderText )];
-		strcat( s_shaderText, buffers[i] );
+		*p++ = '\n';
+		len = strlen( buffers[i] );
+		memcpy( p, buffers[i], len );
 		ri.FS_FreeFile( buffers[i] );
 		buffers[i] = p;
+		p += len;
 //		COM_Compress(p);
 	}
+	*p = 0;
 
 	// free up memory
 	ri.FS_FreeFileList( shaderFiles );
@@ -3300,6 +3789,8 @@ void R_InitShaders( void ) {
 
 	ScanAndLoadShaderFiles();
 
+	R_InitCompiledShaders();
+
 	CreateExternalShaders();
 
 	// Ridah
@@ -56,6 +56,211 @@ static unsigned short indexes[6*MAX_EDGE_DEFS*SHADER_MAX_VERTEXES];
 static int idx = 0;
 #endif
 
+/*
+  Triangle adjacency for the MD3/MDC surfaces, built at load when
+  r_shadows is 2, so the silhouette is found with one pass over the
+  triangles instead of matching edges per vertex every frame.
+
+  neighbors[ tri * 3 + edge ] is the triangle sharing that edge reversed,
+  -1 if there is none, or -2 - n for an overfanned edge where
+  neighbors[ n ] is a count followed by that many triangles.
+*/
+
+typedef struct shadowEdges_s {
+	void        *surf;
+	int         *neighbors;
+	struct shadowEdges_s *hashNext;
+} shadowEdges_t;
+
+typedef struct {
+	shadowEdges_t   *edges;
+	int firstIndex;
+	int numTriangles;
+} shadowSurf_t;
+
+typedef struct {
+	int v1, v2;
+	int tri;
+} shadowEdgeSort_t;
+
+#define SHADOW_EDGES_HASH_SIZE  1024
+#define MAX_SHADOW_SURFS        64
+
+static shadowEdges_t    *shadowEdgesHash[SHADOW_EDGES_HASH_SIZE];
+
+static shadowSurf_t shadowSurfs[MAX_SHADOW_SURFS];
+static int numShadowSurfs;
+static qboolean useShadowSurfs;
+
+#define SHADOW_EDGES_HASH( surf ) ( ( (size_t)( surf ) >> 4 ) & ( SHADOW_EDGES_HASH_SIZE - 1 ) )
+
+/*
+=================
+R_ClearShadowEdges
+=================
+*/
+void R_ClearShadowEdges( void ) {
+	memset( shadowEdgesHash, 0, sizeof( shadowEdgesHash ) );
+	numShadowSurfs = 0;
+}
+
+static int R_CompareShadowEdges( const void *a, const void *b ) {
+	const shadowEdgeSort_t *e1 = a, *e2 = b;
+
+	if ( e1->v1 != e2->v1 ) {
+		return e1->v1 - e2->v1;
+	}
+	return e1->v2 - e2->v2;
+}
+
+/*
+=================
+R_FindReverseEdges
+
+Returns the first of the sorted edges running v2 -> v1, and the count in *count
+=================
+*/
+static shadowEdgeSort_t *R_FindReverseEdges( shadowEdgeSort_t *sorted, int numEdges, int v1, int v2, int *count ) {
+	shadowEdgeSort_t key, *e;
+	int lo, hi, mid;
+
+	key.v1 = v2;
+	key.v2 = v1;
+
+	lo = 0;
+	hi = numEdges;
+	while ( lo < hi ) {
+		mid = ( lo + hi ) >> 1;
+		if ( R_CompareShadowEdges( &sorted[mid], &key ) < 0 ) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	e = &sorted[lo];
+	for ( *count = 0 ; lo + *count < numEdges && !R_CompareShadowEdges( &e[*count], &key ) ; ( *count )++ ) {
+	}
+
+	return e;
+}
+
+/*
+=================
+R_BuildShadowEdges
+=================
+*/
+void R_BuildShadowEdges( void *surf, const int *triangles, int numTriangles ) {
+	shadowEdges_t       *se;
+	shadowEdgeSort_t    *sorted, *e;
+	int numEdges, numOverflow;
+	int i, j, c, hash;
+
+	if ( numTriangles <= 0 ) {
+		return;
+	}
+
+	numEdges = numTriangles * 3;
+	sorted = ri.Hunk_AllocateTempMemory( numEdges * sizeof( *sorted ) );
+	for ( i = 0 ; i < numEdges ; i++ ) {
+		sorted[i].v1 = triangles[i];
+		sorted[i].v2 = triangles[( i % 3 ) == 2 ? i - 2 : i + 1];
+		sorted[i].tri = i / 3;
+	}
+	qsort( sorted, numEdges, sizeof( *sorted ), R_CompareShadowEdges );
+
+	// size the lists for overfanned edges
+	numOverflow = 0;
+	for ( i = 0 ; i < numEdges ; i++ ) {
+		R_FindReverseEdges( sorted, numEdges, triangles[i], triangles[( i % 3 ) == 2 ? i - 2 : i + 1], &c );
+		if ( c > 1 ) {
+			numOverflow += 1 + c;
+		}
+	}
+
+	se = ri.Hunk_Alloc( sizeof( *se ) + ( numEdges + numOverflow ) * sizeof( int ), h_low );
+	se->surf = surf;
+	se->neighbors = (int *)( se + 1 );
+
+	numOverflow = numEdges;
+	for ( i = 0 ; i < numEdges ; i++ ) {
+		e = R_FindReverseEdges( sorted, numEdges, triangles[i], triangles[( i % 3 ) == 2 ? i - 2 : i + 1], &c );
+		if ( !c ) {
+			se->neighbors[i] = -1;
+		} else if ( c == 1 ) {
+			se->neighbors[i] = e->tri;
+		} else {
+			se->neighbors[i] = -2 - numOverflow;
+			se->neighbors[numOverflow++] = c;
+			for ( j = 0 ; j < c ; j++ ) {
+				se->neighbors[numOverflow++] = e[j].tri;
+			}
+		}
+	}
+
+	ri.Hunk_FreeTempMemory( sorted );
+
+	hash = SHADOW_EDGES_HASH( surf );
+	se->hashNext = shadowEdgesHash[hash];
+	shadowEdgesHash[hash] = se;
+}
+
+/*
+=================
+RB_AddShadowSurface
+
+Called by the mesh surface functions, so RB_ShadowTessEnd knows where
+the precomputed edges of each surface in the batch start
+=================
+*/
+void RB_AddShadowSurface( void *surf, int numTriangles ) {
+	shadowEdges_t   *se;
+
+	if ( tess.shader != tr.shadowShader ) {
+		return;
+	}
+
+	if ( tess.numIndexes == 0 ) {
+		numShadowSurfs = 0;
+	}
+	if ( numShadowSurfs == MAX_SHADOW_SURFS ) {
+		return;
+	}
+
+	for ( se = shadowEdgesHash[SHADOW_EDGES_HASH( surf )] ; se ; se = se->hashNext ) {
+		if ( se->surf == surf ) {
+			break;
+		}
+	}
+
+	shadowSurfs[numShadowSurfs].edges = se;
+	shadowSurfs[numShadowSurfs].firstIndex = tess.numIndexes;
+	shadowSurfs[numShadowSurfs].numTriangles = numTriangles;
+	numShadowSurfs++;
+}
+
+/*
+=================
+RB_ShadowSurfacesCoverTess
+
+The precomputed edges can only be used if every triangle in tess came
+from a surface that has them
+=================
+*/
+static qboolean RB_ShadowSurfacesCoverTess( void ) {
+	int i, numIndexes;
+
+	numIndexes = 0;
+	for ( i = 0 ; i < numShadowSurfs ; i++ ) {
+		if ( !shadowSurfs[i].edges || shadowSurfs[i].firstIndex != numIndexes ) {
+			return qfalse;
+		}
+		numIndexes += shadowSurfs[i].numTriangles * 3;
+	}
+
+	return ( numShadowSurfs && numIndexes == tess.numIndexes );
+}
+
 void R_AddEdgeDef( int i1, int i2, int facing ) {
 	int c;
 
@@ -69,9 +274,89 @@ void R_AddEdgeDef( int i1, int i2, int facing ) {
 	numEdgeDefs[ i1 ]++;
 }
 
+static void R_RenderShadowEdge( int i, int i2 ) {
+	#ifdef HAVE_GLES
+	// A single drawing call is better than many. So I prefer a singe TRIANGLES call than many TRAINGLE_STRIP call
+	// even if it seems less efficiant, it's faster on the PANDORA
+	indexes[idx++] = i;
+	indexes[idx++] = i + tess.numVertexes;
+	indexes[idx++] = i2;
+	indexes[idx++] = i2;
+	indexes[idx++] = i + tess.numVertexes;
+	indexes[idx++] = i2 + tess.numVertexes;
+	#else
+	qglBegin( GL_TRIANGLE_STRIP );
+	qglVertex3fv( tess.xyz[ i ] );
+	qglVertex3fv( tess.xyz[ i + tess.numVertexes ] );
+	qglVertex3fv( tess.xyz[ i2 ] );
+	qglVertex3fv( tess.xyz[ i2 + tess.numVertexes ] );
+	qglEnd();
+	#endif
+}
+
+/*
+=================
+R_RenderShadowSilhouette
+
+A front facing triangle edge is a silhouette edge if no triangle across
+it also faces the light
+=================
+*/
+static void R_RenderShadowSilhouette( void ) {
+	shadowSurf_t    *ss;
+	glIndex_t       *tri;
+	int             *neighbors, *list;
+	int i, j, k, n, firstTri, numTris;
+
+	for ( i = 0, ss = shadowSurfs ; i < numShadowSurfs ; i++, ss++ ) {
+		neighbors = ss->edges->neighbors;
+		firstTri = ss->firstIndex / 3;
+		numTris = ss->numTriangles;
+		tri = tess.indexes + ss->firstIndex;
+
+		for ( j = 0 ; j < numTris ; j++, tri += 3, neighbors += 3 ) {
+			if ( !facing[ firstTri + j ] ) {
+				continue;
+			}
+
+			for ( k = 0 ; k < 3 ; k++ ) {
+				n = neighbors[k];
+				if ( n >= 0 ) {
+					if ( facing[ firstTri + n ] ) {
+						continue;
+					}
+				} else if ( n < -1 ) {
+					list = ss->edges->neighbors + ( -2 - n );
+					for ( n = list[0] ; n > 0 ; n-- ) {
+						if ( facing[ firstTri + list[n] ] ) {
+							break;
+						}
+					}
+					if ( n > 0 ) {
+						continue;
+					}
+				}
+
+				R_RenderShadowEdge( tri[k], tri[k == 2 ? 0 : k + 1] );
+			}
+		}
+	}
+}
+
 void R_RenderShadowEdges( void ) {
 	int i;
 
+	if ( useShadowSurfs ) {
+		#ifdef HAVE_GLES
+		idx = 0;
+		#endif
+		R_RenderShadowSilhouette();
+		#ifdef HAVE_GLES
+		qglDrawElements( GL_TRIANGLES, idx, GL_UNSIGNED_SHORT, indexes );
+		#endif
+		return;
+	}
+
 #if 0
 	int numTris;
 
@@ -138,23 +423,7 @@ void R_RenderShadowEdges( void ) {
 			// if it doesn't share the edge with another front facing
 			// triangle, it is a sil edge
 			if ( hit[ 1 ] == 0 ) {
-				#ifdef HAVE_GLES
-				// A single drawing call is better than many. So I prefer a singe TRIANGLES call than many TRAINGLE_STRIP call
-				// even if it seems less efficiant, it's faster on the PANDORA
-				indexes[idx++] = i;
-				indexes[idx++] = i + tess.numVertexes;
-				indexes[idx++] = i2;
-				indexes[idx++] = i2;
-				indexes[idx++] = i + tess.numVertexes;
-				indexes[idx++] = i2 + tess.numVertexes;
-				#else
-				qglBegin( GL_TRIANGLE_STRIP );
-				qglVertex3fv( tess.xyz[ i ] );
-				qglVertex3fv( tess.xyz[ i + tess.numVertexes ] );
-				qglVertex3fv( tess.xyz[ i2 ] );
-				qglVertex3fv( tess.xyz[ i2 + tess.numVertexes ] );
-				qglEnd();
-				#endif
+				R_RenderShadowEdge( i, i2 );
 				c_edges++;
 			} else {
 				c_rejected++;
@@ -185,6 +454,9 @@ void RB_ShadowTessEnd( void ) {
 	int numTris;
 	vec3_t lightDir;
 
+	useShadowSurfs = RB_ShadowSurfacesCoverTess();
+	numShadowSurfs = 0;
+
 	// we can only do this if we have enough space in the vertex buffers
 	if ( tess.numVertexes >= SHADER_MAX_VERTEXES / 2 ) {
 		return;
@@ -202,7 +474,9 @@ void RB_ShadowTessEnd( void ) {
 	}
 
 	// decide which triangles face the light
-	memset( numEdgeDefs, 0, 4 * tess.numVertexes );
+	if ( !useShadowSurfs ) {
+		memset( numEdgeDefs, 0, 4 * tess.numVertexes );
+	}
 
 	numTris = tess.numIndexes / 3;
 	for ( i = 0 ; i < numTris ; i++ ) {
@@ -231,9 +505,11 @@ void RB_ShadowTessEnd( void ) {
 		}
 
 		// create the edges
-		R_AddEdgeDef( i1, i2, facing[ i ] );
-		R_AddEdgeDef( i2, i3, facing[ i ] );
-		R_AddEdgeDef( i3, i1, facing[ i ] );
+		if ( !useShadowSurfs ) {
+			R_AddEdgeDef( i1, i2, facing[ i ] );
+			R_AddEdgeDef( i2, i3, facing[ i ] );
+			R_AddEdgeDef( i3, i1, facing[ i ] );
+		}
 	}
 
 	// draw the silhouette edges
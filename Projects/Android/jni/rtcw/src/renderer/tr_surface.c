@@ -29,6 +29,12 @@ If you have questions concerning this license or the applicable additional terms
 // tr_surf.c
 #include "tr_local.h"
 
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+#elif defined( __SSE__ )
+#include <xmmintrin.h>
+#endif
+
 /*
 
   THIS ENTIRE FILE IS BACK END
@@ -762,103 +768,256 @@ static void VectorArrayNormalize( vec4_t *normals, unsigned int count ) {
 
 
 /*
-** LerpMeshVertexes
+** decoded mesh frame cache
+**
+** MD3 and MDC frames are decoded to floats once and reused by every entity
+** and both eyes showing the same frame, until the space gets recycled
 */
-static void LerpMeshVertexes( md3Surface_t *surf, float backlerp ) {
-	short   *oldXyz, *newXyz, *oldNormals, *newNormals;
-	float   *outXyz, *outNormal;
-	float oldXyzScale, newXyzScale;
-	float oldNormalScale, newNormalScale;
-	int vertNum;
-	unsigned lat, lng;
+#define MESH_CACHE_FRAMES   128
+#define MESH_CACHE_VERTS    16384       // must hold at least two MD3_MAX_VERTS frames
+
+typedef struct {
+	void        *surf;
+	int frame;
+	int firstVert;
 	int numVerts;
+	int lastUsed;
+} meshCacheFrame_t;
 
-	outXyz = tess.xyz[tess.numVertexes];
-	outNormal = tess.normal[tess.numVertexes];
+static meshCacheFrame_t meshCacheFrames[MESH_CACHE_FRAMES];
+static vec4_t meshCacheXyz[MESH_CACHE_VERTS];
+static vec4_t meshCacheNormal[MESH_CACHE_VERTS];
+static int meshCacheNextVert;
+static int meshCacheCount;
+static meshCacheFrame_t *meshCachePinned;  // frame that must survive the next alloc
 
-	newXyz = ( short * )( (byte *)surf + surf->ofsXyzNormals )
-			 + ( backEnd.currentEntity->e.frame * surf->numVerts * 4 );
-	newNormals = newXyz + 3;
+/*
+** R_ClearMeshCache
+*/
+void R_ClearMeshCache( void ) {
+	memset( meshCacheFrames, 0, sizeof( meshCacheFrames ) );
+	meshCacheNextVert = 0;
+	meshCacheCount = 0;
+	meshCachePinned = NULL;
+}
 
-	newXyzScale = MD3_XYZ_SCALE * ( 1.0 - backlerp );
-	newNormalScale = 1.0 - backlerp;
+/*
+** RB_FindMeshCacheFrame
+*/
+static meshCacheFrame_t *RB_FindMeshCacheFrame( void *surf, int frame ) {
+	meshCacheFrame_t    *cf;
+	int i;
 
-	numVerts = surf->numVerts;
+	meshCacheCount++;
 
-	if ( backlerp == 0 ) {
-		//
-		// just copy the vertexes
-		//
-		for ( vertNum = 0 ; vertNum < numVerts ; vertNum++,
-			  newXyz += 4, newNormals += 4,
-			  outXyz += 4, outNormal += 4 )
-		{
+	for ( i = 0, cf = meshCacheFrames; i < MESH_CACHE_FRAMES; i++, cf++ ) {
+		if ( cf->surf == surf && cf->frame == frame ) {
+			cf->lastUsed = meshCacheCount;
+			return cf;
+		}
+	}
 
-			outXyz[0] = newXyz[0] * newXyzScale;
-			outXyz[1] = newXyz[1] * newXyzScale;
-			outXyz[2] = newXyz[2] * newXyzScale;
+	return NULL;
+}
 
-			lat = ( newNormals[0] >> 8 ) & 0xff;
-			lng = ( newNormals[0] & 0xff );
-			lat *= ( FUNCTABLE_SIZE / 256 );
-			lng *= ( FUNCTABLE_SIZE / 256 );
+/*
+** RB_AllocMeshCacheFrame
+**
+** Takes the next numVerts of the vertex ring, dropping any frames that
+** were stored there, and the least recently used frame slot.
+** The pinned frame (the other half of a lerp) is never dropped or reused,
+** the ring skips over its vertexes instead.
+*/
+static meshCacheFrame_t *RB_AllocMeshCacheFrame( void *surf, int frame, int numVerts ) {
+	meshCacheFrame_t    *cf, *oldest, *pin;
+	int i, first;
 
-			// decode X as cos( lat ) * sin( long )
-			// decode Y as sin( lat ) * sin( long )
-			// decode Z as cos( long )
+	pin = meshCachePinned;
 
-			outNormal[0] = tr.sinTable[( lat + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK] * tr.sinTable[lng];
-			outNormal[1] = tr.sinTable[lat] * tr.sinTable[lng];
-			outNormal[2] = tr.sinTable[( lng + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK];
+	if ( meshCacheNextVert + numVerts > MESH_CACHE_VERTS ) {
+		meshCacheNextVert = 0;
+	}
+	if ( pin && pin->firstVert < meshCacheNextVert + numVerts && pin->firstVert + pin->numVerts > meshCacheNextVert ) {
+		// MESH_CACHE_VERTS holds two full frames, so if there is no room after it there is before it
+		meshCacheNextVert = pin->firstVert + pin->numVerts;
+		if ( meshCacheNextVert + numVerts > MESH_CACHE_VERTS ) {
+			meshCacheNextVert = 0;
 		}
-	} else {
-		//
-		// interpolate and copy the vertex and normal
-		//
-		oldXyz = ( short * )( (byte *)surf + surf->ofsXyzNormals )
-				 + ( backEnd.currentEntity->e.oldframe * surf->numVerts * 4 );
-		oldNormals = oldXyz + 3;
-
-		oldXyzScale = MD3_XYZ_SCALE * backlerp;
-		oldNormalScale = backlerp;
-
-		for ( vertNum = 0 ; vertNum < numVerts ; vertNum++,
-			  oldXyz += 4, newXyz += 4, oldNormals += 4, newNormals += 4,
-			  outXyz += 4, outNormal += 4 )
-		{
-			vec3_t uncompressedOldNormal, uncompressedNewNormal;
-
-			// interpolate the xyz
-			outXyz[0] = oldXyz[0] * oldXyzScale + newXyz[0] * newXyzScale;
-			outXyz[1] = oldXyz[1] * oldXyzScale + newXyz[1] * newXyzScale;
-			outXyz[2] = oldXyz[2] * oldXyzScale + newXyz[2] * newXyzScale;
-
-			// FIXME: interpolate lat/long instead?
-			lat = ( newNormals[0] >> 8 ) & 0xff;
-			lng = ( newNormals[0] & 0xff );
-			lat *= 4;
-			lng *= 4;
-			uncompressedNewNormal[0] = tr.sinTable[( lat + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK] * tr.sinTable[lng];
-			uncompressedNewNormal[1] = tr.sinTable[lat] * tr.sinTable[lng];
-			uncompressedNewNormal[2] = tr.sinTable[( lng + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK];
-
-			lat = ( oldNormals[0] >> 8 ) & 0xff;
-			lng = ( oldNormals[0] & 0xff );
-			lat *= 4;
-			lng *= 4;
-
-			uncompressedOldNormal[0] = tr.sinTable[( lat + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK] * tr.sinTable[lng];
-			uncompressedOldNormal[1] = tr.sinTable[lat] * tr.sinTable[lng];
-			uncompressedOldNormal[2] = tr.sinTable[( lng + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK];
-
-			outNormal[0] = uncompressedOldNormal[0] * oldNormalScale + uncompressedNewNormal[0] * newNormalScale;
-			outNormal[1] = uncompressedOldNormal[1] * oldNormalScale + uncompressedNewNormal[1] * newNormalScale;
-			outNormal[2] = uncompressedOldNormal[2] * oldNormalScale + uncompressedNewNormal[2] * newNormalScale;
-
-//			VectorNormalize (outNormal);
+	}
+	first = meshCacheNextVert;
+	meshCacheNextVert += numVerts;
+
+	oldest = NULL;
+	for ( i = 0, cf = meshCacheFrames; i < MESH_CACHE_FRAMES; i++, cf++ ) {
+		if ( cf == pin ) {
+			continue;
+		}
+		if ( cf->surf && cf->firstVert < first + numVerts && cf->firstVert + cf->numVerts > first ) {
+			cf->surf = NULL;
+			cf->lastUsed = 0;
+		}
+		if ( !oldest || cf->lastUsed < oldest->lastUsed ) {
+			oldest = cf;
 		}
-		VectorArrayNormalize( (vec4_t *)tess.normal[tess.numVertexes], numVerts );
 	}
+
+	oldest->surf = surf;
+	oldest->frame = frame;
+	oldest->firstVert = first;
+	oldest->numVerts = numVerts;
+	oldest->lastUsed = meshCacheCount;
+
+	return oldest;
+}
+
+/*
+** RB_MD3Frame
+*/
+static meshCacheFrame_t *RB_MD3Frame( md3Surface_t *surf, int frame ) {
+	meshCacheFrame_t    *cf;
+	short               *xyz;
+	float               *outXyz, *outNormal;
+	int vertNum;
+
+	cf = RB_FindMeshCacheFrame( surf, frame );
+	if ( cf ) {
+		return cf;
+	}
+
+	cf = RB_AllocMeshCacheFrame( surf, frame, surf->numVerts );
+	outXyz = meshCacheXyz[cf->firstVert];
+	outNormal = meshCacheNormal[cf->firstVert];
+
+	xyz = ( short * )( (byte *)surf + surf->ofsXyzNormals ) + ( frame * surf->numVerts * 4 );
+
+	for ( vertNum = 0 ; vertNum < surf->numVerts ; vertNum++, xyz += 4, outXyz += 4, outNormal += 4 ) {
+		outXyz[0] = xyz[0] * MD3_XYZ_SCALE;
+		outXyz[1] = xyz[1] * MD3_XYZ_SCALE;
+		outXyz[2] = xyz[2] * MD3_XYZ_SCALE;
+		outXyz[3] = 0;
+
+		R_LatLongToNormal( outNormal, xyz[3] );
+		outNormal[3] = 0;
+	}
+
+	return cf;
+}
+
+/*
+** RB_MDCFrame
+*/
+static meshCacheFrame_t *RB_MDCFrame( mdcSurface_t *surf, int frame ) {
+	meshCacheFrame_t    *cf;
+	short               *xyz, *comp;
+	mdcXyzCompressed_t  *xyzComp;
+	float               *outXyz, *outNormal;
+	vec3_t ofsVec;
+	int base, vertNum;
+
+	cf = RB_FindMeshCacheFrame( surf, frame );
+	if ( cf ) {
+		return cf;
+	}
+
+	cf = RB_AllocMeshCacheFrame( surf, frame, surf->numVerts );
+	outXyz = meshCacheXyz[cf->firstVert];
+	outNormal = meshCacheNormal[cf->firstVert];
+
+	base = (int)*( ( short * )( (byte *)surf + surf->ofsFrameBaseFrames ) + frame );
+	xyz = ( short * )( (byte *)surf + surf->ofsXyzNormals ) + ( base * surf->numVerts * 4 );
+
+	xyzComp = NULL;
+	if ( surf->numCompFrames > 0 ) {
+		comp = ( short * )( (byte *)surf + surf->ofsFrameCompFrames ) + frame;
+		if ( *comp >= 0 ) {
+			xyzComp = ( mdcXyzCompressed_t * )( (byte *)surf + surf->ofsXyzCompressed ) + ( *comp * surf->numVerts );
+		}
+	}
+
+	for ( vertNum = 0 ; vertNum < surf->numVerts ; vertNum++, xyz += 4, outXyz += 4, outNormal += 4 ) {
+		outXyz[0] = xyz[0] * MD3_XYZ_SCALE;
+		outXyz[1] = xyz[1] * MD3_XYZ_SCALE;
+		outXyz[2] = xyz[2] * MD3_XYZ_SCALE;
+		outXyz[3] = 0;
+
+		// add the compressed ofsVec
+		if ( xyzComp ) {
+			R_MDC_DecodeXyzCompressed( xyzComp->ofsVec, ofsVec, outNormal );
+			xyzComp++;
+			VectorAdd( outXyz, ofsVec, outXyz );
+		} else {
+			R_LatLongToNormal( outNormal, xyz[3] );
+		}
+		outNormal[3] = 0;
+	}
+
+	return cf;
+}
+
+/*
+** RB_LerpVec4Array
+**
+** out = a * fa + b * fb
+*/
+static void RB_LerpVec4Array( vec4_t *out, const vec4_t *a, const vec4_t *b, float fa, float fb, int count ) {
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	for ( ; count > 0 ; count--, out++, a++, b++ ) {
+		vst1q_f32( *out, vmlaq_n_f32( vmulq_n_f32( vld1q_f32( *a ), fa ), vld1q_f32( *b ), fb ) );
+	}
+#elif defined( __SSE__ )
+	__m128 va = _mm_set1_ps( fa ), vb = _mm_set1_ps( fb );
+
+	for ( ; count > 0 ; count--, out++, a++, b++ ) {
+		_mm_storeu_ps( *out, _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( *a ), va ), _mm_mul_ps( _mm_loadu_ps( *b ), vb ) ) );
+	}
+#else
+	for ( ; count > 0 ; count--, out++, a++, b++ ) {
+		( *out )[0] = ( *a )[0] * fa + ( *b )[0] * fb;
+		( *out )[1] = ( *a )[1] * fa + ( *b )[1] * fb;
+		( *out )[2] = ( *a )[2] * fa + ( *b )[2] * fb;
+	}
+#endif
+}
+
+/*
+** RB_LerpMeshFrames
+**
+** Static frames are copied straight from the cache
+*/
+static void RB_LerpMeshFrames( meshCacheFrame_t *oldFrame, meshCacheFrame_t *newFrame, float backlerp ) {
+	int numVerts;
+
+	numVerts = newFrame->numVerts;
+
+	if ( backlerp == 0 ) {
+		memcpy( tess.xyz[tess.numVertexes], meshCacheXyz[newFrame->firstVert], numVerts * sizeof( vec4_t ) );
+		memcpy( tess.normal[tess.numVertexes], meshCacheNormal[newFrame->firstVert], numVerts * sizeof( vec4_t ) );
+		return;
+	}
+
+	RB_LerpVec4Array( tess.xyz + tess.numVertexes, meshCacheXyz + oldFrame->firstVert, meshCacheXyz + newFrame->firstVert,
+					  backlerp, 1.0 - backlerp, numVerts );
+	RB_LerpVec4Array( tess.normal + tess.numVertexes, meshCacheNormal + oldFrame->firstVert, meshCacheNormal + newFrame->firstVert,
+					  backlerp, 1.0 - backlerp, numVerts );
+	VectorArrayNormalize( tess.normal + tess.numVertexes, numVerts );
+}
+
+/*
+** LerpMeshVertexes
+*/
+static void LerpMeshVertexes( md3Surface_t *surf, float backlerp ) {
+	meshCacheFrame_t    *oldFrame, *newFrame;
+
+	newFrame = RB_MD3Frame( surf, backEnd.currentEntity->e.frame );
+	oldFrame = NULL;
+	if ( backlerp != 0 ) {
+		// keep newFrame from being recycled to make room for oldFrame
+		meshCachePinned = newFrame;
+		oldFrame = RB_MD3Frame( surf, backEnd.currentEntity->e.oldframe );
+		meshCachePinned = NULL;
+	}
+
+	RB_LerpMeshFrames( oldFrame, newFrame, backlerp );
 }
 
 /*
@@ -889,6 +1048,7 @@ void RB_SurfaceMesh( md3Surface_t *surface ) {
 	}
 
 	RB_CHECKOVERFLOW( surface->numVerts, surface->numTriangles * 3 );
+	RB_AddShadowSurface( surface, surface->numTriangles );
 
 	LerpMeshVertexes( surface, backlerp );
 
@@ -939,141 +1099,18 @@ void R_LatLongToNormal( vec3_t outNormal, short latLong ) {
 ** LerpCMeshVertexes
 */
 static void LerpCMeshVertexes( mdcSurface_t *surf, float backlerp ) {
-	short   *oldXyz, *newXyz, *oldNormals, *newNormals;
-	float   *outXyz, *outNormal;
-	float oldXyzScale, newXyzScale;
-	float oldNormalScale, newNormalScale;
-	int vertNum;
-	unsigned lat, lng;
-	int numVerts;
-
-	int oldBase, newBase;
-	short   *oldComp = NULL, *newComp = NULL; // TTimo: init
-	mdcXyzCompressed_t *oldXyzComp = NULL, *newXyzComp = NULL; // TTimo: init
-	vec3_t oldOfsVec, newOfsVec;
-
-	qboolean hasComp;
-
-	outXyz = tess.xyz[tess.numVertexes];
-	outNormal = tess.normal[tess.numVertexes];
-
-	newBase = (int)*( ( short * )( (byte *)surf + surf->ofsFrameBaseFrames ) + backEnd.currentEntity->e.frame );
-	newXyz = ( short * )( (byte *)surf + surf->ofsXyzNormals )
-			 + ( newBase * surf->numVerts * 4 );
-	newNormals = newXyz + 3;
-
-	hasComp = ( surf->numCompFrames > 0 );
-	if ( hasComp ) {
-		newComp = ( ( short * )( (byte *)surf + surf->ofsFrameCompFrames ) + backEnd.currentEntity->e.frame );
-		if ( *newComp >= 0 ) {
-			newXyzComp = ( mdcXyzCompressed_t * )( (byte *)surf + surf->ofsXyzCompressed )
-						 + ( *newComp * surf->numVerts );
-		}
+	meshCacheFrame_t    *oldFrame, *newFrame;
+
+	newFrame = RB_MDCFrame( surf, backEnd.currentEntity->e.frame );
+	oldFrame = NULL;
+	if ( backlerp != 0 ) {
+		// keep newFrame from being recycled to make room for oldFrame
+		meshCachePinned = newFrame;
+		oldFrame = RB_MDCFrame( surf, backEnd.currentEntity->e.oldframe );
+		meshCachePinned = NULL;
 	}
 
-	newXyzScale = MD3_XYZ_SCALE * ( 1.0 - backlerp );
-	newNormalScale = 1.0 - backlerp;
-
-	numVerts = surf->numVerts;
-
-	if ( backlerp == 0 ) {
-		//
-		// just copy the vertexes
-		//
-		for ( vertNum = 0 ; vertNum < numVerts ; vertNum++,
-			  newXyz += 4, newNormals += 4,
-			  outXyz += 4, outNormal += 4 )
-		{
-
-			outXyz[0] = newXyz[0] * newXyzScale;
-			outXyz[1] = newXyz[1] * newXyzScale;
-			outXyz[2] = newXyz[2] * newXyzScale;
-
-			// add the compressed ofsVec
-			if ( hasComp && *newComp >= 0 ) {
-				R_MDC_DecodeXyzCompressed( newXyzComp->ofsVec, newOfsVec, outNormal );
-				newXyzComp++;
-				VectorAdd( outXyz, newOfsVec, outXyz );
-			} else {
-				lat = ( newNormals[0] >> 8 ) & 0xff;
-				lng = ( newNormals[0] & 0xff );
-				lat *= 4;
-				lng *= 4;
-
-				outNormal[0] = tr.sinTable[( lat + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK] * tr.sinTable[lng];
-				outNormal[1] = tr.sinTable[lat] * tr.sinTable[lng];
-				outNormal[2] = tr.sinTable[( lng + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK];
-			}
-		}
-	} else {
-		//
-		// interpolate and copy the vertex and normal
-		//
-		oldBase = (int)*( ( short * )( (byte *)surf + surf->ofsFrameBaseFrames ) + backEnd.currentEntity->e.oldframe );
-		oldXyz = ( short * )( (byte *)surf + surf->ofsXyzNormals )
-				 + ( oldBase * surf->numVerts * 4 );
-		oldNormals = oldXyz + 3;
-
-		if ( hasComp ) {
-			oldComp = ( ( short * )( (byte *)surf + surf->ofsFrameCompFrames ) + backEnd.currentEntity->e.oldframe );
-			if ( *oldComp >= 0 ) {
-				oldXyzComp = ( mdcXyzCompressed_t * )( (byte *)surf + surf->ofsXyzCompressed )
-							 + ( *oldComp * surf->numVerts );
-			}
-		}
-
-		oldXyzScale = MD3_XYZ_SCALE * backlerp;
-		oldNormalScale = backlerp;
-
-		for ( vertNum = 0 ; vertNum < numVerts ; vertNum++,
-			  oldXyz += 4, newXyz += 4, oldNormals += 4, newNormals += 4,
-			  outXyz += 4, outNormal += 4 )
-		{
-			vec3_t uncompressedOldNormal, uncompressedNewNormal;
-
-			// interpolate the xyz
-			outXyz[0] = oldXyz[0] * oldXyzScale + newXyz[0] * newXyzScale;
-			outXyz[1] = oldXyz[1] * oldXyzScale + newXyz[1] * newXyzScale;
-			outXyz[2] = oldXyz[2] * oldXyzScale + newXyz[2] * newXyzScale;
-
-			// add the compressed ofsVec
-			if ( hasComp && *newComp >= 0 ) {
-				R_MDC_DecodeXyzCompressed( newXyzComp->ofsVec, newOfsVec, uncompressedNewNormal );
-				newXyzComp++;
-				VectorMA( outXyz, 1.0 - backlerp, newOfsVec, outXyz );
-			} else {
-				lat = ( newNormals[0] >> 8 ) & 0xff;
-				lng = ( newNormals[0] & 0xff );
-				lat *= 4;
-				lng *= 4;
-
-				uncompressedNewNormal[0] = tr.sinTable[( lat + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK] * tr.sinTable[lng];
-				uncompressedNewNormal[1] = tr.sinTable[lat] * tr.sinTable[lng];
-				uncompressedNewNormal[2] = tr.sinTable[( lng + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK];
-			}
-
-			if ( hasComp && *oldComp >= 0 ) {
-				R_MDC_DecodeXyzCompressed( oldXyzComp->ofsVec, oldOfsVec, uncompressedOldNormal );
-				oldXyzComp++;
-				VectorMA( outXyz, backlerp, oldOfsVec, outXyz );
-			} else {
-				lat = ( oldNormals[0] >> 8 ) & 0xff;
-				lng = ( oldNormals[0] & 0xff );
-				lat *= 4;
-				lng *= 4;
-
-				uncompressedOldNormal[0] = tr.sinTable[( lat + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK] * tr.sinTable[lng];
-				uncompressedOldNormal[1] = tr.sinTable[lat] * tr.sinTable[lng];
-				uncompressedOldNormal[2] = tr.sinTable[( lng + ( FUNCTABLE_SIZE / 4 ) ) & FUNCTABLE_MASK];
-			}
-
-			outNormal[0] = uncompressedOldNormal[0] * oldNormalScale + uncompressedNewNormal[0] * newNormalScale;
-			outNormal[1] = uncompressedOldNormal[1] * oldNormalScale + uncompressedNewNormal[1] * newNormalScale;
-			outNormal[2] = uncompressedOldNormal[2] * oldNormalScale + uncompressedNewNormal[2] * newNormalScale;
-
-			VectorNormalize( outNormal );
-		}
-	}
+	RB_LerpMeshFrames( oldFrame, newFrame, backlerp );
 }
 
 /*
@@ -1104,6 +1141,7 @@ void RB_SurfaceCMesh( mdcSurface_t *surface ) {
 	}
 
 	RB_CHECKOVERFLOW( surface->numVerts, surface->numTriangles * 3 );
+	RB_AddShadowSurface( surface, surface->numTriangles );
 
 	LerpCMeshVertexes( surface, backlerp );
 
@@ -170,7 +170,7 @@ static int R_DlightFace( srfSurfaceFace_t *face, int dlightBits ) {
 			continue;
 		}
 		dl = &tr.refdef.dlights[i];
-		d = DotProduct( dl->origin, face->plane.normal ) - face->plane.dist;
+		d = DotProduct( dl->transformed, face->plane.normal ) - face->plane.dist;
 		if ( d < -dl->radius || d > dl->radius ) {
 			// dlight doesn't reach the plane
 			dlightBits &= ~( 1 << i );
@@ -194,12 +194,12 @@ static int R_DlightGrid( srfGridMesh_t *grid, int dlightBits ) {
 			continue;
 		}
 		dl = &tr.refdef.dlights[i];
-		if ( dl->origin[0] - dl->radius > grid->meshBounds[1][0]
-			 || dl->origin[0] + dl->radius < grid->meshBounds[0][0]
-											 || dl->origin[1] - dl->radius > grid->meshBounds[1][1]
-			 || dl->origin[1] + dl->radius < grid->meshBounds[0][1]
-											 || dl->origin[2] - dl->radius > grid->meshBounds[1][2]
-			 || dl->origin[2] + dl->radius < grid->meshBounds[0][2] ) {
+		if ( dl->transformed[0] - dl->radius > grid->meshBounds[1][0]
+			 || dl->transformed[0] + dl->radius < grid->meshBounds[0][0]
+											 || dl->transformed[1] - dl->radius > grid->meshBounds[1][1]
+			 || dl->transformed[1] + dl->radius < grid->meshBounds[0][1]
+											 || dl->transformed[2] - dl->radius > grid->meshBounds[1][2]
+			 || dl->transformed[2] + dl->radius < grid->meshBounds[0][2] ) {
 			// dlight doesn't reach the bounds
 			dlightBits &= ~( 1 << i );
 		}
@@ -215,10 +215,6 @@ static int R_DlightGrid( srfGridMesh_t *grid, int dlightBits ) {
 
 
 static int R_DlightTrisurf( srfTriangles_t *surf, int dlightBits ) {
-	// FIXME: more dlight culling to trisurfs...
-	surf->dlightBits[ tr.smpFrame ] = dlightBits;
-	return dlightBits;
-#if 0
 	int i;
 	dlight_t    *dl;
 
@@ -227,12 +223,12 @@ static int R_DlightTrisurf( srfTriangles_t *surf, int dlightBits ) {
 			continue;
 		}
 		dl = &tr.refdef.dlights[i];
-		if ( dl->origin[0] - dl->radius > grid->meshBounds[1][0]
-			 || dl->origin[0] + dl->radius < grid->meshBounds[0][0]
-											 || dl->origin[1] - dl->radius > grid->meshBounds[1][1]
-			 || dl->origin[1] + dl->radius < grid->meshBounds[0][1]
-											 || dl->origin[2] - dl->radius > grid->meshBounds[1][2]
-			 || dl->origin[2] + dl->radius < grid->meshBounds[0][2] ) {
+		if ( dl->transformed[0] - dl->radius > surf->bounds[1][0]
+			 || dl->transformed[0] + dl->radius < surf->bounds[0][0]
+			 || dl->transformed[1] - dl->radius > surf->bounds[1][1]
+			 || dl->transformed[1] + dl->radius < surf->bounds[0][1]
+			 || dl->transformed[2] - dl->radius > surf->bounds[1][2]
+			 || dl->transformed[2] + dl->radius < surf->bounds[0][2] ) {
 			// dlight doesn't reach the bounds
 			dlightBits &= ~( 1 << i );
 		}
@@ -242,9 +238,8 @@ static int R_DlightTrisurf( srfTriangles_t *surf, int dlightBits ) {
 		tr.pc.c_dlightSurfacesCulled++;
 	}
 
-	grid->dlightBits[ tr.smpFrame ] = dlightBits;
+	surf->dlightBits[ tr.smpFrame ] = dlightBits;
 	return dlightBits;
-#endif
 }
 
 /*
@@ -463,6 +458,11 @@ static void R_RecursiveWorldNode( mnode_t *node, int planeBits, int dlightBits )
 				}
 			}
 
+			// skip anything hidden behind the big walls
+			if ( R_OcclusionCullBox( node->mins, node->maxs ) ) {
+				tr.pc.c_occludedNodes++;
+				return;
+			}
 		}
 
 		if ( node->contents != -1 ) {
@@ -511,7 +511,9 @@ static void R_RecursiveWorldNode( mnode_t *node, int planeBits, int dlightBits )
 		msurface_t  *surf, **mark;
 
 		// RF, hack, dlight elimination above is unreliable
-		dlightBits = 0xffffffff;
+		// (a surface spanning several leafs is only added from the first
+		// one reached), so every surface tests all dlights reaching the view
+		dlightBits = tr.viewParms.dlightBits;
 
 		tr.pc.c_leafs++;
 
@@ -679,6 +681,267 @@ static void R_MarkLeaves( void ) {
 }
 
 
+/*
+=============================================================================
+
+CLUSTER SURFACE LISTS
+
+For each view cluster, every surface in a potentially visible leaf is
+gathered once into a flat array sorted by shader.  Culling then walks
+that array instead of the tree.  Lists are built the first time a
+cluster is used and kept for the most recent clusters.
+
+=============================================================================
+*/
+
+#define MAX_CLUSTER_SURFACE_LISTS   8
+
+typedef struct {
+	msurface_t  *surf;
+	int area;                           // a surface in several areas gets an entry per area
+	vec3_t bounds[2];
+} clusterSurface_t;
+
+typedef struct {
+	int cluster;                        // -1 if unused
+	int lastUsed;
+	int numSurfaces;
+	clusterSurface_t    *surfaces;
+} clusterSurfaceList_t;
+
+static clusterSurfaceList_t clusterSurfaceLists[MAX_CLUSTER_SURFACE_LISTS];
+static int clusterSurfaceListTime;
+
+/*
+=================
+R_ClearClusterSurfaces
+=================
+*/
+void R_ClearClusterSurfaces( void ) {
+	int i;
+
+	for ( i = 0 ; i < MAX_CLUSTER_SURFACE_LISTS ; i++ ) {
+		if ( clusterSurfaceLists[i].surfaces ) {
+			free( clusterSurfaceLists[i].surfaces );
+		}
+		clusterSurfaceLists[i].surfaces = NULL;
+		clusterSurfaceLists[i].numSurfaces = 0;
+		clusterSurfaceLists[i].cluster = -1;
+		clusterSurfaceLists[i].lastUsed = 0;
+	}
+	clusterSurfaceListTime = 0;
+}
+
+/*
+=================
+R_ClusterSurfaceCompare
+
+Sort by shader so the surfaces reach R_AddDrawSurf in roughly the order they will be drawn
+=================
+*/
+static int R_ClusterSurfaceCompare( const void *a, const void *b ) {
+	const clusterSurface_t *ca = a, *cb = b;
+
+	if ( ca->surf->shader->sortedIndex != cb->surf->shader->sortedIndex ) {
+		return ca->surf->shader->sortedIndex - cb->surf->shader->sortedIndex;
+	}
+	if ( ca->surf != cb->surf ) {
+		return ca->surf < cb->surf ? -1 : 1;
+	}
+	return ca->area - cb->area;
+}
+
+/*
+=================
+R_SurfaceBounds
+
+Returns qfalse for surfaces that don't carry their own bounds
+=================
+*/
+static qboolean R_SurfaceBounds( msurface_t *surf, vec3_t bounds[2] ) {
+	srfSurfaceFace_t    *face;
+	srfGridMesh_t       *grid;
+	srfTriangles_t      *tri;
+	int i;
+
+	switch ( *surf->data ) {
+	case SF_FACE:
+		face = (srfSurfaceFace_t *)surf->data;
+		ClearBounds( bounds[0], bounds[1] );
+		for ( i = 0 ; i < face->numPoints ; i++ ) {
+			AddPointToBounds( face->points[i], bounds[0], bounds[1] );
+		}
+		return qtrue;
+	case SF_GRID:
+		grid = (srfGridMesh_t *)surf->data;
+		VectorCopy( grid->meshBounds[0], bounds[0] );
+		VectorCopy( grid->meshBounds[1], bounds[1] );
+		return qtrue;
+	case SF_TRIANGLES:
+		tri = (srfTriangles_t *)surf->data;
+		VectorCopy( tri->bounds[0], bounds[0] );
+		VectorCopy( tri->bounds[1], bounds[1] );
+		return qtrue;
+	default:
+		return qfalse;
+	}
+}
+
+/*
+=================
+R_BuildClusterSurfaceList
+=================
+*/
+static void R_BuildClusterSurfaceList( clusterSurfaceList_t *list, int cluster ) {
+	const byte          *vis;
+	mnode_t             *leaf;
+	msurface_t          **mark;
+	clusterSurface_t    *surfaces, *cs;
+	int                 *lastEntry;
+	vec3_t bounds[2];
+	int i, j, c, numMarks, numSurfaces, surfNum;
+
+	vis = R_ClusterPVS( cluster );
+
+	numMarks = 0;
+	for ( i = tr.world->numDecisionNodes, leaf = tr.world->nodes + i ; i < tr.world->numnodes ; i++, leaf++ ) {
+		c = leaf->cluster;
+		if ( c < 0 || c >= tr.world->numClusters || !( vis[c >> 3] & ( 1 << ( c & 7 ) ) ) ) {
+			continue;
+		}
+		numMarks += leaf->nummarksurfaces;
+	}
+
+	surfaces = ri.Hunk_AllocateTempMemory( numMarks * sizeof( *surfaces ) + 1 );
+	lastEntry = ri.Hunk_AllocateTempMemory( tr.world->numsurfaces * sizeof( *lastEntry ) );
+	for ( i = 0 ; i < tr.world->numsurfaces ; i++ ) {
+		lastEntry[i] = -1;
+	}
+
+	numSurfaces = 0;
+	for ( i = tr.world->numDecisionNodes, leaf = tr.world->nodes + i ; i < tr.world->numnodes ; i++, leaf++ ) {
+		c = leaf->cluster;
+		if ( c < 0 || c >= tr.world->numClusters || !( vis[c >> 3] & ( 1 << ( c & 7 ) ) ) ) {
+			continue;
+		}
+
+		for ( j = 0, mark = leaf->firstmarksurface ; j < leaf->nummarksurfaces ; j++, mark++ ) {
+			surfNum = *mark - tr.world->surfaces;
+
+			// the surface may span multiple leafs
+			if ( lastEntry[surfNum] >= 0 && surfaces[lastEntry[surfNum]].area == leaf->area ) {
+				cs = &surfaces[lastEntry[surfNum]];
+				if ( !R_SurfaceBounds( cs->surf, bounds ) ) {
+					AddPointToBounds( leaf->mins, cs->bounds[0], cs->bounds[1] );
+					AddPointToBounds( leaf->maxs, cs->bounds[0], cs->bounds[1] );
+				}
+				continue;
+			}
+
+			lastEntry[surfNum] = numSurfaces;
+			cs = &surfaces[numSurfaces++];
+			cs->surf = *mark;
+			cs->area = leaf->area;
+			if ( !R_SurfaceBounds( cs->surf, cs->bounds ) ) {
+				VectorCopy( leaf->mins, cs->bounds[0] );
+				VectorCopy( leaf->maxs, cs->bounds[1] );
+			}
+		}
+	}
+
+	qsort( surfaces, numSurfaces, sizeof( *surfaces ), R_ClusterSurfaceCompare );
+
+	list->cluster = cluster;
+	list->numSurfaces = numSurfaces;
+	list->surfaces = malloc( numSurfaces * sizeof( *surfaces ) + 1 );
+	if ( !list->surfaces ) {
+		ri.Error( ERR_DROP, "R_BuildClusterSurfaceList: couldn't allocate %i surfaces", numSurfaces );
+	}
+	memcpy( list->surfaces, surfaces, numSurfaces * sizeof( *surfaces ) );
+
+	ri.Hunk_FreeTempMemory( lastEntry );
+	ri.Hunk_FreeTempMemory( surfaces );
+
+	tr.pc.c_clusterListBuilds++;
+}
+
+/*
+=================
+R_ClusterSurfaceList
+=================
+*/
+static clusterSurfaceList_t *R_ClusterSurfaceList( int cluster ) {
+	int i;
+	clusterSurfaceList_t    *list, *oldest;
+
+	clusterSurfaceListTime++;
+
+	oldest = &clusterSurfaceLists[0];
+	for ( i = 0, list = clusterSurfaceLists ; i < MAX_CLUSTER_SURFACE_LISTS ; i++, list++ ) {
+		if ( list->cluster == cluster && list->surfaces ) {
+			list->lastUsed = clusterSurfaceListTime;
+			return list;
+		}
+		if ( list->lastUsed < oldest->lastUsed ) {
+			oldest = list;
+		}
+	}
+
+	if ( oldest->surfaces ) {
+		free( oldest->surfaces );
+		oldest->surfaces = NULL;
+	}
+	R_BuildClusterSurfaceList( oldest, cluster );
+	oldest->lastUsed = clusterSurfaceListTime;
+
+	return oldest;
+}
+
+/*
+=================
+R_AddClusterSurfaces
+
+Flat replacement for R_RecursiveWorldNode
+=================
+*/
+static void R_AddClusterSurfaces( void ) {
+	clusterSurfaceList_t    *list;
+	clusterSurface_t        *cs;
+	int i, j, area;
+
+	list = R_ClusterSurfaceList( tr.viewCluster );
+
+	for ( i = 0, cs = list->surfaces ; i < list->numSurfaces ; i++, cs++ ) {
+		if ( cs->surf->viewCount == tr.viewCount ) {
+			continue;
+		}
+
+		// check for door connection
+		area = cs->area;
+		if ( tr.refdef.areamask[area >> 3] & ( 1 << ( area & 7 ) ) ) {
+			continue;
+		}
+
+		tr.pc.c_clusterSurfaces++;
+
+		if ( !r_nocull->integer ) {
+			for ( j = 0 ; j < 4 ; j++ ) {
+				if ( BoxOnPlaneSide( cs->bounds[0], cs->bounds[1], &tr.viewParms.frustum[j] ) == 2 ) {
+					break;
+				}
+			}
+			if ( j != 4 ) {
+				continue;
+			}
+		}
+
+		AddPointToBounds( cs->bounds[0], tr.viewParms.visBounds[0], tr.viewParms.visBounds[1] );
+		AddPointToBounds( cs->bounds[1], tr.viewParms.visBounds[0], tr.viewParms.visBounds[1] );
+
+		R_AddWorldSurface( cs->surf, tr.viewParms.dlightBits );
+	}
+}
+
 /*
 =============
 R_AddWorldSurfaces
@@ -702,9 +965,15 @@ void R_AddWorldSurfaces( void ) {
 	// clear out the visible min/max
 	ClearBounds( tr.viewParms.visBounds[0], tr.viewParms.visBounds[1] );
 
+	// surface dlight tests use the transformed origins, which brush models
+	// leave in their own entity space
+	R_TransformDlights( tr.refdef.num_dlights, tr.refdef.dlights, &tr.viewParms.world );
+
 	// perform frustum culling and add all the potentially visible surfaces
-	if ( tr.refdef.num_dlights > 32 ) {
-		tr.refdef.num_dlights = 32 ;
+	if ( r_clusterSurfaces->integer && !r_novis->integer && tr.world->vis
+		 && tr.viewCluster >= 0 && tr.viewCluster < tr.world->numClusters ) {
+		R_AddClusterSurfaces();
+	} else {
+		R_RecursiveWorldNode( tr.world->nodes, 15, tr.viewParms.dlightBits );
 	}
-	R_RecursiveWorldNode( tr.world->nodes, 15, ( 1 << tr.refdef.num_dlights ) - 1 );
 }
@@ -1019,6 +1019,7 @@ void            trap_R_AddCoronaToScene( const vec3_t org, float r, float g, flo
 void            trap_R_RenderScene( const refdef_t *fd );
 void            trap_R_SetColor( const float *rgba );
 void            trap_R_DrawStretchPic( float x, float y, float w, float h, float s1, float t1, float s2, float t2, qhandle_t hShader );
+void            trap_R_DrawText( float x, float y, float xscale, float yscale, float adjust, float shadowX, float shadowY, const float *rgba, const char *text, int limit, const fontInfo_t *font );
 void            trap_R_ModelBounds( clipHandle_t model, vec3_t mins, vec3_t maxs );
 void            trap_UpdateScreen( void );
 int             trap_CM_LerpTag( orientation_t *tag, const refEntity_t *refent, const char *tagName, int startIndex );
@@ -409,9 +409,6 @@ void Text_PaintChar( float x, float y, float width, float height, int font, floa
 }
 
 void Text_Paint( float x, float y, int font, float scale, vec4_t color, const char *text, float adjust, int limit, int style ) {
-	int len, count;
-	vec4_t newColor;
-	glyphInfo_t *glyph;
 	float useScale;
 
 	fontInfo_t *fnt = &uiInfo.uiDC.Assets.textFont;
@@ -431,60 +428,16 @@ void Text_Paint( float x, float y, int font, float scale, vec4_t color, const ch
 
 	useScale = scale * fnt->glyphScale;
 	if ( text ) {
-		const unsigned char *s = text;
-		trap_R_SetColor( color );
-		memcpy( &newColor[0], &color[0], sizeof( vec4_t ) );
-		len = strlen( text );
-		if ( limit > 0 && len > limit ) {
-			len = limit;
-		}
-		count = 0;
-		while ( s && *s && count < len ) {
-			glyph = &fnt->glyphs[*s];
-			//int yadj = Assets.textFont.glyphs[text[i]].bottom + Assets.textFont.glyphs[text[i]].top;
-			//float yadj = scale * (Assets.textFont.glyphs[text[i]].imageHeight - Assets.textFont.glyphs[text[i]].height);
-			if ( Q_IsColorString( s ) ) {
-				memcpy( newColor, g_color_table[ColorIndex( *( s + 1 ) )], sizeof( newColor ) );
-				newColor[3] = color[3];
-				trap_R_SetColor( newColor );
-				s += 2;
-				continue;
-			} else {
-				float yadj = useScale * glyph->top;
-				if ( style == ITEM_TEXTSTYLE_SHADOWED || style == ITEM_TEXTSTYLE_SHADOWEDMORE ) {
-					int ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
-					colorBlack[3] = newColor[3];
-					trap_R_SetColor( colorBlack );
-					Text_PaintChar( x + ofs, y - yadj + ofs,
-									glyph->imageWidth,
-									glyph->imageHeight,
-									font,
-									useScale,
-									glyph->s,
-									glyph->t,
-									glyph->s2,
-									glyph->t2,
-									glyph->glyph );
-					trap_R_SetColor( newColor );
-					colorBlack[3] = 1.0;
-				}
-				Text_PaintChar( x, y - yadj,
-								glyph->imageWidth,
-								glyph->imageHeight,
-								font,
-								useScale,
-								glyph->s,
-								glyph->t,
-								glyph->s2,
-								glyph->t2,
-								glyph->glyph );
+		float xscale = 1, yscale = 1, ofs = 0;
 
-				x += ( glyph->xSkip * useScale ) + adjust;
-				s++;
-				count++;
-			}
+		// the whole string goes to the renderer at once, glyph units are mapped
+		// to screen pixels the same way UI_AdjustFrom640 maps the virtual screen
+		UI_AdjustFrom640( &x, &y, &xscale, &yscale );
+		if ( style == ITEM_TEXTSTYLE_SHADOWED || style == ITEM_TEXTSTYLE_SHADOWEDMORE ) {
+			ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
 		}
-		trap_R_SetColor( NULL );
+		trap_R_DrawText( x, y, useScale * xscale, useScale * yscale, adjust * xscale,
+						 ofs * xscale, ofs * yscale, color, text, limit, fnt );
 	}
 }
 
@@ -144,6 +144,7 @@ typedef enum {
 	UI_LAN_COMPARESERVERS,
 	UI_CL_GETLIMBOSTRING,           // NERVE - SMF
 	UI_CIN_SHOWSOFTKEYBOARD,
+	UI_R_DRAWTEXT,
 
 	UI_MEMSET = 100,
 	UI_MEMCPY,
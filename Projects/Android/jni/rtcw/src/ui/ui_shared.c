@@ -90,6 +90,30 @@ static qboolean Menu_OverActiveItem( menuDef_t *menu, float x, float y );
 static char memoryPool[MEM_POOL_SIZE];
 static int allocPoint, outOfMemory;
 
+// lines of recently painted autowrapped items, see Item_Text_AutoWrapped_Layout
+#define WRAPPED_TEXT_CACHE  16
+#define MAX_WRAPPED_LINES   64
+
+typedef struct {
+	const itemDef_t *item;
+	int textLen;
+	char source[1024];                      // the text the lines were built from
+	float rectWidth;
+	float textscale;
+	int font;
+	int textalignment;
+	int time;                               // last painted, for replacement
+	qboolean overflow;                      // too many lines, painted without the cache
+	int numLines;
+	short lineText[MAX_WRAPPED_LINES];      // offset into text
+	short lineRow[MAX_WRAPPED_LINES];       // empty lines still take a row
+	float lineX[MAX_WRAPPED_LINES];         // relative to textalignx
+	int textUsed;
+	char text[2048];                        // the lines, nul separated
+} wrappedText_t;
+
+static wrappedText_t wrappedText[WRAPPED_TEXT_CACHE];
+
 
 // these are expected to be translated by the strings.txt file
 translateString_t translateStrings[] = {
@@ -321,6 +345,7 @@ void String_Init() {
 	menuCount = 0;
 	openMenuCount = 0;
 	UI_InitMemory();
+	memset( wrappedText, 0, sizeof( wrappedText ) );
 	Item_SetupKeywordHash();
 	Menu_SetupKeywordHash();
 	if ( DC && DC->getBindingBuf ) {
@@ -3157,34 +3182,43 @@ void Item_TextColor( itemDef_t *item, vec4_t *newColor ) {
 	}
 }
 
-void Item_Text_AutoWrapped_Paint( itemDef_t *item ) {
-	char text[1024];
-	const char *p, *textPtr, *newLinePtr;
+/*
+==================
+Auto wrapped text layout cache
+
+Breaking a paragraph into lines measures the text once per character,
+so the lines of the recently painted autowrapped items are kept and only
+rebuilt when the text, width, font or alignment of the item changes.
+Lines are stored relative to the item alignment point so moving the
+window does not invalidate them.  A paragraph with more lines or text
+than an entry holds is remembered as such and painted straight from the
+line breaker, as is one too long to keep a copy of.
+==================
+*/
+typedef qboolean ( *wrappedLineFunc_t )( itemDef_t *item, const char *line, int row, float x, void *data );
+
+typedef struct {
+	float *color;
+	int height;
+} wrappedPaint_t;
+
+/*
+==================
+Item_Text_AutoWrapped_Lines
+
+Breaks the text into lines that fit the item width and hands each one to
+emit, stopping early if emit returns qfalse.  x is relative to textalignx.
+==================
+*/
+static qboolean Item_Text_AutoWrapped_Lines( itemDef_t *item, const char *textPtr, wrappedLineFunc_t emit, void *data ) {
+	const char *p, *newLinePtr;
 	char buff[1024];
-	int width, height, len, textWidth, newLine, newLineWidth;
-	float y;
-	vec4_t color;
+	int len, row, textWidth, newLine, newLineWidth;
+	float x;
 
 	textWidth = 0;
 	newLinePtr = NULL;
-
-	if ( item->text == NULL ) {
-		if ( item->cvar == NULL ) {
-			return;
-		} else {
-			DC->getCVarString( item->cvar, text, sizeof( text ) );
-			textPtr = text;
-		}
-	} else {
-		textPtr = item->text;
-	}
-	if ( *textPtr == '\0' ) {
-		return;
-	}
-	Item_TextColor( item, &color );
-	Item_SetTextExtents( item, &width, &height, textPtr );
-
-	y = item->textaligny;
+	row = 0;
 	len = 0;
 	buff[0] = '\0';
 	newLine = 0;
@@ -3199,24 +3233,22 @@ void Item_Text_AutoWrapped_Paint( itemDef_t *item ) {
 		textWidth = DC->textWidth( buff, item->font, item->textscale, 0 );
 		if ( ( newLine && textWidth > item->window.rect.w ) || *p == '\n' || *p == '\0' ) {
 			if ( len ) {
-				if ( item->textalignment == ITEM_ALIGN_LEFT ) {
-					item->textRect.x = item->textalignx;
-				} else if ( item->textalignment == ITEM_ALIGN_RIGHT ) {
-					item->textRect.x = item->textalignx - newLineWidth;
+				x = 0;
+				if ( item->textalignment == ITEM_ALIGN_RIGHT ) {
+					x = -newLineWidth;
 				} else if ( item->textalignment == ITEM_ALIGN_CENTER ) {
-					item->textRect.x = item->textalignx - newLineWidth / 2;
+					x = -( newLineWidth / 2 );
 				}
-				item->textRect.y = y;
-				ToWindowCoords( &item->textRect.x, &item->textRect.y, &item->window );
-				//
 				buff[newLine] = '\0';
-				DC->drawText( item->textRect.x, item->textRect.y, item->font, item->textscale, color, buff, 0, 0, item->textStyle );
+				if ( !emit( item, buff, row, x, data ) ) {
+					return qfalse;
+				}
 			}
 			if ( *p == '\0' ) {
 				break;
 			}
 			//
-			y += height + 5;
+			row++;
 			p = newLinePtr;
 			len = 0;
 			newLine = 0;
@@ -3231,6 +3263,125 @@ void Item_Text_AutoWrapped_Paint( itemDef_t *item ) {
 
 		buff[len] = '\0';
 	}
+
+	return qtrue;
+}
+
+static qboolean Item_Text_AutoWrapped_StoreLine( itemDef_t *item, const char *line, int row, float x, void *data ) {
+	wrappedText_t *wrap = data;
+	int len;
+
+	len = strlen( line ) + 1;
+	if ( wrap->numLines == MAX_WRAPPED_LINES || wrap->textUsed + len > sizeof( wrap->text ) ) {
+		return qfalse;
+	}
+	wrap->lineText[wrap->numLines] = wrap->textUsed;
+	wrap->lineRow[wrap->numLines] = row;
+	wrap->lineX[wrap->numLines] = x;
+	memcpy( wrap->text + wrap->textUsed, line, len );
+	wrap->textUsed += len;
+	wrap->numLines++;
+	return qtrue;
+}
+
+static qboolean Item_Text_AutoWrapped_DrawLine( itemDef_t *item, const char *line, int row, float x, void *data ) {
+	wrappedPaint_t *paint = data;
+
+	item->textRect.x = item->textalignx + x;
+	item->textRect.y = item->textaligny + row * ( paint->height + 5 );
+	ToWindowCoords( &item->textRect.x, &item->textRect.y, &item->window );
+	DC->drawText( item->textRect.x, item->textRect.y, item->font, item->textscale, paint->color, line, 0, 0, item->textStyle );
+	return qtrue;
+}
+
+/*
+==================
+Item_Text_AutoWrapped_Layout
+
+Returns the cached lines for the item, or NULL if they have to be painted
+straight from Item_Text_AutoWrapped_Lines
+==================
+*/
+static wrappedText_t *Item_Text_AutoWrapped_Layout( itemDef_t *item, const char *textPtr ) {
+	int i, textLen;
+	wrappedText_t *wrap, *oldest;
+
+	textLen = strlen( textPtr );
+	if ( textLen >= sizeof( wrap->source ) ) {
+		return NULL;
+	}
+
+	oldest = wrappedText;
+	for ( i = 0, wrap = wrappedText; i < WRAPPED_TEXT_CACHE; i++, wrap++ ) {
+		if ( wrap->item == item && wrap->textLen == textLen
+			 && wrap->rectWidth == item->window.rect.w && wrap->textscale == item->textscale
+			 && wrap->font == item->font && wrap->textalignment == item->textalignment
+			 && !strcmp( wrap->source, textPtr ) ) {
+			wrap->time = DC->realTime;
+			return wrap->overflow ? NULL : wrap;
+		}
+		if ( wrap->time < oldest->time ) {
+			oldest = wrap;
+		}
+	}
+
+	wrap = oldest;
+	wrap->item = item;
+	wrap->textLen = textLen;
+	memcpy( wrap->source, textPtr, textLen + 1 );
+	wrap->rectWidth = item->window.rect.w;
+	wrap->textscale = item->textscale;
+	wrap->font = item->font;
+	wrap->textalignment = item->textalignment;
+	wrap->time = DC->realTime;
+	wrap->overflow = qfalse;
+	wrap->numLines = 0;
+	wrap->textUsed = 0;
+
+	if ( !Item_Text_AutoWrapped_Lines( item, textPtr, Item_Text_AutoWrapped_StoreLine, wrap ) ) {
+		wrap->overflow = qtrue;
+		wrap->numLines = 0;
+		return NULL;
+	}
+
+	return wrap;
+}
+
+void Item_Text_AutoWrapped_Paint( itemDef_t *item ) {
+	char text[1024];
+	const char *textPtr;
+	int i, width, height;
+	wrappedText_t *wrap;
+	wrappedPaint_t paint;
+	vec4_t color;
+
+	if ( item->text == NULL ) {
+		if ( item->cvar == NULL ) {
+			return;
+		} else {
+			DC->getCVarString( item->cvar, text, sizeof( text ) );
+			textPtr = text;
+		}
+	} else {
+		textPtr = item->text;
+	}
+	if ( *textPtr == '\0' ) {
+		return;
+	}
+	Item_TextColor( item, &color );
+	Item_SetTextExtents( item, &width, &height, textPtr );
+
+	paint.color = color;
+	paint.height = height;
+
+	wrap = Item_Text_AutoWrapped_Layout( item, textPtr );
+	if ( !wrap ) {
+		Item_Text_AutoWrapped_Lines( item, textPtr, Item_Text_AutoWrapped_DrawLine, &paint );
+		return;
+	}
+	for ( i = 0; i < wrap->numLines; i++ ) {
+		Item_Text_AutoWrapped_DrawLine( item, wrap->text + wrap->lineText[i], wrap->lineRow[i], wrap->lineX[i], &paint );
+	}
 }
 
 void Item_Text_Wrapped_Paint( itemDef_t *item ) {